@@ -0,0 +1,182 @@
+#include "BenchmarkRunner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#if JUCE_LINUX || JUCE_BSD || JUCE_MAC
+#include <sys/resource.h>
+#endif
+
+namespace Benchmarks {
+
+BenchmarkRunner::BenchmarkRunner(juce::String nameFilter)
+    : filter(std::move(nameFilter)) {}
+
+bool BenchmarkRunner::shouldRun(const juce::String &name) const {
+    return filter.isEmpty() || name.contains(filter);
+}
+
+void BenchmarkRunner::run(const juce::String &name, int iterations,
+                          const std::function<void()> &body,
+                          double itemsPerIteration,
+                          const juce::String &itemUnit, int warmupIterations) {
+    if (!shouldRun(name) || iterations <= 0)
+        return;
+
+    memoryBaselineBytes = startMemoryBaseline();
+
+    for (int i = 0; i < warmupIterations; i++)
+        body();
+
+    std::vector<double> timesMs;
+    timesMs.reserve(size_t(iterations));
+    for (int i = 0; i < iterations; i++) {
+        auto start = juce::Time::getHighResolutionTicks();
+        body();
+        auto end = juce::Time::getHighResolutionTicks();
+        timesMs.push_back(
+            juce::Time::highResolutionTicksToSeconds(end - start) * 1000.0);
+    }
+
+    record(name, std::move(timesMs), itemsPerIteration, itemUnit);
+}
+
+void BenchmarkRunner::addResult(const juce::String &name,
+                                std::vector<double> timesMs) {
+    // the work was done before this was called, so there is no baseline
+    // to measure the memory it used from
+    memoryBaselineBytes = -1;
+    if (shouldRun(name) && !timesMs.empty())
+        record(name, std::move(timesMs), 0.0, {});
+}
+
+void BenchmarkRunner::record(const juce::String &name,
+                             std::vector<double> timesMs,
+                             double itemsPerIteration,
+                             const juce::String &itemUnit) {
+    std::sort(timesMs.begin(), timesMs.end());
+
+    Result result;
+    result.name = name;
+    result.iterations = int(timesMs.size());
+    result.minMs = timesMs.front();
+    result.maxMs = timesMs.back();
+    result.medianMs = timesMs[timesMs.size() / 2];
+    result.p95Ms = timesMs[std::min(timesMs.size() - 1,
+                                    size_t(double(timesMs.size()) * .95))];
+
+    double totalMs = 0.0;
+    for (auto time : timesMs)
+        totalMs += time;
+    result.meanMs = totalMs / double(timesMs.size());
+
+    result.itemsPerIteration = itemsPerIteration;
+    result.itemUnit = itemUnit;
+    result.processPeakMemoryBytes = getProcessPeakMemoryBytes();
+    if (memoryBaselineBytes >= 0) {
+        auto peak = readProcStatusBytes("VmHWM:");
+        if (peak >= 0)
+            result.peakMemoryGrowthBytes =
+                juce::jmax(juce::int64(0), peak - memoryBaselineBytes);
+    }
+
+    // progress goes to stderr so the JSON on stdout stays clean
+    std::fprintf(stderr, "%-48s median %10.4f ms  p95 %10.4f ms\n",
+                 name.toRawUTF8(), result.medianMs, result.p95Ms);
+
+    results.push_back(result);
+}
+
+const std::vector<BenchmarkRunner::Result> &
+BenchmarkRunner::getResults() const {
+    return results;
+}
+
+juce::int64 BenchmarkRunner::getProcessPeakMemoryBytes() {
+#if JUCE_LINUX || JUCE_BSD || JUCE_MAC
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#if JUCE_MAC
+    return juce::int64(usage.ru_maxrss);
+#else
+    // reported in kilobytes everywhere but on macOS
+    return juce::int64(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+juce::int64 BenchmarkRunner::startMemoryBaseline() {
+#if JUCE_LINUX
+    // writing 5 resets the peak resident size to the current one
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (!(clearRefs << "5" << std::flush))
+        return -1;
+
+    return readProcStatusBytes("VmRSS:");
+#else
+    return -1;
+#endif
+}
+
+juce::int64 BenchmarkRunner::readProcStatusBytes(const char *field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.rfind(field, 0) == 0)
+            // the sizes are given in kilobytes
+            return juce::String(line.substr(std::strlen(field)))
+                       .trim()
+                       .getLargeIntValue() *
+                   1024;
+
+    return -1;
+}
+
+juce::var BenchmarkRunner::toJson() const {
+    juce::Array<juce::var> benchmarks;
+    for (const auto &result : results) {
+        auto *object = new juce::DynamicObject();
+        object->setProperty("name", result.name);
+        object->setProperty("iterations", result.iterations);
+        object->setProperty("min_ms", result.minMs);
+        object->setProperty("median_ms", result.medianMs);
+        object->setProperty("mean_ms", result.meanMs);
+        object->setProperty("p95_ms", result.p95Ms);
+        object->setProperty("max_ms", result.maxMs);
+        object->setProperty("process_peak_memory_bytes",
+                            result.processPeakMemoryBytes);
+        if (result.peakMemoryGrowthBytes >= 0)
+            object->setProperty("peak_memory_growth_bytes",
+                                result.peakMemoryGrowthBytes);
+
+        if (result.itemsPerIteration > 0.0 && result.medianMs > 0.0) {
+            object->setProperty("items_per_iteration",
+                                result.itemsPerIteration);
+            object->setProperty("item_unit", result.itemUnit);
+            object->setProperty("items_per_second",
+                                result.itemsPerIteration /
+                                    (result.medianMs / 1000.0));
+        }
+
+        benchmarks.add(juce::var(object));
+    }
+
+    auto *root = new juce::DynamicObject();
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("num_cpus", juce::SystemStats::getNumCpus());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("juce_version", juce::SystemStats::getJUCEVersion());
+    root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("process_peak_memory_bytes",
+                      getProcessPeakMemoryBytes());
+    root->setProperty("benchmarks", benchmarks);
+    return juce::var(root);
+}
+
+} // namespace Benchmarks
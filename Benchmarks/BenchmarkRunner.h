@@ -0,0 +1,75 @@
+#pragma once
+#include <functional>
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace Benchmarks {
+
+// Times benchmark bodies and collects the results so they can be written out
+// as JSON and compared between builds.
+//
+// Each body is run a few times untimed first so caches, lazily created
+// engine objects and the allocator have settled, then every timed iteration
+// is measured on its own so the spread between runs is reported as well.
+class BenchmarkRunner {
+  public:
+    // Only benchmarks whose name contains the filter are run, an empty
+    // filter runs everything
+    explicit BenchmarkRunner(juce::String nameFilter = {});
+
+    struct Result {
+        juce::String name;
+        int iterations = 0;
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double meanMs = 0.0;
+        double p95Ms = 0.0;
+        double maxMs = 0.0;
+        // how many units of work one iteration does, used for throughput
+        double itemsPerIteration = 0.0;
+        juce::String itemUnit;
+        // peak resident memory of the whole process once the benchmark has
+        // run, which includes everything that ran before it
+        juce::int64 processPeakMemoryBytes = 0;
+        // how far resident memory rose above where it was when the benchmark
+        // started, -1 where the platform cannot measure it per benchmark
+        juce::int64 peakMemoryGrowthBytes = -1;
+    };
+
+    bool shouldRun(const juce::String &name) const;
+
+    // Runs body warmupIterations times untimed and then iterations times
+    // timed. Passing itemsPerIteration reports throughput in itemUnit per
+    // second next to the timings.
+    void run(const juce::String &name, int iterations,
+             const std::function<void()> &body, double itemsPerIteration = 0.0,
+             const juce::String &itemUnit = {}, int warmupIterations = 2);
+
+    // Records timings measured elsewhere, for benchmarks that time something
+    // other than how long a body takes to run
+    void addResult(const juce::String &name, std::vector<double> timesMs);
+
+    const std::vector<Result> &getResults() const;
+
+    // The most memory the process has had resident so far, 0 where the
+    // platform does not report it
+    static juce::int64 getProcessPeakMemoryBytes();
+
+    juce::var toJson() const;
+
+  private:
+    juce::String filter;
+    std::vector<Result> results;
+    // resident memory when the running benchmark started, -1 if unknown
+    juce::int64 memoryBaselineBytes = -1;
+
+    void record(const juce::String &name, std::vector<double> timesMs,
+                double itemsPerIteration, const juce::String &itemUnit);
+
+    // Resets the peak so it only covers what runs from here on, only Linux
+    // allows that. Returns the resident memory to measure growth from, or -1.
+    static juce::int64 startMemoryBaseline();
+    static juce::int64 readProcStatusBytes(const char *field);
+};
+
+} // namespace Benchmarks
@@ -0,0 +1,32 @@
+#include "../BenchmarkRunner.h"
+#include "../SyntheticEdit.h"
+
+namespace Benchmarks {
+
+void runEditFileBenchmarks(BenchmarkRunner &runner,
+                           tracktion::Engine &engine) {
+    juce::TemporaryFile editFile(".tracktionedit");
+
+    for (auto numTracks : {8, 32}) {
+        SyntheticEditSpec spec;
+        spec.numTracks = numTracks;
+        spec.clipsPerTrack = 8;
+        spec.notesPerClip = 8;
+        spec.withSynths = true;
+        auto edit = createSyntheticEdit(engine, spec);
+        auto suffix = "/" + juce::String(numTracks) + "Tracks";
+
+        // the same write the app does when it saves
+        runner.run("EditFile/save" + suffix, 20, [&] {
+            tracktion::EditFileOperations(*edit).writeToFile(editFile.getFile(),
+                                                             false);
+        });
+
+        runner.run("EditFile/load" + suffix, 20, [&] {
+            auto loaded = tracktion::loadEditFromFile(engine,
+                                                      editFile.getFile());
+        });
+    }
+}
+
+} // namespace Benchmarks
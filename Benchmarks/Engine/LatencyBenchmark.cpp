@@ -0,0 +1,51 @@
+#include "../BenchmarkRunner.h"
+#include "../SyntheticEdit.h"
+#include <app_services/app_services.h>
+
+namespace Benchmarks {
+
+// Measures the MIDI to audio latency of a 4OSC track at every buffer size the
+// default sound card offers, at its sample rate. Without a sound card the
+// range the settings view usually offers is measured at 48kHz instead. The
+// probe needs an engine that is driven by its hosted audio device, so it gets
+// one of its own.
+void runLatencyBenchmarks(BenchmarkRunner &runner) {
+    if (!runner.shouldRun("Latency/"))
+        return;
+
+    tracktion::Engine engine{
+        "LATENCY", nullptr,
+        std::make_unique<app_services::LatencyProbe::HostedEngineBehaviour>()};
+
+    SyntheticEditSpec spec;
+    spec.numTracks = 1;
+    spec.clipsPerTrack = 0;
+    spec.withSynths = true;
+    auto edit = createSyntheticEdit(engine, spec);
+
+    app_services::LatencyProbe probe(engine);
+    probe.setInstrument(*tracktion::getAudioTracks(*edit)[0]);
+
+    double sampleRate = 48000.0;
+    juce::Array<int> blockSizes{32, 64, 128, 256, 512, 1024};
+    {
+        // only asked for what it offers, the probe never plays through it
+        juce::AudioDeviceManager deviceManager;
+        if (deviceManager.initialiseWithDefaultDevices(0, 2).isEmpty())
+            if (auto device = deviceManager.getCurrentAudioDevice()) {
+                sampleRate = device->getCurrentSampleRate();
+                blockSizes = device->getAvailableBufferSizes();
+                std::fprintf(stderr, "Measuring the buffer sizes of %s\n",
+                             device->getName().toRawUTF8());
+            }
+    }
+
+    for (auto blockSize : blockSizes) {
+        auto result = probe.measure(sampleRate, blockSize, 100);
+        std::fprintf(stderr, "%s\n", result.toString().toRawUTF8());
+        runner.addResult("Latency/4OSC/" + juce::String(blockSize) + "Samples",
+                         result.latenciesMs);
+    }
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,39 @@
+#include "../BenchmarkRunner.h"
+#include "../SyntheticEdit.h"
+
+namespace Benchmarks {
+
+void runRenderBenchmarks(BenchmarkRunner &runner, tracktion::Engine &engine) {
+    juce::TemporaryFile renderFile(".wav");
+
+    for (auto numTracks : {1, 8}) {
+        // 8 one bar clips, so 32 beats of audio per track
+        SyntheticEditSpec spec;
+        spec.numTracks = numTracks;
+        spec.clipsPerTrack = 8;
+        spec.notesPerClip = 8;
+        spec.withSynths = true;
+        auto edit = createSyntheticEdit(engine, spec);
+
+        auto length = edit->tempoSequence.toTime(
+            tracktion::BeatPosition::fromBeats(32.0));
+        tracktion::TimeRange timeRange(tracktion::TimePosition(), length);
+
+        juce::BigInteger tracksToDo;
+        for (int i = 0; i < numTracks; i++)
+            tracksToDo.setBit(i);
+
+        // rendered on this thread so the timing covers the whole render,
+        // throughput is seconds of audio rendered per second
+        runner.run(
+            "Render/" + juce::String(numTracks) + "Tracks", 5,
+            [&] {
+                tracktion::Renderer::renderToFile(
+                    "Render", renderFile.getFile(), *edit, timeRange,
+                    tracksToDo, true, {}, false);
+            },
+            length.inSeconds(), "audio seconds", 1);
+    }
+}
+
+} // namespace Benchmarks
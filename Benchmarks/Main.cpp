@@ -0,0 +1,61 @@
+#include "BenchmarkRunner.h"
+#include <app_view_models/app_view_models.h>
+#include <cstdio>
+#include <juce_events/juce_events.h>
+
+namespace Benchmarks {
+
+void runTimelineCameraBenchmarks(BenchmarkRunner &runner);
+void runListAdapterBenchmarks(BenchmarkRunner &runner,
+                              tracktion::Engine &engine);
+void runStepSequencerBenchmarks(BenchmarkRunner &runner,
+                                tracktion::Engine &engine);
+void runDrumKitBenchmarks(BenchmarkRunner &runner, tracktion::Engine &engine);
+void runEditFileBenchmarks(BenchmarkRunner &runner, tracktion::Engine &engine);
+void runRenderBenchmarks(BenchmarkRunner &runner, tracktion::Engine &engine);
+void runLatencyBenchmarks(BenchmarkRunner &runner);
+void runViewModelStressBenchmarks(BenchmarkRunner &runner,
+                                  tracktion::Engine &engine);
+
+} // namespace Benchmarks
+
+// Usage: Benchmarks [--filter <text>] [--output <file.json>]
+// Without --output the JSON results are written to stdout.
+int main(int argc, char **argv) {
+    juce::ScopedJuceInitialiser_GUI init;
+
+    juce::String filter;
+    juce::File outputFile;
+    for (int i = 1; i + 1 < argc; i++) {
+        juce::String arg(argv[i]);
+        if (arg == "--filter")
+            filter = argv[++i];
+        else if (arg == "--output")
+            outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(
+                argv[++i]);
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    engine.getPluginManager()
+        .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+    engine.getPluginManager()
+        .createBuiltInType<internal_plugins::StepSequencerPlugin>();
+
+    Benchmarks::BenchmarkRunner runner(filter);
+    Benchmarks::runTimelineCameraBenchmarks(runner);
+    Benchmarks::runListAdapterBenchmarks(runner, engine);
+    Benchmarks::runStepSequencerBenchmarks(runner, engine);
+    Benchmarks::runDrumKitBenchmarks(runner, engine);
+    Benchmarks::runEditFileBenchmarks(runner, engine);
+    Benchmarks::runRenderBenchmarks(runner, engine);
+    Benchmarks::runLatencyBenchmarks(runner);
+    Benchmarks::runViewModelStressBenchmarks(runner, engine);
+
+    auto json = juce::JSON::toString(runner.toJson());
+    if (outputFile == juce::File()) {
+        std::printf("%s\n", json.toRawUTF8());
+        return 0;
+    }
+
+    return outputFile.replaceWithText(json) ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+#include "SyntheticEdit.h"
+
+namespace Benchmarks {
+
+int SyntheticEditSpec::getTotalClips() const {
+    return numTracks * clipsPerTrack;
+}
+
+int SyntheticEditSpec::getTotalNotes() const {
+    return getTotalClips() * notesPerClip;
+}
+
+juce::String SyntheticEditSpec::getName() const {
+    return juce::String(numTracks) + "tracks_" +
+           juce::String(getTotalClips()) + "clips_" +
+           juce::String(getTotalNotes()) + "notes";
+}
+
+std::unique_ptr<tracktion::Edit>
+createSyntheticEdit(tracktion::Engine &engine, const SyntheticEditSpec &spec) {
+    constexpr double beatsPerClip = 4.0;
+    const juce::Array<juce::String> effectTypes = {
+        tracktion::ReverbPlugin::xmlTypeName,
+        tracktion::DelayPlugin::xmlTypeName,
+        tracktion::ChorusPlugin::xmlTypeName,
+        tracktion::PhaserPlugin::xmlTypeName};
+
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+    edit->ensureNumberOfAudioTracks(spec.numTracks);
+
+    // a fixed seed keeps every run on the same edit
+    juce::Random random(1234);
+
+    for (auto track : tracktion::getAudioTracks(*edit)) {
+        for (int clipIndex = 0; clipIndex < spec.clipsPerTrack; clipIndex++) {
+            auto start = edit->tempoSequence.toTime(
+                tracktion::BeatPosition::fromBeats(clipIndex * beatsPerClip));
+            auto end = edit->tempoSequence.toTime(
+                tracktion::BeatPosition::fromBeats((clipIndex + 1) *
+                                                   beatsPerClip));
+            auto clip = dynamic_cast<tracktion::MidiClip *>(
+                track->insertNewClip(tracktion::TrackItem::Type::midi,
+                                     "clip " + juce::String(clipIndex + 1),
+                                     tracktion::TimeRange(start, end),
+                                     nullptr));
+            if (clip == nullptr)
+                continue;
+
+            auto &sequence = clip->getSequence();
+            for (int i = 0; i < spec.notesPerClip; i++)
+                sequence.addNote(
+                    36 + random.nextInt(48),
+                    tracktion::BeatPosition::fromBeats(beatsPerClip * i /
+                                                       spec.notesPerClip),
+                    tracktion::BeatDuration::fromBeats(.25),
+                    40 + random.nextInt(87), 0, nullptr);
+        }
+
+        for (int i = 0; i < spec.effectsPerTrack; i++)
+            track->pluginList.insertPlugin(
+                edit->getPluginCache().createNewPlugin(
+                    effectTypes[i % effectTypes.size()], {}),
+                i, nullptr);
+
+        if (spec.withSynths)
+            track->pluginList.insertPlugin(
+                edit->getPluginCache().createNewPlugin(
+                    tracktion::FourOscPlugin::xmlTypeName, {}),
+                0, nullptr);
+    }
+
+    return edit;
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,28 @@
+#pragma once
+#include <tracktion_engine/tracktion_engine.h>
+
+namespace Benchmarks {
+
+// Describes the shape of a generated edit. Clips are one bar long and laid
+// end to end on each track, notes are spread evenly over each clip.
+struct SyntheticEditSpec {
+    int numTracks = 8;
+    int clipsPerTrack = 1;
+    int notesPerClip = 16;
+    // effects inserted on every track before its volume and meter plugins
+    int effectsPerTrack = 0;
+    // puts a 4OSC on every track so rendering the edit produces audio
+    bool withSynths = false;
+
+    int getTotalClips() const;
+    int getTotalNotes() const;
+
+    // short name used to tell benchmarks on different sizes apart, for
+    // example 64tracks_2048clips_100352notes
+    juce::String getName() const;
+};
+
+std::unique_ptr<tracktion::Edit>
+createSyntheticEdit(tracktion::Engine &engine, const SyntheticEditSpec &spec);
+
+} // namespace Benchmarks
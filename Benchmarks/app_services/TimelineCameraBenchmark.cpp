@@ -0,0 +1,39 @@
+#include "../BenchmarkRunner.h"
+#include <app_services/app_services.h>
+
+namespace Benchmarks {
+
+void runTimelineCameraBenchmarks(BenchmarkRunner &runner) {
+    // roughly what TracksView converts per repaint with a busy edit on screen
+    constexpr int numConversions = 10000;
+
+    app_services::TimelineCamera camera(7);
+    volatile double sink = 0.0;
+
+    runner.run(
+        "TimelineCamera/timeToX", 200,
+        [&] {
+            double sum = 0.0;
+            for (int i = 0; i < numConversions; i++)
+                sum += camera.timeToX(i * .001, 1280.0);
+            sink = sum;
+        },
+        numConversions, "conversions");
+
+    runner.run(
+        "TimelineCamera/nudgeAndConvert", 200,
+        [&] {
+            double sum = 0.0;
+            for (int i = 0; i < numConversions; i++) {
+                if (i % 2 == 0)
+                    camera.nudgeCameraForward();
+                else
+                    camera.nudgeCameraBackward();
+                sum += camera.timeToX(camera.getCenter(), 1280.0);
+            }
+            sink = sum;
+        },
+        numConversions, "conversions");
+}
+
+} // namespace Benchmarks
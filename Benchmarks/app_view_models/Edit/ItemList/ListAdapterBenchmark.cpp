@@ -0,0 +1,61 @@
+#include "../../../BenchmarkRunner.h"
+#include "../../../SyntheticEdit.h"
+#include <app_view_models/app_view_models.h>
+
+namespace Benchmarks {
+
+void runListAdapterBenchmarks(BenchmarkRunner &runner,
+                              tracktion::Engine &engine) {
+    constexpr int numTracks = 64;
+    SyntheticEditSpec spec;
+    spec.numTracks = numTracks;
+    spec.clipsPerTrack = 0;
+    auto edit = createSyntheticEdit(engine, spec);
+    auto track = tracktion::getAudioTracks(*edit)[0];
+    for (int i = 0; i < 8; i++)
+        track->pluginList.insertPlugin(
+            edit->getPluginCache().createNewPlugin(
+                tracktion::ReverbPlugin::xmlTypeName, {}),
+            -1, nullptr);
+
+    app_view_models::TracksListAdapter tracksAdapter(*edit);
+    app_view_models::PluginsListAdapter pluginsAdapter(track);
+    volatile int sink = 0;
+
+    runner.run(
+        "TracksListAdapter/getItemNames", 500,
+        [&] { sink = tracksAdapter.getItemNames().size(); }, 1, "queries");
+
+    runner.run(
+        "TracksListAdapter/size", 500, [&] { sink = tracksAdapter.size(); }, 1,
+        "queries");
+
+    // the way the list views walk the adapter when they lay out their rows
+    runner.run(
+        "TracksListAdapter/getItemAtIndexAll", 200,
+        [&] {
+            int found = 0;
+            for (int i = 0; i < numTracks; i++)
+                if (tracksAdapter.getItemAtIndex(i) != nullptr)
+                    found++;
+            sink = found;
+        },
+        numTracks, "queries");
+
+    runner.run(
+        "PluginsListAdapter/getItemNames", 500,
+        [&] { sink = pluginsAdapter.getItemNames().size(); }, 1, "queries");
+
+    runner.run(
+        "PluginsListAdapter/getItemAtIndexAll", 500,
+        [&] {
+            int found = 0;
+            for (int i = 0; i < pluginsAdapter.size(); i++)
+                if (pluginsAdapter.getItemAtIndex(i) != nullptr)
+                    found++;
+            sink = found;
+        },
+        pluginsAdapter.size(), "queries");
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,41 @@
+#include "../../../../BenchmarkRunner.h"
+#include <app_configuration/app_configuration.h>
+#include <app_view_models/app_view_models.h>
+
+namespace Benchmarks {
+
+void runDrumKitBenchmarks(BenchmarkRunner &runner, tracktion::Engine &engine) {
+    // the kits are read from the temp directory the samples are unpacked to
+    ConfigurationHelpers::initSamples(engine);
+
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+    auto track = tracktion::getAudioTracks(*edit)[0];
+    auto plugin = edit->getPluginCache().createNewPlugin(
+        internal_plugins::DrumSamplerPlugin::xmlTypeName, {});
+    track->pluginList.insertPlugin(plugin, 0, nullptr);
+
+    auto sampler =
+        dynamic_cast<internal_plugins::DrumSamplerPlugin *>(plugin.get());
+    if (sampler == nullptr)
+        return;
+
+    runner.run("DrumKit/createViewModel", 20, [&] {
+        app_view_models::DrumSamplerViewModel viewModel(sampler);
+    });
+
+    app_view_models::DrumSamplerViewModel viewModel(sampler);
+    auto numKits = viewModel.getItemNames().size();
+    if (numKits == 0)
+        return;
+
+    int kitIndex = 0;
+    runner.run(
+        "DrumKit/switchKit", 20,
+        [&] {
+            kitIndex = (kitIndex + 1) % numKits;
+            viewModel.selectedIndexChanged(kitIndex);
+        },
+        1, "kits");
+}
+
+} // namespace Benchmarks
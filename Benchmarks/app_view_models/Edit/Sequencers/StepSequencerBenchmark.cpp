@@ -0,0 +1,41 @@
+#include "../../../BenchmarkRunner.h"
+#include <app_view_models/app_view_models.h>
+
+namespace Benchmarks {
+
+void runStepSequencerBenchmarks(BenchmarkRunner &runner,
+                                tracktion::Engine &engine) {
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+    // the step sequencer reads the EDIT_VIEW_STATE the edit view model creates
+    app_view_models::EditViewModel editViewModel(*edit);
+    app_view_models::StepSequencerViewModel viewModel(
+        tracktion::getAudioTracks(*edit)[0]);
+
+    runner.run("StepSequencer/generateMidiSequenceEmpty", 200,
+               [&] { viewModel.generateMidiSequence(); });
+
+    // put a note on every third channel at every step so the whole pattern
+    // has to be written out
+    int numNotes = 0;
+    for (int noteNumber = 0; noteNumber < 128; noteNumber++) {
+        int channel = viewModel.noteNumberToChannel(noteNumber);
+        if (channel < 0 || channel >= viewModel.getNumChannels() ||
+            channel % 3 != 0)
+            continue;
+
+        while (viewModel.getSelectedNoteIndex() > 0)
+            viewModel.decrementSelectedNoteIndex();
+
+        // toggling moves the selection on to the next step
+        for (int step = 0; step < viewModel.getNumberOfNotes(); step++) {
+            viewModel.toggleNoteNumberAtSelectedIndex(noteNumber);
+            numNotes++;
+        }
+    }
+
+    runner.run(
+        "StepSequencer/generateMidiSequenceFull", 200,
+        [&] { viewModel.generateMidiSequence(); }, numNotes, "notes");
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,140 @@
+#include "../BenchmarkRunner.h"
+#include "../SyntheticEdit.h"
+#include <app_view_models/app_view_models.h>
+
+namespace Benchmarks {
+
+// Drives the main view models through scripted operations on generated edits
+// of increasing size. Every operation is followed by a flush of the pending
+// view model updates, which is what the UI does once per frame, so the
+// timings include the listener work each change causes.
+static void runStressScript(BenchmarkRunner &runner, tracktion::Engine &engine,
+                            const SyntheticEditSpec &spec) {
+    juce::SharedResourcePointer<app_view_models::UpdateBatcher> batcher;
+    auto prefix = "Stress/" + spec.getName() + "/";
+
+    auto createStart = juce::Time::getHighResolutionTicks();
+    auto edit = createSyntheticEdit(engine, spec);
+    auto createSeconds = juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - createStart);
+    std::fprintf(stderr, "generated %s in %.2f s\n", spec.getName().toRawUTF8(),
+                 createSeconds);
+
+    // the step sequencer reads the EDIT_VIEW_STATE the edit view model creates
+    app_view_models::EditViewModel editViewModel(*edit);
+    app_services::TimelineCamera camera(7);
+
+    runner.run(prefix + "TracksListViewModel/create", 5, [&] {
+        app_view_models::TracksListViewModel viewModel(*edit, camera);
+        batcher->flush();
+    });
+
+    app_view_models::TracksListViewModel tracksViewModel(*edit, camera);
+    app_view_models::MixerViewModel mixerViewModel(*edit);
+    batcher->flush();
+
+    auto numTracks = tracksViewModel.listViewModel.getAdapter()->size();
+    int trackIndex = 0;
+    runner.run(prefix + "TracksListViewModel/selectTrack", 200, [&] {
+        trackIndex = (trackIndex + 1) % numTracks;
+        tracksViewModel.listViewModel.itemListState.setSelectedItemIndex(
+            trackIndex);
+        batcher->flush();
+    });
+
+    runner.run(prefix + "TracksListViewModel/toggleSolo", 100, [&] {
+        tracksViewModel.toggleSolo();
+        batcher->flush();
+    });
+
+    runner.run(prefix + "TracksListViewModel/addAndDeleteTrack", 10, [&] {
+        tracksViewModel.addTrack();
+        batcher->flush();
+        tracksViewModel.deleteSelectedTrack();
+        batcher->flush();
+    });
+
+    int mixerIndex = 0;
+    auto numMixerTracks = mixerViewModel.listViewModel.getAdapter()->size();
+    runner.run(prefix + "MixerViewModel/selectTrack", 200, [&] {
+        mixerIndex = (mixerIndex + 1) % numMixerTracks;
+        mixerViewModel.listViewModel.itemListState.setSelectedItemIndex(
+            mixerIndex);
+        batcher->flush();
+    });
+
+    bool volumeUp = true;
+    runner.run(prefix + "MixerViewModel/volumeStep", 500, [&] {
+        if (volumeUp)
+            mixerViewModel.incrementVolume();
+        else
+            mixerViewModel.decrementVolume();
+
+        volumeUp = !volumeUp;
+        batcher->flush();
+    });
+
+    runner.run(prefix + "MixerViewModel/toggleMute", 100, [&] {
+        mixerViewModel.toggleMute();
+        batcher->flush();
+    });
+
+    auto track = tracktion::getAudioTracks(*edit)[0];
+    app_view_models::TrackPluginsListViewModel pluginsViewModel(track);
+    batcher->flush();
+
+    runner.run(prefix + "TrackPluginsListViewModel/moveSelectedPlugin", 100,
+               [&] {
+                   pluginsViewModel.moveSelectedPluginDown();
+                   batcher->flush();
+                   pluginsViewModel.moveSelectedPluginUp();
+                   batcher->flush();
+               });
+
+    runner.run(prefix + "TrackPluginsListViewModel/togglePluginEnabled", 100,
+               [&] {
+                   pluginsViewModel.toggleSelectedPluginEnabled();
+                   batcher->flush();
+               });
+
+    app_view_models::StepSequencerViewModel stepSequencerViewModel(track);
+    batcher->flush();
+
+    int noteNumber = 0;
+    while (noteNumber < 128 &&
+           stepSequencerViewModel.noteNumberToChannel(noteNumber) != 0)
+        noteNumber++;
+
+    runner.run(prefix + "StepSequencerViewModel/toggleNote", 200, [&] {
+        stepSequencerViewModel.toggleNoteNumberAtSelectedIndex(noteNumber);
+        batcher->flush();
+    });
+
+    runner.run(prefix + "StepSequencerViewModel/generateMidiSequence", 100,
+               [&] {
+                   stepSequencerViewModel.generateMidiSequence();
+                   batcher->flush();
+               });
+}
+
+void runViewModelStressBenchmarks(BenchmarkRunner &runner,
+                                  tracktion::Engine &engine) {
+    SyntheticEditSpec small;
+    small.numTracks = 8;
+    small.clipsPerTrack = 4;
+    small.notesPerClip = 16;
+    small.effectsPerTrack = 2;
+
+    // 64 tracks, about 2,000 clips and 100,000 notes
+    SyntheticEditSpec large;
+    large.numTracks = 64;
+    large.clipsPerTrack = 32;
+    large.notesPerClip = 49;
+    large.effectsPerTrack = 4;
+
+    for (const auto &spec : {small, large})
+        if (runner.shouldRun("Stress/" + spec.getName()))
+            runStressScript(runner, engine, spec);
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,37 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<bool> countAllocations{false};
+std::atomic<int> allocationCount{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+    if (countAllocations.load(std::memory_order_relaxed))
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace AllocationCounter {
+
+void start() {
+    allocationCount = 0;
+    countAllocations = true;
+}
+
+int stop() {
+    countAllocations = false;
+    return allocationCount.load();
+}
+
+} // namespace AllocationCounter
@@ -0,0 +1,16 @@
+#pragma once
+
+// Counts the allocations made through the global operator new.
+//
+// Linking AllocationCounter.cpp into a benchmark replaces the global
+// allocation functions, so the plugin benchmarks can fail when their audio
+// path allocates. Counting is off until it is started.
+namespace AllocationCounter {
+
+// Resets the count and starts counting
+void start();
+
+// Stops counting and returns how many allocations were made since start
+int stop();
+
+} // namespace AllocationCounter
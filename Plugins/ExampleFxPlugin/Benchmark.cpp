@@ -0,0 +1,63 @@
+// Standalone throughput benchmark for the example effect's DSP.
+//
+// Runs DriveWidthProcessor over a range of block sizes with continuously
+// moving parameters and reports the throughput and how much faster than real
+// time it runs. Every allocation made while processing is counted, the
+// benchmark fails if the audio path allocates at all.
+#include "../BenchmarkSupport/AllocationCounter.h"
+#include "DriveWidthProcessor.h"
+#include <cstdio>
+#include <juce_core/juce_core.h>
+
+int main() {
+    constexpr double sampleRate = 48000.0;
+    constexpr double secondsOfAudio = 60.0;
+    const int blockSizes[] = {32, 64, 128, 256, 512, 1024};
+
+    bool allocated = false;
+    juce::Random random(1234);
+
+    for (auto blockSize : blockSizes) {
+        DriveWidthProcessor processor;
+        processor.prepare(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        auto numBlocks = static_cast<int>(secondsOfAudio * sampleRate /
+                                          static_cast<double>(blockSize));
+
+        AllocationCounter::start();
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block) {
+            // keep the smoothers busy so the ramp path is measured too
+            float phase = static_cast<float>(block % 256) / 256.0f;
+            processor.setParameters({phase, 1.0f - phase, phase, .8f});
+            processor.process(buffer);
+        }
+
+        auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - start);
+        auto numAllocations = AllocationCounter::stop();
+
+        auto samplesPerSecond =
+            static_cast<double>(numBlocks) * blockSize / elapsedSeconds;
+        std::printf("block size %5d: %8.2f Msamples/s, %8.1fx real time, "
+                    "%d allocations\n",
+                    blockSize, samplesPerSecond / 1.0e6,
+                    samplesPerSecond / sampleRate, numAllocations);
+
+        if (numAllocations > 0)
+            allocated = true;
+    }
+
+    if (allocated) {
+        std::printf("FAILED: the audio path allocated memory\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "DriveWidthProcessor.h"
+
+//==============================================================================
+void DriveWidthProcessor::prepare(double sampleRate, int maximumBlockSize) {
+    maxBlockSize = juce::jmax(1, maximumBlockSize);
+
+    // Round the channels up to a whole number of SIMD registers so the kernel
+    // never needs a scalar tail loop. The padding gets processed but is never
+    // copied back out.
+    auto numElements = static_cast<int>(SIMDFloat::SIMDNumElements);
+    auto paddedBlockSize =
+        ((maxBlockSize + numElements - 1) / numElements) * numElements;
+    scratch = juce::dsp::AudioBlock<float>(
+        scratchMemory, static_cast<size_t>(numScratchChannels),
+        static_cast<size_t>(paddedBlockSize), sizeof(SIMDFloat));
+    scratch.clear();
+
+    driveGain.reset(sampleRate, smoothingTimeSeconds);
+    mix.reset(sampleRate, smoothingTimeSeconds);
+    width.reset(sampleRate, smoothingTimeSeconds);
+    outputGain.reset(sampleRate, smoothingTimeSeconds);
+}
+
+void DriveWidthProcessor::reset() {
+    driveGain.setCurrentAndTargetValue(driveGain.getTargetValue());
+    mix.setCurrentAndTargetValue(mix.getTargetValue());
+    width.setCurrentAndTargetValue(width.getTargetValue());
+    outputGain.setCurrentAndTargetValue(outputGain.getTargetValue());
+}
+
+void DriveWidthProcessor::setParameters(const Parameters &newParameters) {
+    // drive goes from unity up to +20dB into the clipper
+    driveGain.setTargetValue(1.0f + 9.0f * newParameters.drive);
+    mix.setTargetValue(newParameters.mix);
+    // 0 is mono, .5 leaves the stereo image untouched and 1 doubles the side
+    // signal
+    width.setTargetValue(2.0f * newParameters.width);
+    outputGain.setTargetValue(newParameters.output);
+}
+
+void DriveWidthProcessor::process(juce::AudioBuffer<float> &buffer) {
+    jassert(maxBlockSize > 0);
+
+    // Hosts are allowed to send bigger blocks than they announced in
+    // prepareToPlay, split those up rather than reallocating on the audio
+    // thread
+    for (int start = 0; start < buffer.getNumSamples(); start += maxBlockSize)
+        processChunk(buffer, start,
+                     juce::jmin(maxBlockSize, buffer.getNumSamples() - start));
+}
+
+void DriveWidthProcessor::processChunk(juce::AudioBuffer<float> &buffer,
+                                       int startSample, int numSamples) {
+    if (buffer.getNumChannels() == 0 || numSamples <= 0)
+        return;
+
+    auto *leftChannel = buffer.getWritePointer(0, startSample);
+    auto *rightChannel = buffer.getNumChannels() > 1
+                             ? buffer.getWritePointer(1, startSample)
+                             : leftChannel;
+
+    auto *l = scratch.getChannelPointer(left);
+    auto *r = scratch.getChannelPointer(right);
+    auto *d = scratch.getChannelPointer(driveRamp);
+    auto *m = scratch.getChannelPointer(mixRamp);
+    auto *w = scratch.getChannelPointer(widthRamp);
+    auto *o = scratch.getChannelPointer(outputRamp);
+
+    // host buffers have no alignment guarantees so work on aligned copies
+    juce::FloatVectorOperations::copy(l, leftChannel, numSamples);
+    juce::FloatVectorOperations::copy(r, rightChannel, numSamples);
+
+    fillRamp(driveGain, d, numSamples);
+    fillRamp(mix, m, numSamples);
+    fillRamp(width, w, numSamples);
+    fillRamp(outputGain, o, numSamples);
+
+    const auto half = SIMDFloat::expand(.5f);
+    const auto numElements = SIMDFloat::SIMDNumElements;
+    const auto paddedNumSamples =
+        ((static_cast<size_t>(numSamples) + numElements - 1) / numElements) *
+        numElements;
+
+    for (size_t i = 0; i < paddedNumSamples; i += numElements) {
+        auto dryL = SIMDFloat::fromRawArray(l + i);
+        auto dryR = SIMDFloat::fromRawArray(r + i);
+        auto drive = SIMDFloat::fromRawArray(d + i);
+        auto wetAmount = SIMDFloat::fromRawArray(m + i);
+        auto stereoWidth = SIMDFloat::fromRawArray(w + i);
+        auto output = SIMDFloat::fromRawArray(o + i);
+
+        auto mid = (dryL + dryR) * half;
+        auto side = (dryL - dryR) * half * stereoWidth;
+
+        auto wetL = softClip((mid + side) * drive);
+        auto wetR = softClip((mid - side) * drive);
+
+        auto outL = (dryL + (wetL - dryL) * wetAmount) * output;
+        auto outR = (dryR + (wetR - dryR) * wetAmount) * output;
+
+        outL.copyToRawArray(l + i);
+        outR.copyToRawArray(r + i);
+    }
+
+    juce::FloatVectorOperations::copy(leftChannel, l, numSamples);
+    if (rightChannel != leftChannel)
+        juce::FloatVectorOperations::copy(rightChannel, r, numSamples);
+}
+
+void DriveWidthProcessor::fillRamp(juce::SmoothedValue<float> &value,
+                                   float *dest, int numSamples) {
+    if (!value.isSmoothing()) {
+        juce::FloatVectorOperations::fill(dest, value.getTargetValue(),
+                                          numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = value.getNextValue();
+}
+
+DriveWidthProcessor::SIMDFloat DriveWidthProcessor::softClip(SIMDFloat x) {
+    // cubic soft clipper, peaks at exactly 1 for inputs at or beyond +-1
+    x = SIMDFloat::max(SIMDFloat::min(x, SIMDFloat::expand(1.0f)),
+                       SIMDFloat::expand(-1.0f));
+    return x * (SIMDFloat::expand(1.5f) - x * x * .5f);
+}
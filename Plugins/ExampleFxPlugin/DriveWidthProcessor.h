@@ -0,0 +1,65 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+//==============================================================================
+// The DSP used by the example effect: a stereo width control followed by a
+// cubic soft clipper with dry/wet mix and output level.
+//
+// It is kept separate from the AudioProcessor so it can be benchmarked on its
+// own. All memory is allocated in prepare(), process() never allocates, locks
+// or calls into the message thread, so it is safe to call from the audio
+// callback.
+class DriveWidthProcessor {
+  public:
+    struct Parameters {
+        // all values are normalised between 0 and 1
+        float drive = 0.0f;
+        float mix = 1.0f;
+        float width = 0.5f;
+        float output = 1.0f;
+    };
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void reset();
+
+    // Sets the values the smoothed parameters will ramp towards
+    void setParameters(const Parameters &newParameters);
+
+    // Processes the first two channels of the buffer in place. Mono buffers
+    // are treated as a stereo pair with identical channels.
+    void process(juce::AudioBuffer<float> &buffer);
+
+    int getMaximumBlockSize() const { return maxBlockSize; }
+
+  private:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+
+    static constexpr double smoothingTimeSeconds = .02;
+
+    juce::SmoothedValue<float> driveGain{1.0f};
+    juce::SmoothedValue<float> mix{1.0f};
+    juce::SmoothedValue<float> width{1.0f};
+    juce::SmoothedValue<float> outputGain{1.0f};
+
+    // SIMD aligned scratch memory for the channel data and the per sample
+    // parameter ramps, allocated once in prepare()
+    enum ScratchChannel {
+        left = 0,
+        right,
+        driveRamp,
+        mixRamp,
+        widthRamp,
+        outputRamp,
+        numScratchChannels,
+    };
+    juce::HeapBlock<char> scratchMemory;
+    juce::dsp::AudioBlock<float> scratch;
+    int maxBlockSize = 0;
+
+    void processChunk(juce::AudioBuffer<float> &buffer, int startSample,
+                      int numSamples);
+    static void fillRamp(juce::SmoothedValue<float> &value, float *dest,
+                         int numSamples);
+    static SIMDFloat softClip(SIMDFloat x);
+};
@@ -18,16 +18,27 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
              std::make_unique<juce::AudioParameterFloat>(
                  parameter1Id, parameter1Name, 0.0f, 1.0f, 0.0f),
              std::make_unique<juce::AudioParameterFloat>(
-                 parameter2Id, parameter2Name, 0.0f, 1.0f, 0.0f),
+                 parameter2Id, parameter2Name, 0.0f, 1.0f, 1.0f),
              std::make_unique<juce::AudioParameterFloat>(
-                 parameter3Id, parameter3Name, 0.0f, 1.0f, 0.0f),
+                 parameter3Id, parameter3Name, 0.0f, 1.0f, 0.5f),
              std::make_unique<juce::AudioParameterFloat>(
-                 parameter4Id, parameter4Name, 0.0f, 1.0f, 0.0f)
+                 parameter4Id, parameter4Name, 0.0f, 1.0f, 1.0f)
 
             }) {
+    editorIsVisible = state.getRawParameterValue(editorIsVisibleId);
+
+    const juce::String parameterIds[] = {parameter1Id, parameter2Id,
+                                         parameter3Id, parameter4Id};
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        parameters[i] = state.getParameter(parameterIds[i]);
+        parameterValues[i] = state.getRawParameterValue(parameterIds[i]);
+        jassert(parameters[i] != nullptr && parameterValues[i] != nullptr);
+    }
+
+    startTimer(encoderTimerIntervalMs);
 }
 
-AudioPluginAudioProcessor::~AudioPluginAudioProcessor() {}
+AudioPluginAudioProcessor::~AudioPluginAudioProcessor() { stopTimer(); }
 
 //==============================================================================
 const juce::String AudioPluginAudioProcessor::getName() const {
@@ -85,9 +96,14 @@ void AudioPluginAudioProcessor::changeProgramName(int index,
 //==============================================================================
 void AudioPluginAudioProcessor::prepareToPlay(double sampleRate,
                                               int samplesPerBlock) {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-    juce::ignoreUnused(sampleRate, samplesPerBlock);
+    // Everything the audio thread needs is allocated here, processBlock must
+    // never allocate
+    processor.prepare(sampleRate, samplesPerBlock);
+    processor.setParameters({parameterValues[0]->load(),
+                             parameterValues[1]->load(),
+                             parameterValues[2]->load(),
+                             parameterValues[3]->load()});
+    processor.reset();
 }
 
 void AudioPluginAudioProcessor::releaseResources() {
@@ -117,82 +133,40 @@ bool AudioPluginAudioProcessor::isBusesLayoutSupported(
 #endif
 }
 
-void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
-                                             juce::MidiBuffer &midiMessages) {
-    bool editorIsVisible =
-        *(state.getRawParameterValue(editorIsVisibleId)) > .5f;
-
-    if (editorIsVisible) {
-        int increaseValueFlag = 1;
-        int decreaseValueFlag = 127;
-        for (auto messageData : midiMessages) {
-            if (messageData.getMessage().isController()) {
-                if (messageData.getMessage().getControllerNumber() == 3) {
-                    float currentValue =
-                        state.getParameter(parameter1Id)->getValue();
-                    if (messageData.getMessage().getControllerValue() ==
-                        increaseValueFlag) {
-                        state.getParameter(parameter1Id)
-                            ->setValueNotifyingHost(currentValue + .01f);
-                    }
-
-                    if (messageData.getMessage().getControllerValue() ==
-                        decreaseValueFlag) {
-                        state.getParameter(parameter1Id)
-                            ->setValueNotifyingHost(currentValue - .01f);
-                    }
-                }
-
-                if (messageData.getMessage().getControllerNumber() == 9) {
-                    float currentValue =
-                        state.getParameter(parameter2Id)->getValue();
-                    if (messageData.getMessage().getControllerValue() ==
-                        increaseValueFlag) {
-                        state.getParameter(parameter2Id)
-                            ->setValueNotifyingHost(currentValue + .01f);
-                    }
-
-                    if (messageData.getMessage().getControllerValue() ==
-                        decreaseValueFlag) {
-                        state.getParameter(parameter2Id)
-                            ->setValueNotifyingHost(currentValue - .01f);
-                    }
-                }
-
-                if (messageData.getMessage().getControllerNumber() == 14) {
-                    float currentValue =
-                        state.getParameter(parameter3Id)->getValue();
-                    if (messageData.getMessage().getControllerValue() ==
-                        increaseValueFlag) {
-                        state.getParameter(parameter3Id)
-                            ->setValueNotifyingHost(currentValue + .01f);
-                    }
-
-                    if (messageData.getMessage().getControllerValue() ==
-                        decreaseValueFlag) {
-                        state.getParameter(parameter3Id)
-                            ->setValueNotifyingHost(currentValue - .01f);
-                    }
-                }
-
-                if (messageData.getMessage().getControllerNumber() == 15) {
-                    float currentValue =
-                        state.getParameter(parameter4Id)->getValue();
-                    if (messageData.getMessage().getControllerValue() ==
-                        increaseValueFlag) {
-                        state.getParameter(parameter4Id)
-                            ->setValueNotifyingHost(currentValue + .01f);
-                    }
-
-                    if (messageData.getMessage().getControllerValue() ==
-                        decreaseValueFlag) {
-                        state.getParameter(parameter4Id)
-                            ->setValueNotifyingHost(currentValue - .01f);
-                    }
-                }
-            }
+void AudioPluginAudioProcessor::handleEncoderMessages(
+    const juce::MidiBuffer &midiMessages) {
+    for (auto messageData : midiMessages) {
+        auto message = messageData.getMessage();
+        if (!message.isController())
+            continue;
+
+        for (size_t i = 0; i < encoderControllers.size(); ++i) {
+            if (message.getControllerNumber() != encoderControllers[i])
+                continue;
+
+            if (message.getControllerValue() == increaseValueFlag)
+                pendingEncoderSteps[i].fetch_add(1, std::memory_order_relaxed);
+
+            if (message.getControllerValue() == decreaseValueFlag)
+                pendingEncoderSteps[i].fetch_sub(1, std::memory_order_relaxed);
         }
     }
+}
+
+void AudioPluginAudioProcessor::timerCallback() {
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        auto steps = pendingEncoderSteps[i].exchange(0);
+        if (steps != 0)
+            parameters[i]->setValueNotifyingHost(parameters[i]->getValue() +
+                                                 float(steps) * encoderStep);
+    }
+}
+
+void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
+                                             juce::MidiBuffer &midiMessages) {
+    // The encoders should only change parameters while the editor is showing
+    if (editorIsVisible->load() > .5f)
+        handleEncoderMessages(midiMessages);
 
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -207,17 +181,13 @@ void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // This is the place where you'd normally do the guts of your plugin's
-    // audio processing...
-    // Make sure to reset the state if your inner loop is processing
-    // the samples and the outer loop is handling the channels.
-    // Alternatively, you can process the samples with the channels
-    // interleaved by keeping the same state.
-    for (int channel = 0; channel < totalNumInputChannels; ++channel) {
-        auto *channelData = buffer.getWritePointer(channel);
-        juce::ignoreUnused(channelData);
-        // ..do something to the data...
-    }
+    // The parameter values are read once per block, the processor smooths
+    // them per sample towards these targets
+    processor.setParameters({parameterValues[0]->load(),
+                             parameterValues[1]->load(),
+                             parameterValues[2]->load(),
+                             parameterValues[3]->load()});
+    processor.process(buffer);
 }
 
 //==============================================================================
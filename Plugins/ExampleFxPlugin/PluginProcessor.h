@@ -1,19 +1,22 @@
 #pragma once
+#include "DriveWidthProcessor.h"
+#include <array>
 #include <juce_audio_processors/juce_audio_processors.h>
 
 //==============================================================================
-class AudioPluginAudioProcessor : public juce::AudioProcessor {
+class AudioPluginAudioProcessor : public juce::AudioProcessor,
+                                  private juce::Timer {
   public:
     const juce::String editorIsVisibleId = "editorIsVisible";
     const juce::String editorIsVisibleName = "Editor Is Visible";
     const juce::String parameter1Id = "parameter1";
-    const juce::String parameter1Name = "Parameter 1";
+    const juce::String parameter1Name = "Drive";
     const juce::String parameter2Id = "parameter2";
-    const juce::String parameter2Name = "Parameter 2";
+    const juce::String parameter2Name = "Mix";
     const juce::String parameter3Id = "parameter3";
-    const juce::String parameter3Name = "Parameter 3";
+    const juce::String parameter3Name = "Width";
     const juce::String parameter4Id = "parameter4";
-    const juce::String parameter4Name = "Parameter 4";
+    const juce::String parameter4Name = "Output";
 
     //==============================================================================
     AudioPluginAudioProcessor();
@@ -53,6 +56,31 @@ class AudioPluginAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState state;
 
   private:
+    //==============================================================================
+    // Parameter pointers are looked up once here instead of by string ID on
+    // the audio thread
+    std::atomic<float> *editorIsVisible = nullptr;
+    std::array<juce::RangedAudioParameter *, 4> parameters{};
+    std::array<std::atomic<float> *, 4> parameterValues{};
+
+    // LMN-3 encoders 1-4 send these controller numbers, the index into this
+    // array is the index of the parameter they control
+    static constexpr std::array<int, 4> encoderControllers{3, 9, 14, 15};
+    static constexpr int increaseValueFlag = 1;
+    static constexpr int decreaseValueFlag = 127;
+
+    // Encoder turns are counted on the audio thread and applied to the
+    // parameters on the message thread, since notifying the host may lock
+    // or allocate
+    std::array<std::atomic<int>, 4> pendingEncoderSteps{};
+    static constexpr int encoderTimerIntervalMs = 20;
+    static constexpr float encoderStep = .01f;
+
+    DriveWidthProcessor processor;
+
+    void handleEncoderMessages(const juce::MidiBuffer &midiMessages);
+    void timerCallback() override;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioPluginAudioProcessor)
 };
@@ -0,0 +1,68 @@
+// Standalone voices versus CPU benchmark for the example synth's voice engine.
+//
+// Holds 1 to 16 notes and renders 60 seconds of audio for each count,
+// reporting what percentage of the real time budget the engine used. Every
+// allocation made while rendering is counted, the benchmark fails if the audio
+// path allocates at all.
+#include "../BenchmarkSupport/AllocationCounter.h"
+#include "SynthVoiceEngine.h"
+#include <cstdio>
+#include <juce_core/juce_core.h>
+
+int main() {
+    constexpr double sampleRate = 48000.0;
+    constexpr double secondsOfAudio = 60.0;
+    constexpr int blockSize = 128;
+    const int voiceCounts[] = {1, 2, 4, 8, 16};
+
+    bool allocated = false;
+
+    for (auto numVoices : voiceCounts) {
+        auto engine = std::make_unique<SynthVoiceEngine>();
+        engine->prepare(sampleRate);
+        engine->setParameters({});
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        // reserve enough room that adding the notes never reallocates
+        juce::MidiBuffer notes;
+        notes.ensureSize(1024);
+        for (int voice = 0; voice < numVoices; ++voice)
+            notes.addEvent(juce::MidiMessage::noteOn(1, 36 + voice * 3, .8f),
+                           0);
+
+        juce::MidiBuffer noMessages;
+        auto numBlocks = static_cast<int>(secondsOfAudio * sampleRate /
+                                          static_cast<double>(blockSize));
+
+        AllocationCounter::start();
+        auto start = juce::Time::getHighResolutionTicks();
+
+        engine->render(buffer, notes);
+        for (int block = 1; block < numBlocks; ++block) {
+            // sweep the filter so the coefficient smoothing is measured too
+            float sweep = static_cast<float>(block % 512) / 512.0f;
+            engine->setParameters({sweep, .1f, .3f, .7f});
+            engine->render(buffer, noMessages);
+        }
+
+        auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - start);
+        auto numAllocations = AllocationCounter::stop();
+
+        std::printf("%2d voices: %6.2f%% of real time, %d active, "
+                    "%d allocations\n",
+                    numVoices, 100.0 * elapsedSeconds / secondsOfAudio,
+                    engine->getNumActiveVoices(), numAllocations);
+
+        if (numAllocations > 0)
+            allocated = true;
+    }
+
+    if (allocated) {
+        std::printf("FAILED: the audio path allocated memory\n");
+        return 1;
+    }
+
+    return 0;
+}
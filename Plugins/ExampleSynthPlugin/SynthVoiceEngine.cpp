@@ -0,0 +1,218 @@
+#include "SynthVoiceEngine.h"
+
+//==============================================================================
+void SynthVoiceEngine::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+    filterCoefficient.reset(sampleRate, .02);
+    reset();
+}
+
+void SynthVoiceEngine::reset() {
+    phase.fill(0.0f);
+    phaseIncrement.fill(0.0f);
+    envelopeLevel.fill(0.0f);
+    envelopeTarget.fill(0.0f);
+    envelopeCoefficient.fill(0.0f);
+    filterState.fill(0.0f);
+    velocity.fill(0.0f);
+    noteNumber.fill(-1);
+    isActive.fill(false);
+    filterCoefficient.setCurrentAndTargetValue(
+        filterCoefficient.getTargetValue());
+}
+
+void SynthVoiceEngine::setParameters(const Parameters &newParameters) {
+    // cutoff sweeps from 20Hz to 20kHz
+    auto cutoffHz = 20.0f * std::pow(1000.0f, newParameters.cutoff);
+    cutoffHz = juce::jmin(cutoffHz, static_cast<float>(sampleRate) * .45f);
+    filterCoefficient.setTargetValue(
+        1.0f - std::exp(-juce::MathConstants<float>::twoPi * cutoffHz /
+                        static_cast<float>(sampleRate)));
+
+    attackCoefficient = timeToCoefficient(.001f + 2.0f * newParameters.attack);
+    releaseCoefficient =
+        timeToCoefficient(.005f + 4.0f * newParameters.release);
+    gain = newParameters.gain;
+
+    // voices that are already sounding pick up the new envelope times
+    for (int voice = 0; voice < maxVoices; ++voice)
+        if (isActive[voice])
+            envelopeCoefficient[voice] = envelopeTarget[voice] > 0.0f
+                                             ? attackCoefficient
+                                             : releaseCoefficient;
+}
+
+void SynthVoiceEngine::render(juce::AudioBuffer<float> &buffer,
+                              const juce::MidiBuffer &midiMessages) {
+    buffer.clear();
+    if (buffer.getNumChannels() == 0)
+        return;
+
+    // The voices are summed into the first channel and copied to the rest
+    auto *output = buffer.getWritePointer(0);
+    int position = 0;
+
+    // Render up to each event, then apply it, so notes are sample accurate
+    for (auto metadata : midiMessages) {
+        auto eventPosition =
+            juce::jlimit(0, buffer.getNumSamples(), metadata.samplePosition);
+        if (eventPosition > position) {
+            renderVoices(output + position, eventPosition - position);
+            position = eventPosition;
+        }
+
+        handleMidiEvent(metadata.getMessage());
+    }
+
+    if (position < buffer.getNumSamples())
+        renderVoices(output + position, buffer.getNumSamples() - position);
+
+    for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
+        buffer.copyFrom(channel, 0, buffer, 0, 0, buffer.getNumSamples());
+}
+
+void SynthVoiceEngine::noteOn(int note, float noteVelocity) {
+    auto voice = findVoiceToUse();
+    auto frequency =
+        static_cast<float>(juce::MidiMessage::getMidiNoteInHertz(note));
+
+    noteNumber[voice] = note;
+    velocity[voice] = noteVelocity;
+    phaseIncrement[voice] = frequency / static_cast<float>(sampleRate);
+    envelopeTarget[voice] = 1.0f;
+    envelopeCoefficient[voice] = attackCoefficient;
+
+    // a fresh voice starts from silence, a stolen one glides from its
+    // current level to avoid a click
+    if (!isActive[voice]) {
+        phase[voice] = 0.0f;
+        envelopeLevel[voice] = 0.0f;
+        filterState[voice] = 0.0f;
+    }
+
+    isActive[voice] = true;
+}
+
+void SynthVoiceEngine::noteOff(int note) {
+    for (int voice = 0; voice < maxVoices; ++voice) {
+        if (isActive[voice] && noteNumber[voice] == note &&
+            envelopeTarget[voice] > 0.0f) {
+            envelopeTarget[voice] = 0.0f;
+            envelopeCoefficient[voice] = releaseCoefficient;
+        }
+    }
+}
+
+void SynthVoiceEngine::allNotesOff() {
+    for (int voice = 0; voice < maxVoices; ++voice) {
+        envelopeTarget[voice] = 0.0f;
+        envelopeCoefficient[voice] = releaseCoefficient;
+    }
+}
+
+int SynthVoiceEngine::getNumActiveVoices() const {
+    int numActive = 0;
+    for (auto active : isActive)
+        if (active)
+            numActive++;
+
+    return numActive;
+}
+
+void SynthVoiceEngine::renderVoices(float *output, int numSamples) {
+    // the filter coefficient is smoothed in short chunks since it is shared by
+    // all voices
+    constexpr int chunkSize = 32;
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        auto samplesThisChunk = juce::jmin(chunkSize, numSamples - start);
+        auto cutoffCoefficient = filterCoefficient.skip(samplesThisChunk);
+
+        for (int group = 0; group < numVoiceGroups; ++group)
+            renderVoiceGroup(group, output + start, samplesThisChunk,
+                             cutoffCoefficient);
+    }
+
+    updateActiveVoices();
+}
+
+void SynthVoiceEngine::renderVoiceGroup(int group, float *output,
+                                        int numSamples,
+                                        float cutoffCoefficient) {
+    auto first = group * voicesPerRegister;
+
+    bool anyActive = false;
+    for (int voice = first; voice < first + voicesPerRegister; ++voice)
+        anyActive = anyActive || isActive[voice];
+
+    if (!anyActive)
+        return;
+
+    // Load the group's state into registers once, run every sample on them
+    // and only write the state back at the end
+    auto groupPhase = SIMDFloat::fromRawArray(phase.data() + first);
+    auto increment = SIMDFloat::fromRawArray(phaseIncrement.data() + first);
+    auto level = SIMDFloat::fromRawArray(envelopeLevel.data() + first);
+    auto target = SIMDFloat::fromRawArray(envelopeTarget.data() + first);
+    auto coefficient =
+        SIMDFloat::fromRawArray(envelopeCoefficient.data() + first);
+    auto filter = SIMDFloat::fromRawArray(filterState.data() + first);
+    auto amplitude = SIMDFloat::fromRawArray(velocity.data() + first) * gain;
+
+    const auto one = SIMDFloat::expand(1.0f);
+    const auto two = SIMDFloat::expand(2.0f);
+    const auto cutoff = SIMDFloat::expand(cutoffCoefficient);
+
+    for (int i = 0; i < numSamples; ++i) {
+        groupPhase = groupPhase + increment;
+        groupPhase = groupPhase -
+                     (one & SIMDFloat::greaterThanOrEqual(groupPhase, one));
+
+        auto saw = groupPhase * two - one;
+        filter = filter + (saw - filter) * cutoff;
+        level = level + (target - level) * coefficient;
+
+        output[i] += (filter * level * amplitude).sum();
+    }
+
+    groupPhase.copyToRawArray(phase.data() + first);
+    level.copyToRawArray(envelopeLevel.data() + first);
+    filter.copyToRawArray(filterState.data() + first);
+}
+
+void SynthVoiceEngine::updateActiveVoices() {
+    for (int voice = 0; voice < maxVoices; ++voice) {
+        if (isActive[voice] && envelopeTarget[voice] == 0.0f &&
+            envelopeLevel[voice] < silenceThreshold) {
+            isActive[voice] = false;
+            envelopeLevel[voice] = 0.0f;
+            noteNumber[voice] = -1;
+        }
+    }
+}
+
+void SynthVoiceEngine::handleMidiEvent(const juce::MidiMessage &message) {
+    if (message.isNoteOn())
+        noteOn(message.getNoteNumber(), message.getFloatVelocity());
+    else if (message.isNoteOff())
+        noteOff(message.getNoteNumber());
+    else if (message.isAllNotesOff() || message.isAllSoundOff())
+        allNotesOff();
+}
+
+int SynthVoiceEngine::findVoiceToUse() const {
+    // prefer a free voice, otherwise steal the quietest one
+    int quietestVoice = 0;
+    for (int voice = 0; voice < maxVoices; ++voice) {
+        if (!isActive[voice])
+            return voice;
+
+        if (envelopeLevel[voice] < envelopeLevel[quietestVoice])
+            quietestVoice = voice;
+    }
+
+    return quietestVoice;
+}
+
+float SynthVoiceEngine::timeToCoefficient(float seconds) const {
+    return 1.0f - std::exp(-1.0f / (seconds * static_cast<float>(sampleRate)));
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+//==============================================================================
+// A polyphonic saw synth voice engine laid out as a structure of arrays.
+//
+// Instead of an array of voice objects, every piece of per voice state lives
+// in its own array indexed by voice. The render loop then processes a whole
+// SIMD register worth of voices at once, which a loop over voice objects
+// cannot do. Voice groups with nothing playing are skipped entirely.
+//
+// MIDI is handled by splitting each block at the event positions, so notes
+// start and stop on the exact sample they were sent on.
+//
+// All memory is owned by the object itself, nothing is allocated after
+// prepare() so render() is safe to call from the audio callback.
+class SynthVoiceEngine {
+  public:
+    static constexpr int maxVoices = 16;
+
+    struct Parameters {
+        // all values are normalised between 0 and 1
+        float cutoff = .5f;
+        float attack = .1f;
+        float release = .3f;
+        float gain = .7f;
+    };
+
+    void prepare(double sampleRate);
+    void reset();
+
+    void setParameters(const Parameters &newParameters);
+
+    // Renders the voices into every channel of the buffer, replacing its
+    // contents. Notes in the midi buffer are applied at their sample position.
+    void render(juce::AudioBuffer<float> &buffer,
+                const juce::MidiBuffer &midiMessages);
+
+    void noteOn(int noteNumber, float velocity);
+    void noteOff(int noteNumber);
+    void allNotesOff();
+
+    int getNumActiveVoices() const;
+
+  private:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+    static constexpr int voicesPerRegister =
+        static_cast<int>(SIMDFloat::SIMDNumElements);
+    static constexpr int numVoiceGroups = maxVoices / voicesPerRegister;
+    static_assert(maxVoices % voicesPerRegister == 0,
+                  "maxVoices must be a multiple of the SIMD register width");
+
+    // below this level a released voice is considered silent
+    static constexpr float silenceThreshold = 1.0e-4f;
+
+    template <typename T>
+    using VoiceArray = std::array<T, maxVoices>;
+
+    // Per voice state. Every float array is aligned so a group of voices can
+    // be loaded straight into a SIMD register.
+    alignas(sizeof(SIMDFloat)) VoiceArray<float> phase{};
+    alignas(sizeof(SIMDFloat)) VoiceArray<float> phaseIncrement{};
+    alignas(sizeof(SIMDFloat)) VoiceArray<float> envelopeLevel{};
+    alignas(sizeof(SIMDFloat)) VoiceArray<float> envelopeTarget{};
+    alignas(sizeof(SIMDFloat)) VoiceArray<float> envelopeCoefficient{};
+    alignas(sizeof(SIMDFloat)) VoiceArray<float> filterState{};
+    alignas(sizeof(SIMDFloat)) VoiceArray<float> velocity{};
+    VoiceArray<int> noteNumber{};
+    VoiceArray<bool> isActive{};
+
+    double sampleRate = 44100.0;
+    float attackCoefficient = 1.0f;
+    float releaseCoefficient = 1.0f;
+    float gain = 1.0f;
+    juce::SmoothedValue<float> filterCoefficient{1.0f};
+
+    void renderVoices(float *output, int numSamples);
+    void renderVoiceGroup(int group, float *output, int numSamples,
+                          float cutoffCoefficient);
+    void updateActiveVoices();
+    void handleMidiEvent(const juce::MidiMessage &message);
+    int findVoiceToUse() const;
+    float timeToCoefficient(float seconds) const;
+};
@@ -1,6 +1,7 @@
 #include <ImageData.h>
 #include <app_configuration/app_configuration.h>
 #include <app_services/app_services.h>
+#include <app_view_models/app_view_models.h>
 #include <internal_plugins/internal_plugins.h>
 #include <memory>
 #include <tracktion_engine/tracktion_engine.h>
@@ -11,7 +12,8 @@
 
 #include "AppLookAndFeel.h"
 
-class GuiAppApplication : public juce::JUCEApplication {
+class GuiAppApplication : public juce::JUCEApplication,
+                          private AppConfiguration::Listener {
   public:
     GuiAppApplication()
         : splash(new juce::SplashScreen(
@@ -34,24 +36,144 @@ class GuiAppApplication : public juce::JUCEApplication {
         // code..
         juce::ignoreUnused(commandLine);
 
-        // Create application wide file logger
-        logger = std::unique_ptr<juce::FileLogger>(
-            juce::FileLogger::createDefaultAppLogger(
-                getApplicationName(), "log.txt",
-                getApplicationName() + " Logs"));
+        auto userAppDataDirectory = juce::File::getSpecialLocation(
+            juce::File::userApplicationDataDirectory);
+        auto &config = configuration->get();
+
+        // Create application wide logger, it writes to the file from a
+        // background thread so logging never blocks the caller
+        app_services::AsyncLogger::Options loggerOptions;
+        loggerOptions.logFile =
+            juce::FileLogger::getSystemLogFileFolder()
+                .getChildFile(getApplicationName())
+                .getChildFile("log.txt");
+        loggerOptions.level = app_services::AsyncLogger::getLevelForName(
+            config.logging.level, app_services::AsyncLogger::Level::info);
+        logger = std::make_unique<app_services::AsyncLogger>(loggerOptions);
         juce::Logger::setCurrentLogger(logger.get());
+        juce::Logger::writeToLog(getApplicationName() + " " +
+                                 getApplicationVersion() + " started");
+        for (auto &error : configuration->getErrors())
+            juce::Logger::writeToLog("config.yaml: " + error);
 
         // we need to add the app internal plugins to the cache:
         engine.getPluginManager()
             .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+        engine.getPluginManager()
+            .createBuiltInType<internal_plugins::StepSequencerPlugin>();
 
-        auto userAppDataDirectory = juce::File::getSpecialLocation(
-            juce::File::userApplicationDataDirectory);
-        juce::File editFile =
-            userAppDataDirectory.getChildFile(getApplicationName())
-                .getChildFile("edit");
-        if (editFile.existsAsFile()) {
-            edit = tracktion::loadEditFromFile(engine, editFile);
+        editFile = userAppDataDirectory.getChildFile(getApplicationName())
+                       .getChildFile("edit");
+
+        // The rest of the boot runs as a task graph while the splash screen
+        // is up, file system work on worker threads and everything that
+        // touches the edit, devices or components on the message thread
+        using Thread = app_services::BootPipeline::Thread;
+        bootPipeline = std::make_unique<app_services::BootPipeline>();
+
+        bootPipeline->addTask(
+            "syncSamples", Thread::worker, {}, [this] {
+                ConfigurationHelpers::initSamples(engine);
+
+                // the copies are made again on every start, their
+                // thumbnails are kept under the user's files
+                thumbnailCache->addCopiedDirectory(
+                    ConfigurationHelpers::getTempSamplesDirectory(engine),
+                    ConfigurationHelpers::getSamplesDirectory());
+                thumbnailCache->addCopiedDirectory(
+                    ConfigurationHelpers::getTempDrumKitsDirectory(engine),
+                    ConfigurationHelpers::getDrumKitsDirectory());
+            });
+        bootPipeline->addTask(
+            "warmUpSamples", Thread::worker, {"syncSamples"}, [this] {
+                ConfigurationHelpers::warmUpSamples(engine);
+
+                // waveforms are drawn in the background from here on
+                thumbnailCache->generate(
+                    {ConfigurationHelpers::getTempSamplesDirectory(engine),
+                     ConfigurationHelpers::getTempDrumKitsDirectory(engine)});
+                // and the sample browser is indexed before it is opened
+                sampleLibrary->addRoot(
+                    ConfigurationHelpers::getTempSamplesDirectory(engine));
+            });
+        bootPipeline->addTask("scanPlugins", Thread::worker, {}, [this] {
+            app_view_models::PluginTreeGroup::scanForPlugins(engine);
+        });
+        bootPipeline->addTask("parseEdit", Thread::worker, {},
+                              [this] { parseEdit(); });
+
+        bootPipeline->addTask("midiDevices", Thread::message, {},
+                              [this] { initialiseMidiDevices(); });
+        bootPipeline->addTask("audioDevices", Thread::message, {}, [this] {
+            initialiseAudioDevices();
+            audioCallbackMonitor =
+                std::make_unique<app_services::AudioCallbackMonitor>(
+                    engine.getDeviceManager().deviceManager);
+            // held here so every sample browser shares one preview and the
+            // heads it read stay in memory between them
+            samplePreview = app_services::SamplePreview::getFor(
+                engine.getDeviceManager().deviceManager);
+        });
+        // restoring the device setup replaces the enabled MIDI inputs, so
+        // inputs plugged in since the last session are added after it
+        bootPipeline->addTask(
+            "enableMidiInputs", Thread::message,
+            {"audioDevices", "midiDevices"},
+            [this] { midiCommandManager->enableAllMidiInputs(); });
+
+        // samplers in the edit load their sounds from the synced samples and
+        // external plugins are looked up in the scanned plugin list
+        bootPipeline->addTask("loadEdit", Thread::message,
+                              {"parseEdit", "syncSamples", "scanPlugins"},
+                              [this] { loadEdit(); });
+        bootPipeline->addTask("undoHistory", Thread::message,
+                              {"loadEdit", "midiDevices"},
+                              [this] { initialiseUndoHistory(); });
+
+        bootPipeline->addTask(
+            "mainWindow", Thread::message, {"undoHistory", "audioDevices"},
+            [this] {
+                mainWindow = std::make_unique<MainWindow>(
+                    getApplicationName(), engine, *edit, *midiCommandManager,
+                    *audioCallbackMonitor);
+                splash->deleteAfterDelay(juce::RelativeTime::seconds(4.25),
+                                         false);
+            });
+
+        bootPipeline->start([this] {
+            // config changes are applied while the app is running
+            configuration->addListener(this);
+        });
+    }
+
+    void parseEdit() {
+        // runs on a worker, only reads files and builds the state tree
+        if (!editFile.existsAsFile())
+            return;
+
+        // a journal is only left behind when the last session crashed
+        parsedEditState = app_services::EditJournal::readJournal(editFile);
+        editRecovered = parsedEditState.isValid();
+
+        // the binary snapshot, when it matches the XML
+        if (!editRecovered)
+            parsedEditState = app_services::EditCache::read(editFile);
+    }
+
+    void loadEdit() {
+        if (parsedEditState.isValid()) {
+            if (editRecovered)
+                juce::Logger::writeToLog(
+                    "Recovering edit from " +
+                    app_services::EditJournal::getJournalFile(editFile)
+                        .getFullPathName());
+
+            edit = app_services::EditCache::createEdit(engine, parsedEditState,
+                                                       editFile);
+            parsedEditState = {};
+        } else if (editFile.existsAsFile()) {
+            // parses the XML and refreshes the snapshot
+            edit = app_services::EditCache::loadEdit(engine, editFile);
         } else {
             editFile.create();
             edit = tracktion::createEmptyEdit(engine, editFile);
@@ -61,8 +183,6 @@ class GuiAppApplication : public juce::JUCEApplication {
                 track->setColour(appLookAndFeel.getRandomColour());
         }
 
-        ConfigurationHelpers::initSamples(engine);
-
         // The master track does not have the default  plugins added to it by
         // default
         for (auto track : tracktion::getTopLevelTracks(*edit)) {
@@ -80,31 +200,105 @@ class GuiAppApplication : public juce::JUCEApplication {
         edit->clickTrackEnabled.setValue(true, nullptr);
         edit->setCountInMode(tracktion::Edit::CountIn::oneBar);
 
+        // Caps 4OSC voices when the audio callback is running out of headroom
+        voiceGovernor = std::make_unique<app_services::VoiceGovernor>(*edit);
+
+        // Records every change so the edit can be recovered after a crash
+        editJournal =
+            std::make_unique<app_services::EditJournal>(*edit, editFile);
+    }
+
+    void initialiseMidiDevices() {
         midiCommandManager =
             std::make_unique<app_services::MidiCommandManager>(engine);
+        midiCommandManager->setLogMessages(
+            configuration->get().logging.midiMessages);
+        applyControlMapping();
+    }
+
+    void initialiseUndoHistory() {
+        // Coalesces encoder gestures into single undo transactions and keeps
+        // the undo history within the configured memory limit
+        undoHistoryManager = std::make_unique<app_services::UndoHistoryManager>(
+            *edit, *midiCommandManager, configuration->get().undoHistoryLimit);
 
         if (auto uiBehavior =
                 dynamic_cast<ExtendedUIBehaviour *>(&engine.getUIBehaviour())) {
             uiBehavior->setEdit(edit.get());
             uiBehavior->setMidiCommandManager(midiCommandManager.get());
         }
+    }
+
+    void applyControlMapping() {
+        // a control mapping in the config replaces the LMN-3 one entirely
+        auto &controlMappings = configuration->get().controlMappings;
+        if (controlMappings.empty()) {
+            midiCommandManager->resetMapping();
+            return;
+        }
+
+        midiCommandManager->clearMapping();
+        for (auto &mapping : controlMappings)
+            if (!midiCommandManager->mapController(
+                    mapping.command, mapping.controller, mapping.channel))
+                juce::Logger::writeToLog("Ignoring control mapping for " +
+                                         mapping.command);
+    }
+
+    void applyAudioSettings() {
+        auto &audio = configuration->get().audio;
+        if (audio.sampleRate <= 0.0 && audio.bufferSize <= 0)
+            return;
 
-        initialiseAudioDevices();
-        mainWindow = std::make_unique<MainWindow>(getApplicationName(), engine,
-                                                  *edit, *midiCommandManager);
-        splash->deleteAfterDelay(juce::RelativeTime::seconds(4.25), false);
+        auto &deviceManager = engine.getDeviceManager().deviceManager;
+        auto setup = deviceManager.getAudioDeviceSetup();
+        if (audio.sampleRate > 0.0)
+            setup.sampleRate = audio.sampleRate;
+        if (audio.bufferSize > 0)
+            setup.bufferSize = audio.bufferSize;
+
+        auto error = deviceManager.setAudioDeviceSetup(setup, true);
+        if (error.isNotEmpty())
+            juce::Logger::writeToLog("Could not apply the audio config: " +
+                                     error);
+    }
+
+    void
+    configurationChanged(const AppConfiguration::Values &previous) override {
+        auto &config = configuration->get();
+
+        logger->setLevel(app_services::AsyncLogger::getLevelForName(
+            config.logging.level, app_services::AsyncLogger::Level::info));
+        midiCommandManager->setLogMessages(config.logging.midiMessages);
+        applyControlMapping();
+        undoHistoryManager->setMemoryLimit(config.undoHistoryLimit);
+
+        if (config.audio.sampleRate != previous.audio.sampleRate ||
+            config.audio.bufferSize != previous.audio.bufferSize)
+            applyAudioSettings();
     }
 
     void initialiseAudioDevices() {
         auto &deviceManager = engine.getDeviceManager().deviceManager;
-        deviceManager.getCurrentDeviceTypeObject()->scanForDevices();
-        // Enable mono input (1 channel) and stereo output (2 channels)
-        auto result = deviceManager.initialiseWithDefaultDevices(1, 2);
-        if (result != "") {
-            juce::Logger::writeToLog(
-                "Attempt to initialise default devices failed!");
+
+        // The last setup that worked is reopened directly and saved again
+        // whenever it changes. Enable mono input (1 channel) and stereo
+        // output (2 channels).
+        deviceSetupStore = std::make_unique<app_services::DeviceSetupStore>(
+            deviceManager, editFile.getSiblingFile("device_setup.xml"));
+
+        if (!deviceSetupStore->restore(1, 2)) {
+            // first boot or the saved device is gone, scan for the defaults
+            deviceManager.getCurrentDeviceTypeObject()->scanForDevices();
+            auto result = deviceManager.initialiseWithDefaultDevices(1, 2);
+            if (result != "") {
+                juce::Logger::writeToLog(
+                    "Attempt to initialise default devices failed!");
+            }
         }
 
+        applyAudioSettings();
+
         // Enable wave input devices for audio recording
         auto &teDeviceManager = engine.getDeviceManager();
         for (int i = 0; i < teDeviceManager.getNumWaveInDevices(); i++) {
@@ -116,6 +310,21 @@ class GuiAppApplication : public juce::JUCEApplication {
 
     void shutdown() override {
         // Add your application's shutdown code here..
+        configuration->removeListener(this);
+
+        // waits for the worker tasks if the app quits while booting
+        bootPipeline = nullptr;
+
+        // lifts any voice limit so the edit is left as the user set it
+        voiceGovernor = nullptr;
+
+        // a clean shutdown has nothing to recover
+        editJournal = nullptr;
+
+        if (edit == nullptr) {
+            juce::Logger::setCurrentLogger(nullptr);
+            return;
+        }
 
         bool success = edit->engine.getTemporaryFileManager()
                            .getTempDirectory()
@@ -144,31 +353,25 @@ class GuiAppApplication : public juce::JUCEApplication {
         juce::ignoreUnused(commandLine);
     }
 
-    class MainWindow : public juce::DocumentWindow {
+    class MainWindow : public juce::DocumentWindow,
+                       private AppConfiguration::Listener {
       public:
         explicit MainWindow(juce::String name, tracktion::Engine &e,
                             tracktion::Edit &ed,
-                            app_services::MidiCommandManager &mcm)
+                            app_services::MidiCommandManager &mcm,
+                            app_services::AudioCallbackMonitor &acm)
             : DocumentWindow(
                   name,
                   juce::Desktop::getInstance()
                       .getDefaultLookAndFeel()
                       .findColour(ResizableWindow::backgroundColourId),
                   DocumentWindow::allButtons),
-              engine(e), edit(ed), midiCommandManager(mcm) {
-            auto userAppDataDirectory = juce::File::getSpecialLocation(
-                juce::File::userApplicationDataDirectory);
-            auto configFile =
-                userAppDataDirectory.getChildFile(name).getChildFile(
-                    "config.yaml");
-            if (ConfigurationHelpers::getShowTitleBar(configFile))
-                setUsingNativeTitleBar(true);
-            else {
-                setUsingNativeTitleBar(false);
-                setTitleBarHeight(0);
-            }
+              engine(e), edit(ed), midiCommandManager(mcm),
+              audioCallbackMonitor(acm) {
+            applyTitleBar();
 
-            setContentOwned(new App(edit, midiCommandManager), true);
+            setContentOwned(
+                new App(edit, midiCommandManager, audioCallbackMonitor), true);
 
 #if JUCE_IOS || JUCE_ANDROID
             setFullScreen(true);
@@ -184,8 +387,12 @@ class GuiAppApplication : public juce::JUCEApplication {
                 }
             }
             setVisible(true);
+
+            configuration->addListener(this);
         }
 
+        ~MainWindow() override { configuration->removeListener(this); }
+
         void closeButtonPressed() override {
             // This is called when the user tries to close this window. Here,
             // we'll just ask the app to quit when this happens, but you can
@@ -205,20 +412,59 @@ class GuiAppApplication : public juce::JUCEApplication {
         tracktion::Engine &engine;
         tracktion::Edit &edit;
         app_services::MidiCommandManager &midiCommandManager;
+        app_services::AudioCallbackMonitor &audioCallbackMonitor;
+        juce::SharedResourcePointer<AppConfiguration> configuration;
         juce::ValueTree state;
 
+        void applyTitleBar() {
+            if (configuration->get().window.showTitleBar)
+                setUsingNativeTitleBar(true);
+            else {
+                setUsingNativeTitleBar(false);
+                setTitleBarHeight(0);
+            }
+        }
+
+        void configurationChanged(
+            const AppConfiguration::Values &previous) override {
+            auto &window = configuration->get().window;
+            if (window.showTitleBar != previous.window.showTitleBar)
+                applyTitleBar();
+
+            // the window follows the size of its content
+            if (window.width != previous.window.width ||
+                window.height != previous.window.height)
+                if (auto content = getContentComponent())
+                    content->setSize(window.width, window.height);
+        }
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainWindow)
     };
 
   private:
-    std::unique_ptr<juce::FileLogger> logger;
+    juce::SharedResourcePointer<AppConfiguration> configuration;
+    std::unique_ptr<app_services::AsyncLogger> logger;
     std::unique_ptr<MainWindow> mainWindow;
     tracktion::Engine engine{getApplicationName(),
                              std::make_unique<ExtendedUIBehaviour>(), nullptr};
     std::unique_ptr<tracktion::Edit> edit;
+    std::unique_ptr<app_services::EditJournal> editJournal;
+    std::unique_ptr<app_services::VoiceGovernor> voiceGovernor;
     std::unique_ptr<app_services::MidiCommandManager> midiCommandManager;
+    std::unique_ptr<app_services::UndoHistoryManager> undoHistoryManager;
+    std::unique_ptr<app_services::AudioCallbackMonitor> audioCallbackMonitor;
+    std::shared_ptr<app_services::SamplePreview> samplePreview;
+    std::unique_ptr<app_services::DeviceSetupStore> deviceSetupStore;
+    juce::SharedResourcePointer<app_view_models::ThumbnailCache> thumbnailCache;
+    juce::SharedResourcePointer<app_view_models::SampleLibrary> sampleLibrary;
     AppLookAndFeel appLookAndFeel;
     juce::SplashScreen *splash;
+
+    juce::File editFile;
+    // written by the parseEdit task and read by loadEdit, which depends on it
+    juce::ValueTree parsedEditState;
+    bool editRecovered = false;
+    std::unique_ptr<app_services::BootPipeline> bootPipeline;
 };
 
 START_JUCE_APPLICATION(GuiAppApplication)
@@ -0,0 +1,325 @@
+#include "AppConfiguration.h"
+#include <yaml-cpp/yaml.h>
+
+namespace {
+
+template <typename T>
+bool readValue(const YAML::Node &node, const juce::String &path, T &value,
+               juce::StringArray &errors) {
+    try {
+        value = node.as<T>();
+        return true;
+    } catch (const YAML::Exception &) {
+        errors.add(path + " has the wrong type");
+        return false;
+    }
+}
+
+bool readPositive(const YAML::Node &node, const juce::String &path, int &value,
+                  juce::StringArray &errors) {
+    int number = 0;
+    if (!readValue(node, path, number, errors))
+        return false;
+
+    if (number <= 0) {
+        errors.add(path + " has to be more than 0");
+        return false;
+    }
+
+    value = number;
+    return true;
+}
+
+bool isMap(const YAML::Node &node, const juce::String &path,
+           std::initializer_list<const char *> keys,
+           juce::StringArray &errors) {
+    if (!node.IsMap()) {
+        errors.add(path + " should contain settings");
+        return false;
+    }
+
+    for (const auto &entry : node) {
+        auto key = juce::String(entry.first.as<std::string>());
+        if (std::none_of(keys.begin(), keys.end(),
+                         [&](const char *k) { return key == k; }))
+            errors.add("unknown setting " + path + "/" + key);
+    }
+
+    return true;
+}
+
+void readColour(const YAML::Node &node, const juce::String &path,
+                juce::Colour &colour, juce::StringArray &errors) {
+    std::string text;
+    if (!readValue(node, path, text, errors))
+        return;
+
+    // colours are written as hex, with or without the alpha in front, and
+    // may have the # or 0x prefix that Colour::fromString accepted
+    auto hex = juce::String(text).trim();
+    if (hex.startsWith("#"))
+        hex = hex.substring(1);
+    else if (hex.startsWithIgnoreCase("0x"))
+        hex = hex.substring(2);
+
+    if ((hex.length() == 6 || hex.length() == 8) &&
+        hex.containsOnly("0123456789abcdefABCDEF")) {
+        colour = juce::Colour::fromString(hex.length() == 6 ? "ff" + hex : hex);
+        return;
+    }
+
+    errors.add(path + " is not a colour");
+}
+
+void readWindow(const YAML::Node &config, AppConfiguration::Window &window,
+                juce::StringArray &errors) {
+    if (auto node = config["show-title-bar"])
+        readValue(node, "config/show-title-bar", window.showTitleBar, errors);
+
+    if (auto size = config["size"])
+        if (isMap(size, "config/size", {"width", "height"}, errors)) {
+            if (size["width"])
+                readPositive(size["width"], "config/size/width", window.width,
+                             errors);
+            if (size["height"])
+                readPositive(size["height"], "config/size/height",
+                             window.height, errors);
+        }
+}
+
+void readColours(const YAML::Node &config, AppConfiguration::Colours &colours,
+                 juce::StringArray &errors) {
+    auto node = config["colours"];
+    if (!node ||
+        !isMap(node, "config/colours",
+               {"backgroundColour", "textColour", "colour1", "colour2",
+                "colour3", "colour4", "colour5", "colour6", "colour7",
+                "colour8"},
+               errors))
+        return;
+
+    if (node["backgroundColour"])
+        readColour(node["backgroundColour"], "config/colours/backgroundColour",
+                   colours.backgroundColour, errors);
+    if (node["textColour"])
+        readColour(node["textColour"], "config/colours/textColour",
+                   colours.textColour, errors);
+
+    for (size_t i = 0; i < colours.colours.size(); ++i) {
+        auto name = "colour" + juce::String(int(i) + 1);
+        if (auto colour = node[name.toStdString()])
+            readColour(colour, "config/colours/" + name, colours.colours[i],
+                       errors);
+    }
+}
+
+void readAudio(const YAML::Node &config, AppConfiguration::Audio &audio,
+               juce::StringArray &errors) {
+    auto node = config["audio"];
+    if (!node ||
+        !isMap(node, "config/audio", {"sample-rate", "buffer-size"}, errors))
+        return;
+
+    if (node["sample-rate"]) {
+        double sampleRate = 0.0;
+        if (readValue(node["sample-rate"], "config/audio/sample-rate",
+                      sampleRate, errors)) {
+            if (sampleRate > 0.0)
+                audio.sampleRate = sampleRate;
+            else
+                errors.add("config/audio/sample-rate has to be more than 0");
+        }
+    }
+
+    if (node["buffer-size"])
+        readPositive(node["buffer-size"], "config/audio/buffer-size",
+                     audio.bufferSize, errors);
+}
+
+void readLogging(const YAML::Node &config, AppConfiguration::Logging &logging,
+                 juce::StringArray &errors) {
+    auto node = config["logging"];
+    if (!node ||
+        !isMap(node, "config/logging", {"level", "midi-messages"}, errors))
+        return;
+
+    if (node["level"]) {
+        std::string level;
+        if (readValue(node["level"], "config/logging/level", level, errors)) {
+            juce::StringArray levels{"error", "warning", "info", "debug"};
+            if (levels.contains(juce::String(level).trim(), true))
+                logging.level = juce::String(level).trim().toLowerCase();
+            else
+                errors.add("config/logging/level has to be one of " +
+                           levels.joinIntoString(", "));
+        }
+    }
+
+    if (node["midi-messages"])
+        readValue(node["midi-messages"], "config/logging/midi-messages",
+                  logging.midiMessages, errors);
+}
+
+void readControlMappings(
+    const YAML::Node &config,
+    std::vector<AppConfiguration::ControlMapping> &mappings,
+    juce::StringArray &errors) {
+    auto node = config["control-mapping"];
+    if (!node)
+        return;
+
+    if (!node.IsMap()) {
+        errors.add("config/control-mapping should contain settings");
+        return;
+    }
+
+    // each command is either given a controller number, or a map with the
+    // controller and the channel it is sent on
+    for (const auto &entry : node) {
+        AppConfiguration::ControlMapping mapping;
+        mapping.command = entry.first.as<std::string>();
+        auto path = "config/control-mapping/" + mapping.command;
+
+        bool isValid;
+        if (entry.second.IsMap()) {
+            isValid = isMap(entry.second, path, {"controller", "channel"},
+                            errors) &&
+                      entry.second["controller"] &&
+                      readValue(entry.second["controller"],
+                                path + "/controller", mapping.controller,
+                                errors);
+            if (isValid && entry.second["channel"])
+                isValid = readValue(entry.second["channel"], path + "/channel",
+                                    mapping.channel, errors);
+        } else {
+            isValid = readValue(entry.second, path, mapping.controller, errors);
+        }
+
+        if (!isValid)
+            continue;
+
+        if (!juce::isPositiveAndBelow(mapping.controller, 128) ||
+            !juce::isPositiveAndNotGreaterThan(mapping.channel, 16)) {
+            errors.add(path + " has a controller or channel out of range");
+            continue;
+        }
+
+        mappings.push_back(mapping);
+    }
+}
+
+} // namespace
+
+AppConfiguration::AppConfiguration() : AppConfiguration(getDefaultFile()) {}
+
+AppConfiguration::AppConfiguration(const juce::File &f) : file(f) {
+    load();
+    startTimer(checkIntervalMs);
+}
+
+AppConfiguration::~AppConfiguration() { stopTimer(); }
+
+const AppConfiguration::Values &AppConfiguration::get() const {
+    return values;
+}
+
+const juce::StringArray &AppConfiguration::getErrors() const {
+    return errors;
+}
+
+juce::File AppConfiguration::getFile() const { return file; }
+
+bool AppConfiguration::reloadIfChanged() {
+    bool exists = file.existsAsFile();
+    auto modificationTime =
+        exists ? file.getLastModificationTime() : juce::Time();
+    auto size = exists ? file.getSize() : juce::int64(-1);
+    if (modificationTime == lastModificationTime && size == lastSize)
+        return false;
+
+    auto previous = values;
+    load();
+
+    juce::Logger::writeToLog("Reloaded " + file.getFullPathName());
+    for (auto &error : errors)
+        juce::Logger::writeToLog("config.yaml: " + error);
+
+    listeners.call([&](Listener &l) { l.configurationChanged(previous); });
+    return true;
+}
+
+bool AppConfiguration::parse(const juce::String &yaml, Values &values,
+                             juce::StringArray &errors) {
+    YAML::Node root;
+    try {
+        root = YAML::Load(yaml.toStdString());
+    } catch (const YAML::Exception &e) {
+        errors.add("could not be read: " + juce::String(e.what()));
+        return false;
+    }
+
+    values = Values();
+    if (root.IsNull())
+        return true;
+
+    if (!root.IsMap() || !root["config"]) {
+        errors.add("settings have to be under config");
+        return true;
+    }
+
+    auto config = root["config"];
+    if (!isMap(config, "config",
+               {"show-title-bar", "size", "undo-history-kb", "colours", "audio",
+                "logging", "control-mapping"},
+               errors))
+        return true;
+
+    readWindow(config, values.window, errors);
+    readColours(config, values.colours, errors);
+    readAudio(config, values.audio, errors);
+    readLogging(config, values.logging, errors);
+    readControlMappings(config, values.controlMappings, errors);
+
+    int undoHistoryKb = 0;
+    if (config["undo-history-kb"] &&
+        readPositive(config["undo-history-kb"], "config/undo-history-kb",
+                     undoHistoryKb, errors))
+        // the undo manager counts in int, so the byte limit is capped there
+        values.undoHistoryLimit = int(juce::jmin(
+            juce::int64(undoHistoryKb) * 1024,
+            juce::int64(std::numeric_limits<int>::max())));
+
+    return true;
+}
+
+juce::File AppConfiguration::getDefaultFile() {
+    return juce::File::getSpecialLocation(
+               juce::File::userApplicationDataDirectory)
+        .getChildFile(ConfigurationHelpers::ROOT_DIRECTORY_NAME)
+        .getChildFile("config.yaml");
+}
+
+void AppConfiguration::addListener(Listener *l) { listeners.add(l); }
+
+void AppConfiguration::removeListener(Listener *l) { listeners.remove(l); }
+
+void AppConfiguration::load() {
+    bool exists = file.existsAsFile();
+    lastModificationTime =
+        exists ? file.getLastModificationTime() : juce::Time();
+    lastSize = exists ? file.getSize() : juce::int64(-1);
+
+    errors.clear();
+    if (!exists) {
+        values = Values();
+        return;
+    }
+
+    // a file that isn't yaml, for example one that is half written, keeps
+    // the settings that were there before
+    Values newValues;
+    if (parse(file.loadFileAsString(), newValues, errors))
+        values = newValues;
+}
+
+void AppConfiguration::timerCallback() { reloadIfChanged(); }
@@ -0,0 +1,106 @@
+#pragma once
+
+// The settings from config.yaml, parsed once and kept as typed values.
+//
+// The file is read when the configuration is created and then checked for
+// changes once a second. When it changes it is parsed again and listeners are
+// told, so the app can apply the new settings without being restarted. A
+// file that can't be parsed at all is ignored and the previous settings are
+// kept. Values that have the wrong type or are out of range fall back to
+// their defaults, and what was wrong with them is kept in getErrors().
+//
+// The app shares a single instance through a juce::SharedResourcePointer.
+class AppConfiguration : private juce::Timer {
+  public:
+    struct Window {
+        bool showTitleBar = true;
+        int width = 800;
+        int height = 480;
+    };
+
+    struct Colours {
+        juce::Colour backgroundColour{0xff1d2021};
+        juce::Colour textColour{0xfff9f5d7};
+        // colour1 to colour8
+        std::array<juce::Colour, 8> colours{
+            {juce::Colour(0xff458588), juce::Colour(0xff689d6a),
+             juce::Colour(0xfff9f5d7), juce::Colour(0xffcc241d),
+             juce::Colour(0xff98971a), juce::Colour(0xffd65d0e),
+             juce::Colour(0xffb16286), juce::Colour(0xffd79921)}};
+    };
+
+    struct Audio {
+        // 0 leaves the choice to the device
+        double sampleRate = 0.0;
+        int bufferSize = 0;
+    };
+
+    struct Logging {
+        // lowest severity written: error, warning, info or debug
+        juce::String level = "info";
+        bool midiMessages = false;
+    };
+
+    // A controller mapped to a MidiCommandManager command by name. Channel 0
+    // means the controller is mapped on every channel.
+    struct ControlMapping {
+        juce::String command;
+        int controller = -1;
+        int channel = 0;
+    };
+
+    struct Values {
+        Window window;
+        Colours colours;
+        Audio audio;
+        Logging logging;
+        // approximate memory the undo history may use, in bytes
+        int undoHistoryLimit = 1024 * 1024;
+        // empty keeps the built in mapping
+        std::vector<ControlMapping> controlMappings;
+    };
+
+    // Uses config.yaml in the app's directory under the user's config folder
+    AppConfiguration();
+    explicit AppConfiguration(const juce::File &file);
+    ~AppConfiguration() override;
+
+    const Values &get() const;
+    const juce::StringArray &getErrors() const;
+    juce::File getFile() const;
+
+    // Reads the file again if it changed since it was last read, returns true
+    // if it was reloaded. The timer calls this, it is public so a reload can
+    // be forced.
+    bool reloadIfChanged();
+
+    // Parses config yaml, falling back to the defaults for anything missing
+    // or invalid. Returns false if the text isn't yaml at all.
+    static bool parse(const juce::String &yaml, Values &values,
+                      juce::StringArray &errors);
+
+    static juce::File getDefaultFile();
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void configurationChanged(const Values &previous) = 0;
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    juce::File file;
+    Values values;
+    juce::StringArray errors;
+    juce::Time lastModificationTime;
+    juce::int64 lastSize = -1;
+    juce::ListenerList<Listener> listeners;
+
+    static constexpr int checkIntervalMs = 1000;
+
+    void load();
+    void timerCallback() override;
+};
@@ -1,5 +1,4 @@
 #include "ConfigurationHelpers.h"
-#include <yaml-cpp/yaml.h>
 
 bool ConfigurationHelpers::writeBinarySamplesToDirectory(
     const juce::File &destDir, juce::StringRef filename, const char *data,
@@ -111,54 +110,21 @@ void ConfigurationHelpers::initSamples(tracktion::Engine &engine) {
                     tempDrumKitsDir);
 }
 
-bool ConfigurationHelpers::getShowTitleBar(juce::File &configFile) {
-    if (configFile.exists()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-        YAML::Node config = rootNode["config"];
-        if (config)
-            if (config["show-title-bar"])
-                return config["show-title-bar"].as<bool>();
-    }
-
-    // Default to showing the title bar
-    return true;
-}
-
-double ConfigurationHelpers::getWidth(juce::File &configFile) {
-    if (configFile.exists()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-        YAML::Node config = rootNode["config"];
-        if (config) {
-            if (config["size"]) {
-                auto sizeConfig = config["size"];
-                if (sizeConfig["width"])
-                    return sizeConfig["width"].as<double>();
-            }
+void ConfigurationHelpers::warmUpSamples(tracktion::Engine &engine) {
+    auto wildcard = engine.getAudioFileFormatManager()
+                        .readFormatManager.getWildcardForAllFormats();
+
+    int numFiles = 0;
+    for (auto &dir :
+         {getTempSamplesDirectory(engine), getTempDrumKitsDirectory(engine)})
+        for (auto entry : juce::RangedDirectoryIterator(
+                 dir, true, wildcard, juce::File::findFiles)) {
+            tracktion::AudioFile(engine, entry.getFile()).getInfo();
+            numFiles++;
         }
-    }
 
-    // Default to 800
-    return 800;
-}
-
-double ConfigurationHelpers::getHeight(juce::File &configFile) {
-    if (configFile.exists()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-        YAML::Node config = rootNode["config"];
-        if (config) {
-            if (config["size"]) {
-                auto sizeConfig = config["size"];
-                if (sizeConfig["height"])
-                    return sizeConfig["height"].as<double>();
-            }
-        }
-    }
-
-    // Default to 480
-    return 480;
+    juce::Logger::writeToLog("Read the info of " + juce::String(numFiles) +
+                             " samples");
 }
 
 juce::File ConfigurationHelpers::getSamplesDirectory() {
@@ -179,6 +145,13 @@ juce::File ConfigurationHelpers::getRecordedSamplesDirectory() {
     return getSamplesDirectory().getChildFile(RECORDED_SAMPLES_DIRECTORY_NAME);
 }
 
+juce::File ConfigurationHelpers::getThumbnailsDirectory() {
+    auto userAppDataDirectory = juce::File::getSpecialLocation(
+        juce::File::userApplicationDataDirectory);
+    return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
+        .getChildFile(THUMBNAILS_DIRECTORY_NAME);
+}
+
 juce::File
 ConfigurationHelpers::getTempSamplesDirectory(tracktion::Engine &engine) {
     return engine.getTemporaryFileManager().getTempFile(SAMPLES_DIRECTORY_NAME);
@@ -9,17 +9,20 @@ class ConfigurationHelpers {
     static inline const juce::String DRUM_KITS_DIRECTORY_NAME = "drum_kits";
     static inline const juce::String RECORDED_SAMPLES_DIRECTORY_NAME =
         "recorded_samples";
+    static inline const juce::String THUMBNAILS_DIRECTORY_NAME = "thumbnails";
     static juce::File getSamplesDirectory();
     static juce::File getDrumKitsDirectory();
     static juce::File getRecordedSamplesDirectory();
+    static juce::File getThumbnailsDirectory();
     static juce::File getTempSamplesDirectory(tracktion::Engine &engine);
     static juce::File
     getTempRecordedSamplesDirectory(tracktion::Engine &engine);
     static juce::File getTempDrumKitsDirectory(tracktion::Engine &engine);
     static void initSamples(tracktion::Engine &engine);
-    static bool getShowTitleBar(juce::File &configFile);
-    static double getWidth(juce::File &configFile);
-    static double getHeight(juce::File &configFile);
+    // Reads the audio file info of every synced sample and drum kit sound
+    // into the engine's cache so the samplers don't have to open the files
+    // when they are first shown. Safe to call from a background thread.
+    static void warmUpSamples(tracktion::Engine &engine);
 
   private:
     static bool writeBinarySamplesToDirectory(const juce::File &destDir,
@@ -2,4 +2,5 @@
 #include "app_configuration.h"
 
 // Sequences
-#include "ConfigurationHelpers.cpp"
\ No newline at end of file
+#include "ConfigurationHelpers.cpp"
+#include "AppConfiguration.cpp"
\ No newline at end of file
@@ -9,18 +9,26 @@
   description:      Configuration helpers
   website:          http://github.com/stonepreston
   license:          GPL-3.0
-  dependencies:     tracktion_engine juce_core
+  dependencies:     tracktion_engine juce_core juce_events juce_graphics
  END_JUCE_MODULE_DECLARATION
 *******************************************************************************/
 #pragma once
 
 namespace app_configuration {
     class ConfigurationHelpers;
+    class AppConfiguration;
 }
 
 #include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <juce_graphics/juce_graphics.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
 
 #include "ConfigurationHelpers.h"
+#include "AppConfiguration.h"
 
 
@@ -0,0 +1,56 @@
+#include "AudioCallbackMonitor.h"
+
+namespace app_services {
+
+AudioCallbackMonitor::AudioCallbackMonitor(juce::AudioDeviceManager &dm)
+    : deviceManager(dm), lastDeviceXruns(dm.getXRunCount()) {
+    startTimer(timerIntervalMs);
+}
+
+AudioCallbackMonitor::~AudioCallbackMonitor() { stopTimer(); }
+
+AudioCallbackMonitor::Snapshot AudioCallbackMonitor::getSnapshot() const {
+    Snapshot snapshot;
+    snapshot.load = load;
+    snapshot.peakLoad = peakLoad;
+    snapshot.xruns = xruns;
+    snapshot.bufferSize = bufferSize;
+    snapshot.sampleRate = sampleRate;
+    return snapshot;
+}
+
+void AudioCallbackMonitor::update() {
+    load = deviceManager.getCpuUsage();
+    peakLoad = juce::jmax(peakLoad, load);
+
+    // the count starts from zero again whenever the device restarts
+    auto deviceXruns = deviceManager.getXRunCount();
+    xruns += deviceXruns >= lastDeviceXruns ? deviceXruns - lastDeviceXruns
+                                            : deviceXruns;
+    lastDeviceXruns = deviceXruns;
+
+    if (auto device = deviceManager.getCurrentAudioDevice()) {
+        bufferSize = device->getCurrentBufferSizeSamples();
+        sampleRate = device->getCurrentSampleRate();
+    }
+}
+
+void AudioCallbackMonitor::timerCallback() {
+    update();
+
+    if (++ticksSinceSummary >= ticksPerSummary) {
+        logSummary();
+        ticksSinceSummary = 0;
+        peakLoad = load;
+    }
+}
+
+void AudioCallbackMonitor::logSummary() {
+    juce::Logger::writeToLog(
+        "DSP load " + juce::String(load * 100.0, 1) + "% (peak " +
+        juce::String(peakLoad * 100.0, 1) + "%), " + juce::String(xruns) +
+        " xruns with buffers of " + juce::String(bufferSize) +
+        " samples at " + juce::String(sampleRate) + "Hz");
+}
+
+} // namespace app_services
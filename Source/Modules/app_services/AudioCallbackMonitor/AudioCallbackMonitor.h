@@ -0,0 +1,51 @@
+#pragma once
+
+namespace app_services {
+
+// Collects real time health statistics for the audio device.
+//
+// The engine's audio callback cannot be timed from outside, so the monitor
+// relies on what the device manager measures itself: the load is how much
+// of each buffer the callbacks take, averaged by the device manager, and the
+// xruns are the ones the device and the device manager's load measurer
+// report. Both are read on the message thread, the monitor tracks the
+// average and peak load and writes a summary to the log every minute.
+class AudioCallbackMonitor : private juce::Timer {
+  public:
+    explicit AudioCallbackMonitor(juce::AudioDeviceManager &dm);
+    ~AudioCallbackMonitor() override;
+
+    struct Snapshot {
+        double load = 0.0;
+        double peakLoad = 0.0;
+        int xruns = 0;
+        int bufferSize = 0;
+        double sampleRate = 0.0;
+    };
+
+    // Xruns are the total since the monitor was created, the peak load
+    // covers the time since the last log summary
+    Snapshot getSnapshot() const;
+
+    // Reads the device manager's load and xruns, called from the timer
+    void update();
+
+  private:
+    juce::AudioDeviceManager &deviceManager;
+
+    double load = 0.0;
+    double peakLoad = 0.0;
+    int xruns = 0;
+    int lastDeviceXruns = 0;
+    int bufferSize = 0;
+    double sampleRate = 0.0;
+    int ticksSinceSummary = 0;
+
+    static constexpr int timerIntervalMs = 250;
+    static constexpr int ticksPerSummary = 240;
+
+    void timerCallback() override;
+    void logSummary();
+};
+
+} // namespace app_services
@@ -0,0 +1,177 @@
+#include "BootPipeline.h"
+
+namespace app_services {
+
+BootPipeline::BootPipeline(int numWorkerThreads)
+    : pool(juce::jmax(1, numWorkerThreads)) {}
+
+BootPipeline::~BootPipeline() {
+    {
+        const juce::ScopedLock sl(lock);
+        // nothing new is scheduled once the pipeline is going away
+        started = false;
+    }
+
+    pool.removeAllJobs(true, 10000);
+}
+
+void BootPipeline::addTask(const juce::String &name, Thread thread,
+                           const juce::StringArray &dependencies,
+                           std::function<void()> work) {
+    jassert(!started);
+    jassert(findTask(name) < 0);
+
+    Task task;
+    task.name = name;
+    task.thread = thread;
+    task.dependencies = dependencies;
+    task.work = std::move(work);
+    tasks.push_back(std::move(task));
+}
+
+void BootPipeline::start(std::function<void()> onFinished) {
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(!started);
+
+    finishedCallback = std::move(onFinished);
+    // the weak reference is created here because worker threads copy it
+    weakThis = this;
+    startTimeMs = juce::Time::getMillisecondCounterHiRes();
+
+    std::vector<size_t> ready;
+    {
+        const juce::ScopedLock sl(lock);
+        started = true;
+
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            for (auto &dependency : tasks[i].dependencies) {
+                auto index = findTask(dependency);
+                if (index < 0) {
+                    // a typo here would otherwise hang the boot
+                    jassertfalse;
+                    juce::Logger::writeToLog("Boot task " + tasks[i].name +
+                                             " depends on unknown task " +
+                                             dependency);
+                    continue;
+                }
+
+                tasks[size_t(index)].dependents.push_back(i);
+                tasks[i].numPendingDependencies++;
+            }
+        }
+
+        for (size_t i = 0; i < tasks.size(); ++i)
+            if (tasks[i].numPendingDependencies == 0)
+                ready.push_back(i);
+    }
+
+    // a graph with tasks but nothing to start from has a cycle
+    jassert(tasks.empty() || !ready.empty());
+
+    if (tasks.empty() && finishedCallback != nullptr)
+        finishedCallback();
+
+    for (auto index : ready)
+        schedule(index);
+}
+
+bool BootPipeline::isFinished() const {
+    const juce::ScopedLock sl(lock);
+    return numFinished == tasks.size();
+}
+
+bool BootPipeline::isTaskFinished(const juce::String &name) const {
+    return getTaskDurationMs(name) >= 0.0;
+}
+
+double BootPipeline::getTaskDurationMs(const juce::String &name) const {
+    const juce::ScopedLock sl(lock);
+    auto index = findTask(name);
+    return index < 0 ? -1.0 : tasks[size_t(index)].durationMs;
+}
+
+int BootPipeline::defaultNumWorkerThreads() {
+    // the message thread has its own share of the work
+    return juce::jmax(1, juce::SystemStats::getNumCpus() - 1);
+}
+
+void BootPipeline::schedule(size_t index) {
+    {
+        const juce::ScopedLock sl(lock);
+        if (!started)
+            return;
+    }
+
+    if (tasks[index].thread == Thread::worker) {
+        pool.addJob([this, index] { run(index); });
+        return;
+    }
+
+    juce::MessageManager::callAsync([pipeline = weakThis, index] {
+        if (pipeline != nullptr)
+            pipeline->run(index);
+    });
+}
+
+void BootPipeline::run(size_t index) {
+    auto taskStartMs = juce::Time::getMillisecondCounterHiRes();
+    if (tasks[index].work != nullptr)
+        tasks[index].work();
+
+    taskFinished(index, juce::Time::getMillisecondCounterHiRes() - taskStartMs);
+}
+
+void BootPipeline::taskFinished(size_t index, double durationMs) {
+    std::vector<size_t> ready;
+    bool allFinished;
+    {
+        const juce::ScopedLock sl(lock);
+        tasks[index].durationMs = durationMs;
+        numFinished++;
+
+        for (auto dependent : tasks[index].dependents)
+            if (--tasks[dependent].numPendingDependencies == 0)
+                ready.push_back(dependent);
+
+        allFinished = numFinished == tasks.size();
+    }
+
+    AsyncLogger::log(AsyncLogger::Level::debug,
+                     "Boot task " + tasks[index].name + " took " +
+                         juce::String(durationMs, 1) + "ms");
+
+    for (auto dependent : ready)
+        schedule(dependent);
+
+    if (!allFinished)
+        return;
+
+    juce::Logger::writeToLog(
+        "Boot finished in " +
+        juce::String(juce::Time::getMillisecondCounterHiRes() - startTimeMs,
+                     1) +
+        "ms");
+
+    if (finishedCallback == nullptr)
+        return;
+
+    if (juce::MessageManager::getInstance()->isThisTheMessageThread()) {
+        finishedCallback();
+        return;
+    }
+
+    juce::MessageManager::callAsync([pipeline = weakThis] {
+        if (pipeline != nullptr)
+            pipeline->finishedCallback();
+    });
+}
+
+int BootPipeline::findTask(const juce::String &name) const {
+    for (size_t i = 0; i < tasks.size(); ++i)
+        if (tasks[i].name == name)
+            return int(i);
+
+    return -1;
+}
+
+} // namespace app_services
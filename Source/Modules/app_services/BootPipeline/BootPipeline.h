@@ -0,0 +1,75 @@
+#pragma once
+
+namespace app_services {
+
+// Runs the app's startup work as a graph of named tasks.
+//
+// Each task lists the tasks it depends on and starts as soon as all of them
+// have finished. Worker tasks run concurrently on a thread pool, message
+// thread tasks are posted to the message loop, so file system work like
+// syncing samples or parsing the edit overlaps with device setup instead of
+// queueing behind it. Tasks that touch the edit, the devices or components
+// have to be message thread tasks.
+//
+// The graph is fixed once start is called. Every task's duration is logged
+// at debug level and the whole boot at info level, and the finished callback
+// is called on the message thread after the last task.
+class BootPipeline {
+  public:
+    enum class Thread { worker, message };
+
+    explicit BootPipeline(int numWorkerThreads = defaultNumWorkerThreads());
+    ~BootPipeline();
+
+    // Adds a task, the dependencies have to be added before start is called
+    // but may be added after this task
+    void addTask(const juce::String &name, Thread thread,
+                 const juce::StringArray &dependencies,
+                 std::function<void()> work);
+
+    // Starts every task without dependencies. Must be called on the message
+    // thread and only once.
+    void start(std::function<void()> onFinished = nullptr);
+
+    bool isFinished() const;
+    bool isTaskFinished(const juce::String &name) const;
+
+    // How long a task took to run, or -1 if it has not finished yet
+    double getTaskDurationMs(const juce::String &name) const;
+
+    static int defaultNumWorkerThreads();
+
+  private:
+    struct Task {
+        juce::String name;
+        Thread thread;
+        juce::StringArray dependencies;
+        std::function<void()> work;
+
+        std::vector<size_t> dependents;
+        int numPendingDependencies = 0;
+        double durationMs = -1.0;
+    };
+
+    // tasks only change structure before start, after that the scheduling
+    // state in them is guarded by the lock
+    std::vector<Task> tasks;
+    mutable juce::CriticalSection lock;
+    size_t numFinished = 0;
+    bool started = false;
+
+    juce::ThreadPool pool;
+    std::function<void()> finishedCallback;
+    double startTimeMs = 0.0;
+    juce::WeakReference<BootPipeline> weakThis;
+
+    void schedule(size_t index);
+    void run(size_t index);
+    void taskFinished(size_t index, double durationMs);
+    int findTask(const juce::String &name) const;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(BootPipeline)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BootPipeline)
+};
+
+} // namespace app_services
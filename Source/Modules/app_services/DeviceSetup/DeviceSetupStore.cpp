@@ -0,0 +1,95 @@
+#include "DeviceSetupStore.h"
+
+namespace app_services {
+
+static const juce::String deviceSetupTag("DEVICESETUP");
+
+DeviceSetupStore::DeviceSetupStore(juce::AudioDeviceManager &dm,
+                                   const juce::File &f)
+    : deviceManager(dm), file(f) {
+    deviceManager.addChangeListener(this);
+}
+
+DeviceSetupStore::~DeviceSetupStore() {
+    deviceManager.removeChangeListener(this);
+}
+
+bool DeviceSetupStore::restore(int numInputChannels, int numOutputChannels) {
+    auto xml = juce::parseXMLIfTagMatches(file, deviceSetupTag);
+    if (xml == nullptr)
+        return false;
+
+    // no fallback to the default devices here, that is the caller's call
+    auto error = deviceManager.initialise(numInputChannels, numOutputChannels,
+                                          xml.get(), false);
+    if (error.isNotEmpty() ||
+        deviceManager.getCurrentAudioDevice() == nullptr) {
+        juce::Logger::writeToLog("Could not restore the saved device setup: " +
+                                 error);
+        return false;
+    }
+
+    savedSetup = xml->toString();
+    juce::Logger::writeToLog(
+        "Restored device setup " +
+        deviceManager.getCurrentAudioDevice()->getName() + " at " +
+        juce::String(deviceManager.getAudioDeviceSetup().sampleRate) + "Hz");
+    return true;
+}
+
+bool DeviceSetupStore::save() {
+    auto xml = createSetupXml();
+    if (xml == nullptr)
+        return false;
+
+    auto setup = xml->toString();
+    if (setup == savedSetup)
+        return false;
+
+    file.getParentDirectory().createDirectory();
+    if (!xml->writeTo(file)) {
+        juce::Logger::writeToLog("Could not write the device setup to " +
+                                 file.getFullPathName());
+        return false;
+    }
+
+    savedSetup = setup;
+    return true;
+}
+
+std::unique_ptr<juce::XmlElement> DeviceSetupStore::createSetupXml() const {
+    auto device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+        return nullptr;
+
+    // the device manager only keeps state once a setup has been chosen
+    // explicitly, a default setup is written out the same way here
+    if (auto xml = deviceManager.createStateXml())
+        return xml;
+
+    auto setup = deviceManager.getAudioDeviceSetup();
+    auto xml = std::make_unique<juce::XmlElement>(deviceSetupTag);
+    xml->setAttribute("deviceType", deviceManager.getCurrentAudioDeviceType());
+    xml->setAttribute("audioOutputDeviceName", setup.outputDeviceName);
+    xml->setAttribute("audioInputDeviceName", setup.inputDeviceName);
+    xml->setAttribute("audioDeviceRate", device->getCurrentSampleRate());
+    xml->setAttribute("audioDeviceBufferSize",
+                      device->getCurrentBufferSizeSamples());
+
+    if (!setup.useDefaultInputChannels)
+        xml->setAttribute("audioDeviceInChans",
+                          setup.inputChannels.toString(2));
+    if (!setup.useDefaultOutputChannels)
+        xml->setAttribute("audioDeviceOutChans",
+                          setup.outputChannels.toString(2));
+
+    return xml;
+}
+
+const juce::File &DeviceSetupStore::getFile() const { return file; }
+
+void DeviceSetupStore::changeListenerCallback(juce::ChangeBroadcaster *) {
+    save();
+}
+
+} // namespace app_services
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace app_services {
+
+// Remembers the last audio and MIDI device setup that worked and reopens it
+// directly on the next boot.
+//
+// The setup is kept as the device manager's own state XML: device type,
+// devices, sample rate, buffer size, channels and enabled MIDI inputs. It is
+// written whenever the device manager changes while a device is open, so
+// choices made in the settings views survive a restart. Restoring opens
+// exactly that setup instead of trying the default devices one after another.
+// The device manager still scans the saved device type's devices while it
+// initialises, since it needs their names to open one. Failure is only
+// reported when the saved device can't be opened, in which case the caller
+// falls back to the defaults.
+class DeviceSetupStore : private juce::ChangeListener {
+  public:
+    DeviceSetupStore(juce::AudioDeviceManager &dm, const juce::File &f);
+    ~DeviceSetupStore() override;
+
+    // Opens the saved setup. Returns false if nothing was saved or the saved
+    // audio device could not be opened.
+    bool restore(int numInputChannels, int numOutputChannels);
+
+    // Writes the current setup if a device is open and the setup differs
+    // from what was saved last
+    bool save();
+
+    // The state of the open device in the format the device manager restores
+    // from, or nullptr if no device is open
+    std::unique_ptr<juce::XmlElement> createSetupXml() const;
+
+    const juce::File &getFile() const;
+
+  private:
+    juce::AudioDeviceManager &deviceManager;
+    juce::File file;
+    juce::String savedSetup;
+
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
+};
+
+} // namespace app_services
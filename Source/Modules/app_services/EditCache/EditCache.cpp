@@ -0,0 +1,146 @@
+#include "EditCache.h"
+
+namespace app_services {
+
+juce::File EditCache::getCacheFile(const juce::File &editFile) {
+    return editFile.getSiblingFile(editFile.getFileName() + ".cache");
+}
+
+std::unique_ptr<tracktion::Edit>
+EditCache::loadEdit(tracktion::Engine &engine, const juce::File &editFile) {
+    auto state = read(editFile);
+    if (!state.isValid()) {
+        juce::Logger::writeToLog("Edit cache is missing or stale, loading " +
+                                 editFile.getFullPathName());
+        auto edit = tracktion::loadEditFromFile(engine, editFile);
+        if (edit != nullptr)
+            write(editFile, edit->state);
+
+        return edit;
+    }
+
+    return createEdit(engine, state, editFile);
+}
+
+std::unique_ptr<tracktion::Edit>
+EditCache::createEdit(tracktion::Engine &engine, const juce::ValueTree &state,
+                      const juce::File &editFile) {
+    auto id = tracktion::ProjectItemID::fromProperty(state,
+                                                     tracktion::IDs::projectID);
+    if (!id.isValid())
+        id = tracktion::ProjectItemID::createNewID(0);
+
+    tracktion::Edit::Options options = {engine, state, id};
+    options.editFileRetriever = [editFile] { return editFile; };
+    options.filePathResolver = [editFile](const juce::String &path) {
+        if (juce::File::isAbsolutePath(path))
+            return juce::File(path);
+
+        return editFile.getSiblingFile(path);
+    };
+
+    return tracktion::Edit::createEdit(options);
+}
+
+bool EditCache::saveEdit(tracktion::Edit &edit) {
+    // the file and the snapshot get the voices the user asked for, not the
+    // ones the voice governor is letting the synths play
+    VoiceGovernor::ScopedRequestedValues requestedValues(edit);
+
+    tracktion::EditFileOperations fileOperations(edit);
+    if (!fileOperations.save(true, true, false))
+        return false;
+
+    // save flushes the plugin and clip state into the tree before writing
+    // it, so the tree now matches the XML on disk
+    write(fileOperations.getEditFile(), edit.state);
+    return true;
+}
+
+bool EditCache::write(const juce::File &editFile, const juce::ValueTree &state,
+                      bool compress) {
+    juce::MemoryBlock payload;
+    {
+        juce::MemoryOutputStream payloadStream(payload, false);
+        if (compress) {
+            juce::GZIPCompressorOutputStream zipStream(payloadStream);
+            state.writeToStream(zipStream);
+        } else {
+            state.writeToStream(payloadStream);
+        }
+    }
+
+    juce::TemporaryFile tempFile(getCacheFile(editFile));
+    {
+        juce::FileOutputStream out(tempFile.getFile());
+        if (!out.openedOk())
+            return false;
+
+        out.writeInt(magic);
+        out.writeInt(formatVersion);
+        out.writeInt64(editFile.getSize());
+        out.write(juce::MD5(editFile).getRawChecksumData().getData(), 16);
+        out.writeBool(compress);
+        out.writeInt64((juce::int64)payload.getSize());
+        out.write(juce::MD5(payload).getRawChecksumData().getData(), 16);
+        out.write(payload.getData(), payload.getSize());
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+juce::ValueTree EditCache::read(const juce::File &editFile) {
+    auto cacheFile = getCacheFile(editFile);
+    if (!cacheFile.existsAsFile() || !editFile.existsAsFile())
+        return {};
+
+    juce::MemoryBlock data;
+    if (!cacheFile.loadFileAsData(data))
+        return {};
+
+    juce::MemoryInputStream in(data, false);
+    if (in.readInt() != magic || in.readInt() != formatVersion)
+        return {};
+
+    // comparing sizes first skips hashing the XML in the common stale case
+    if (in.readInt64() != editFile.getSize())
+        return {};
+
+    juce::MemoryBlock xmlChecksum(16);
+    if (in.read(xmlChecksum.getData(), 16) != 16 ||
+        xmlChecksum != juce::MD5(editFile).getRawChecksumData())
+        return {};
+
+    bool compressed = in.readBool();
+    auto payloadSize = in.readInt64();
+    juce::MemoryBlock payloadChecksum(16);
+    if (in.read(payloadChecksum.getData(), 16) != 16 || payloadSize < 0 ||
+        payloadSize != in.getNumBytesRemaining())
+        return {};
+
+    auto payload = static_cast<const char *>(data.getData()) + in.getPosition();
+    if (payloadChecksum !=
+        juce::MD5(payload, (size_t)payloadSize).getRawChecksumData())
+        return {};
+
+    juce::ValueTree state;
+    if (compressed) {
+        juce::MemoryInputStream payloadStream(payload, (size_t)payloadSize,
+                                              false);
+        juce::GZIPDecompressorInputStream zipStream(payloadStream);
+        state = juce::ValueTree::readFromStream(zipStream);
+    } else {
+        state = juce::ValueTree::readFromData(payload, (size_t)payloadSize);
+    }
+
+    if (!state.hasType(tracktion::IDs::EDIT))
+        return {};
+
+    return state;
+}
+
+} // namespace app_services
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace app_services {
+
+// Keeps a binary snapshot of the edit state next to the XML edit file so the
+// edit can be loaded without parsing XML on every boot.
+//
+// The snapshot header records the size and MD5 of the XML file it was made
+// from and the MD5 of its own payload. A snapshot is only used while the XML
+// file still has that content and the payload is intact, anything else falls
+// back to loading the XML, so the XML file stays the one source of truth.
+class EditCache {
+  public:
+    // The snapshot lives beside the edit file with a .cache extension
+    static juce::File getCacheFile(const juce::File &editFile);
+
+    // Loads the edit from its snapshot when the snapshot is current, otherwise
+    // from the XML, refreshing the snapshot for the next boot
+    static std::unique_ptr<tracktion::Edit>
+    loadEdit(tracktion::Engine &engine, const juce::File &editFile);
+
+    // Creates an edit for state that saves to editFile, as loadEditFromFile
+    // does once it has parsed the XML
+    static std::unique_ptr<tracktion::Edit>
+    createEdit(tracktion::Engine &engine, const juce::ValueTree &state,
+               const juce::File &editFile);
+
+    // Saves the edit XML and writes a matching snapshot, use this instead of
+    // EditFileOperations::save so the snapshot never goes stale
+    static bool saveEdit(tracktion::Edit &edit);
+
+    // Writes a snapshot of state for the current content of the edit file.
+    // Compression makes the snapshot smaller but costs time on both ends.
+    static bool write(const juce::File &editFile, const juce::ValueTree &state,
+                      bool compress = false);
+
+    // Returns the snapshot state, or an invalid tree if there is no snapshot
+    // or it is stale or corrupt
+    static juce::ValueTree read(const juce::File &editFile);
+
+  private:
+    static constexpr int magic = 0x434e4d4c; // "LMNC"
+    static constexpr int formatVersion = 1;
+};
+
+} // namespace app_services
@@ -0,0 +1,202 @@
+#include "EditJournal.h"
+
+namespace app_services {
+
+// each record is its size, a checksum, a kind byte and then the change as
+// encoded by ValueTreeSynchroniser, the size and checksum cover the kind byte
+enum class JournalRecordKind : char { checkpoint = 'C', change = 'D' };
+
+static juce::uint32 getJournalChecksum(const void *data, size_t size) {
+    // FNV-1a, only torn or garbled records need to be caught
+    juce::uint32 hash = 2166136261u;
+    auto bytes = static_cast<const juce::uint8 *>(data);
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ bytes[i]) * 16777619u;
+
+    return hash;
+}
+
+static int &getNumUnrecordedScopes() {
+    static int numScopes = 0;
+    return numScopes;
+}
+
+EditJournal::ScopedUnrecordedChanges::ScopedUnrecordedChanges() {
+    JUCE_ASSERT_MESSAGE_THREAD
+    getNumUnrecordedScopes()++;
+}
+
+EditJournal::ScopedUnrecordedChanges::~ScopedUnrecordedChanges() {
+    getNumUnrecordedScopes()--;
+}
+
+EditJournal::EditJournal(tracktion::Edit &e, const juce::File &editFile)
+    : juce::ValueTreeSynchroniser(e.state), juce::Thread("Edit Journal"),
+      edit(e), journalFile(getJournalFile(editFile)) {
+    compact();
+    writePending();
+    startThread();
+}
+
+EditJournal::~EditJournal() {
+    stopThread(2000);
+
+    const juce::ScopedLock sl(writeLock);
+    stream = nullptr;
+    journalFile.deleteFile();
+}
+
+juce::File EditJournal::getJournalFile(const juce::File &editFile) {
+    return editFile.getSiblingFile(editFile.getFileName() + ".journal");
+}
+
+juce::ValueTree EditJournal::readJournal(const juce::File &editFile) {
+    juce::MemoryBlock data;
+    if (!getJournalFile(editFile).loadFileAsData(data))
+        return {};
+
+    juce::ValueTree state(tracktion::IDs::EDIT);
+    juce::MemoryInputStream in(data, false);
+    bool hasCheckpoint = false;
+
+    while (in.getNumBytesRemaining() >= 8) {
+        auto size = in.readInt();
+        auto checksum = juce::uint32(in.readInt());
+        if (size < 1 || size > in.getNumBytesRemaining())
+            break;
+
+        auto record = static_cast<const char *>(data.getData()) +
+                      in.getPosition();
+        if (getJournalChecksum(record, size_t(size)) != checksum)
+            break;
+
+        auto kind = JournalRecordKind(record[0]);
+        if (kind == JournalRecordKind::checkpoint)
+            hasCheckpoint = true;
+
+        if (hasCheckpoint)
+            juce::ValueTreeSynchroniser::applyChange(
+                state, record + 1, size_t(size - 1), nullptr);
+
+        in.skipNextBytes(size);
+    }
+
+    if (!hasCheckpoint)
+        return {};
+
+    return state;
+}
+
+std::unique_ptr<tracktion::Edit>
+EditJournal::recoverEdit(tracktion::Engine &engine,
+                         const juce::File &editFile) {
+    auto state = readJournal(editFile);
+    if (!state.isValid())
+        return nullptr;
+
+    juce::Logger::writeToLog("Recovering edit from " +
+                             getJournalFile(editFile).getFullPathName());
+    return EditCache::createEdit(engine, state, editFile);
+}
+
+void EditJournal::compact() {
+    // the checkpoint is recovered as it is, so it must not have the limits
+    // the voice governor applies
+    VoiceGovernor::ScopedRequestedValues requestedValues(edit);
+
+    writingCheckpoint = true;
+    sendFullSyncCallback();
+    writingCheckpoint = false;
+}
+
+void EditJournal::flush() { writePending(); }
+
+juce::int64 EditJournal::getBytesSinceCheckpoint() const {
+    return bytesSinceCheckpoint;
+}
+
+void EditJournal::stateChanged(const void *encodedChange,
+                               size_t encodedChangeSize) {
+    if (!writingCheckpoint && getNumUnrecordedScopes() > 0)
+        return;
+
+    auto kind = writingCheckpoint ? JournalRecordKind::checkpoint
+                                  : JournalRecordKind::change;
+
+    juce::MemoryBlock record(encodedChangeSize + 1);
+    record[0] = char(kind);
+    record.copyFrom(encodedChange, 1, encodedChangeSize);
+
+    {
+        const juce::ScopedLock sl(pendingLock);
+
+        // the checkpoint replaces everything that has not been written yet
+        if (writingCheckpoint) {
+            pending.reset();
+            startNewFile = true;
+        }
+
+        juce::MemoryOutputStream out(pending, true);
+        out.writeInt(int(record.getSize()));
+        out.writeInt(int(getJournalChecksum(record.getData(),
+                                            record.getSize())));
+        out.write(record.getData(), record.getSize());
+    }
+
+    if (writingCheckpoint) {
+        checkpointSize = juce::int64(record.getSize());
+        bytesSinceCheckpoint = 0;
+        return;
+    }
+
+    bytesSinceCheckpoint += juce::int64(record.getSize());
+    if (bytesSinceCheckpoint > juce::jmax(minCompactionBytes,
+                                          checkpointSize * 2))
+        compact();
+}
+
+void EditJournal::run() {
+    while (!threadShouldExit()) {
+        wait(flushIntervalMs);
+        writePending();
+    }
+
+    writePending();
+}
+
+void EditJournal::writePending() {
+    const juce::ScopedLock wl(writeLock);
+
+    juce::MemoryBlock data;
+    bool newFile;
+    {
+        const juce::ScopedLock sl(pendingLock);
+        data.swapWith(pending);
+        newFile = startNewFile;
+        startNewFile = false;
+    }
+
+    if (newFile) {
+        // the old journal is only replaced once the checkpoint is on disk
+        stream = nullptr;
+        juce::TemporaryFile tempFile(journalFile);
+        if (!tempFile.getFile().replaceWithData(data.getData(),
+                                                data.getSize()) ||
+            !tempFile.overwriteTargetFileWithTemporary()) {
+            juce::Logger::writeToLog("Failed to write edit journal " +
+                                     journalFile.getFullPathName());
+            return;
+        }
+
+        stream = std::make_unique<juce::FileOutputStream>(journalFile);
+        return;
+    }
+
+    if (data.isEmpty() || stream == nullptr || !stream->openedOk())
+        return;
+
+    stream->write(data.getData(), data.getSize());
+    stream->flush();
+}
+
+} // namespace app_services
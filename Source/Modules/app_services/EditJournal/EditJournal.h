@@ -0,0 +1,78 @@
+#pragma once
+
+namespace app_services {
+
+// Records every change to the edit state in an append only journal beside the
+// edit file, so the edit can be recovered if the app does not shut down
+// cleanly.
+//
+// The journal starts with a checkpoint of the whole state followed by the
+// changes made since, encoded by juce::ValueTreeSynchroniser. Changes are
+// collected in memory on the message thread and appended to the file by a
+// background thread a few times a second. Once the changes outgrow the last
+// checkpoint the journal is compacted by starting a new file from a fresh
+// checkpoint. Destroying the journal is a clean shutdown and deletes the
+// file, so a journal found at startup means the last session crashed.
+class EditJournal : private juce::ValueTreeSynchroniser, private juce::Thread {
+  public:
+    EditJournal(tracktion::Edit &e, const juce::File &editFile);
+    ~EditJournal() override;
+
+    static juce::File getJournalFile(const juce::File &editFile);
+
+    // Replays the journal left behind for editFile, returning an invalid tree
+    // if there is none or it does not start with a checkpoint. A record that
+    // was only partly written ends the replay.
+    static juce::ValueTree readJournal(const juce::File &editFile);
+
+    // Creates the edit from the journal left behind by a crash, or returns
+    // nullptr if there is nothing to recover
+    static std::unique_ptr<tracktion::Edit>
+    recoverEdit(tracktion::Engine &engine, const juce::File &editFile);
+
+    // Starts a new journal from a checkpoint of the current state
+    void compact();
+
+    // Writes everything recorded so far to disk before returning
+    void flush();
+
+    juce::int64 getBytesSinceCheckpoint() const;
+
+    // Changes made on the message thread while one of these exists are left
+    // out of every journal. Checkpoints still take the whole state.
+    class ScopedUnrecordedChanges {
+      public:
+        ScopedUnrecordedChanges();
+        ~ScopedUnrecordedChanges();
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedUnrecordedChanges)
+    };
+
+  private:
+    tracktion::Edit &edit;
+    juce::File journalFile;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    juce::CriticalSection writeLock;
+
+    // shared with the writer thread
+    juce::CriticalSection pendingLock;
+    juce::MemoryBlock pending;
+    bool startNewFile = false;
+
+    // only touched on the message thread
+    bool writingCheckpoint = false;
+    juce::int64 checkpointSize = 0;
+    juce::int64 bytesSinceCheckpoint = 0;
+
+    static constexpr int flushIntervalMs = 250;
+    // compaction waits until the changes are at least this big or twice the
+    // size of the checkpoint, whichever is larger
+    static constexpr juce::int64 minCompactionBytes = 1024 * 1024;
+
+    void stateChanged(const void *encodedChange, size_t encodedChangeSize)
+        override;
+    void run() override;
+    void writePending();
+};
+
+} // namespace app_services
@@ -0,0 +1,168 @@
+#include "LatencyProbe.h"
+
+namespace app_services {
+
+LatencyProbe::Result
+LatencyProbe::Result::fromLatencies(std::vector<double> latenciesMs,
+                                    int blockSize, double sampleRate) {
+    Result result;
+    result.blockSize = blockSize;
+    result.sampleRate = sampleRate;
+    result.numTrials = int(latenciesMs.size());
+    if (latenciesMs.empty())
+        return result;
+
+    std::sort(latenciesMs.begin(), latenciesMs.end());
+    auto n = latenciesMs.size();
+    result.minMs = latenciesMs.front();
+    result.medianMs = latenciesMs[n / 2];
+    result.p99Ms =
+        latenciesMs[std::min(n - 1, size_t(std::ceil(double(n) * .99)) - 1)];
+
+    double mean = 0.0;
+    for (auto latency : latenciesMs)
+        mean += latency;
+    mean /= double(n);
+
+    double variance = 0.0;
+    for (auto latency : latenciesMs)
+        variance += (latency - mean) * (latency - mean);
+    result.jitterMs = std::sqrt(variance / double(n));
+    result.latenciesMs = std::move(latenciesMs);
+
+    return result;
+}
+
+juce::String LatencyProbe::Result::toString() const {
+    return juce::String(blockSize) + " samples at " + juce::String(sampleRate) +
+           "Hz: min " + juce::String(minMs, 2) + "ms, median " +
+           juce::String(medianMs, 2) + "ms, p99 " + juce::String(p99Ms, 2) +
+           "ms, jitter " + juce::String(jitterMs, 2) + "ms over " +
+           juce::String(numTrials) + " notes";
+}
+
+LatencyProbe::LatencyProbe(tracktion::Engine &e)
+    : engine(e), edit(tracktion::Edit::createSingleTrackEdit(engine)) {}
+
+LatencyProbe::~LatencyProbe() { edit->getTransport().stop(false, true); }
+
+void LatencyProbe::setInstrument(tracktion::AudioTrack &track) {
+    auto probeTrack = getTrack();
+    for (auto plugin : probeTrack->pluginList.getPlugins())
+        plugin->removeFromParent();
+
+    // copies of the state without their IDs make new plugins with the same
+    // settings
+    int index = 0;
+    for (auto plugin : track.pluginList.getPlugins()) {
+        plugin->flushPluginStateToValueTree();
+        auto state = plugin->state.createCopy();
+        state.removeProperty(tracktion::IDs::id, nullptr);
+        if (auto copy = edit->getPluginCache().createNewPlugin(state))
+            probeTrack->pluginList.insertPlugin(copy, index++, nullptr);
+    }
+}
+
+LatencyProbe::Result LatencyProbe::measure(double sampleRate, int blockSize,
+                                           int numTrials,
+                                           int outputLatencySamples) {
+    auto &hostedDevice =
+        engine.getDeviceManager().getHostedAudioDeviceInterface();
+    tracktion::HostedAudioDeviceInterface::Parameters parameters;
+    parameters.sampleRate = sampleRate;
+    parameters.blockSize = blockSize;
+    parameters.fixedBlockSize = true;
+    parameters.inputChannels = 0;
+    parameters.outputChannels = 2;
+    hostedDevice.initialise(parameters);
+    hostedDevice.prepareToPlay(sampleRate, blockSize);
+
+    auto &transport = edit->getTransport();
+    transport.stop(false, true);
+    transport.ensureContextAllocated(true);
+    routeMidiInput();
+    // the graph is rebuilt so it picks up the monitored input
+    transport.ensureContextAllocated(true);
+    transport.play(false);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    auto processBlock = [&] {
+        buffer.clear();
+        hostedDevice.processBlock(buffer, midi);
+        midi.clear();
+    };
+
+    auto findOnset = [&]() -> int {
+        for (int i = 0; i < blockSize; ++i)
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                if (std::abs(buffer.getSample(channel, i)) > onsetThreshold)
+                    return i;
+
+        return -1;
+    };
+
+    auto secondsToBlocks = [&](double seconds) {
+        return juce::jmax(1, int(std::ceil(seconds * sampleRate / blockSize)));
+    };
+
+    // let the graph settle before the first note
+    for (int i = secondsToBlocks(.5); --i >= 0;)
+        processBlock();
+
+    std::vector<double> latenciesMs;
+    for (int trial = 0; trial < numTrials; ++trial) {
+        auto offset = random.nextInt(blockSize);
+        midi.addEvent(
+            juce::MidiMessage::noteOn(1, noteNumber, juce::uint8(127)), offset);
+
+        for (int block = 0; block < secondsToBlocks(maxOnsetSeconds);
+             ++block) {
+            processBlock();
+
+            auto onset = findOnset();
+            if (onset >= 0) {
+                auto samples = block * blockSize + onset - offset +
+                               outputLatencySamples;
+                latenciesMs.push_back(samples * 1000.0 / sampleRate);
+                break;
+            }
+        }
+
+        // release the note and wait for the tail to die away
+        midi.addEvent(juce::MidiMessage::noteOff(1, noteNumber), 0);
+        int quietBlocks = 0;
+        for (int block = 0; block < secondsToBlocks(maxReleaseSeconds) &&
+                            quietBlocks < secondsToBlocks(silenceSeconds);
+             ++block) {
+            processBlock();
+            quietBlocks = findOnset() < 0 ? quietBlocks + 1 : 0;
+        }
+    }
+
+    transport.stop(false, true);
+    return Result::fromLatencies(latenciesMs, blockSize, sampleRate);
+}
+
+tracktion::AudioTrack *LatencyProbe::getTrack() {
+    return tracktion::getAudioTracks(*edit)[0];
+}
+
+void LatencyProbe::routeMidiInput() {
+    auto &deviceManager = engine.getDeviceManager();
+    for (int i = 0; i < deviceManager.getNumMidiInDevices(); i++) {
+        if (auto midiInputDevice = deviceManager.getMidiInDevice(i)) {
+            midiInputDevice->setEndToEndEnabled(true);
+            midiInputDevice->setEnabled(true);
+        }
+    }
+
+    for (auto instance : edit->getAllInputDevices())
+        if (dynamic_cast<tracktion::MidiInputDevice *>(
+                &instance->getInputDevice()) != nullptr) {
+            instance->setTargetTrack(*getTrack(), 0, true);
+            instance->setRecordingEnabled(*getTrack(), true);
+        }
+}
+
+} // namespace app_services
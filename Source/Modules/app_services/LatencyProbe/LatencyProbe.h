@@ -0,0 +1,73 @@
+#pragma once
+
+namespace app_services {
+
+// Measures how long it takes from a note on reaching the engine to the sound
+// of the instrument coming out of it.
+//
+// The probe plays a copy of a track's plugins in its own edit and drives the
+// engine block by block through tracktion's hosted audio device, which stands
+// in for the sound card. Each trial injects a note on at a random sample of a
+// block into the hosted MIDI input, which is routed to the track with live
+// monitoring on like TracksListViewModel does for real inputs, and then runs
+// blocks until the output crosses the onset threshold. Doing it offline means
+// the figures are repeatable and can be taken for every buffer size without
+// touching the real device. They cover the engine and plugin part of the
+// latency; what the sound card adds on top is reported by the device and can
+// be passed in to be included.
+//
+// The engine has to be one that is driven by its hosted audio device, create
+// it with HostedEngineBehaviour.
+class LatencyProbe {
+  public:
+    struct HostedEngineBehaviour : public tracktion::EngineBehaviour {
+        bool autoInitialiseDeviceManager() override { return false; }
+    };
+
+    struct Result {
+        int blockSize = 0;
+        double sampleRate = 0.0;
+        // trials that produced sound, a silent instrument gives none
+        int numTrials = 0;
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double p99Ms = 0.0;
+        // standard deviation of the latencies
+        double jitterMs = 0.0;
+        // every measured latency, sorted
+        std::vector<double> latenciesMs;
+
+        static Result fromLatencies(std::vector<double> latenciesMs,
+                                    int blockSize, double sampleRate);
+        juce::String toString() const;
+    };
+
+    explicit LatencyProbe(tracktion::Engine &e);
+    ~LatencyProbe();
+
+    // Replaces the probe track's plugins with copies of the track's plugins
+    void setInstrument(tracktion::AudioTrack &track);
+
+    Result measure(double sampleRate, int blockSize, int numTrials,
+                   int outputLatencySamples = 0);
+
+    int noteNumber = 60;
+    // -60dB
+    float onsetThreshold = .001f;
+
+  private:
+    tracktion::Engine &engine;
+    std::unique_ptr<tracktion::Edit> edit;
+    juce::Random random{1234};
+
+    // how long a note is given to sound before the trial is dropped, and how
+    // long the output has to stay quiet after it before the next trial
+    static constexpr double maxOnsetSeconds = 1.0;
+    static constexpr double silenceSeconds = .1;
+    static constexpr double maxReleaseSeconds = 5.0;
+
+    tracktion::AudioTrack *getTrack();
+    void routeMidiInput();
+};
+
+} // namespace app_services
@@ -0,0 +1,215 @@
+#include "AsyncLogger.h"
+
+namespace app_services {
+
+std::atomic<AsyncLogger *> AsyncLogger::instance{nullptr};
+
+AsyncLogger::AsyncLogger(Options o)
+    : juce::Thread("Logger"), options(std::move(o)),
+      slots(new Slot[size_t(numSlots)]), level(int(options.level)) {
+    static_assert((numSlots & (numSlots - 1)) == 0,
+                  "the ring size has to be a power of two");
+
+    // a slot is free for the writer whose position matches its sequence
+    for (int i = 0; i < numSlots; ++i)
+        slots[size_t(i)].sequence.store(juce::uint32(i),
+                                        std::memory_order_relaxed);
+
+    openStream();
+    instance = this;
+    startThread();
+}
+
+AsyncLogger::~AsyncLogger() {
+    AsyncLogger *self = this;
+    instance.compare_exchange_strong(self, nullptr);
+
+    stopThread(2000);
+    flush();
+}
+
+bool AsyncLogger::write(Level messageLevel, const char *message) {
+    if (int(messageLevel) > level.load(std::memory_order_relaxed))
+        return false;
+
+    auto position = writePosition.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+
+    for (;;) {
+        slot = &slots[size_t(position & (numSlots - 1))];
+        auto sequence = slot->sequence.load(std::memory_order_acquire);
+        auto difference = juce::int32(sequence - position);
+
+        if (difference == 0) {
+            if (writePosition.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed))
+                break;
+        } else if (difference < 0) {
+            // the flusher has not caught up with this slot yet
+            numDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = writePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = messageLevel;
+    slot->time = juce::Time::currentTimeMillis();
+
+    int length = 0;
+    if (message != nullptr)
+        while (length < maxMessageLength && message[length] != 0) {
+            slot->text[length] = message[length];
+            ++length;
+        }
+
+    // don't leave half a UTF-8 character at the end of a cut short message
+    if (length == maxMessageLength)
+        while (length > 0 && (juce::uint8(message[length]) & 0xc0) == 0x80)
+            --length;
+
+    slot->length = length;
+
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLogger::write(Level messageLevel, const juce::String &message) {
+    return write(messageLevel, message.toRawUTF8());
+}
+
+void AsyncLogger::log(Level messageLevel, const char *message) {
+    if (auto logger = instance.load(std::memory_order_acquire))
+        logger->write(messageLevel, message);
+}
+
+void AsyncLogger::log(Level messageLevel, const juce::String &message) {
+    if (auto logger = instance.load(std::memory_order_acquire))
+        logger->write(messageLevel, message);
+}
+
+bool AsyncLogger::isEnabled(Level messageLevel) {
+    auto logger = instance.load(std::memory_order_acquire);
+    return logger != nullptr && messageLevel <= logger->getLevel();
+}
+
+void AsyncLogger::setLevel(Level newLevel) { level = int(newLevel); }
+
+AsyncLogger::Level AsyncLogger::getLevel() const { return Level(level.load()); }
+
+juce::String AsyncLogger::getLevelName(Level l) {
+    switch (l) {
+    case Level::error:
+        return "error";
+    case Level::warning:
+        return "warning";
+    case Level::info:
+        return "info";
+    case Level::debug:
+        return "debug";
+    }
+
+    return {};
+}
+
+AsyncLogger::Level AsyncLogger::getLevelForName(const juce::String &name,
+                                                Level fallback) {
+    for (auto l : {Level::error, Level::warning, Level::info, Level::debug})
+        if (name.trim().equalsIgnoreCase(getLevelName(l)))
+            return l;
+
+    return fallback;
+}
+
+void AsyncLogger::flush() {
+    const juce::ScopedLock sl(drainLock);
+    drain();
+}
+
+int AsyncLogger::getNumDropped() const { return numDropped.load(); }
+
+void AsyncLogger::logMessage(const juce::String &message) {
+    write(Level::info, message);
+}
+
+void AsyncLogger::run() {
+    while (!threadShouldExit()) {
+        wait(flushIntervalMs);
+
+        const juce::ScopedLock sl(drainLock);
+        drain();
+    }
+}
+
+void AsyncLogger::drain() {
+    juce::MemoryOutputStream batch;
+
+    for (;;) {
+        auto &slot = slots[size_t(readPosition & (numSlots - 1))];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (juce::int32(sequence - (readPosition + 1)) < 0)
+            break;
+
+        batch << juce::Time(slot.time).formatted("%Y-%m-%d %H:%M:%S.")
+              << juce::String(slot.time % 1000).paddedLeft('0', 3) << " "
+              << getLevelName(slot.level).toUpperCase().paddedRight(' ', 8)
+              << juce::String::fromUTF8(slot.text, slot.length)
+              << juce::newLine;
+
+        // hand the slot back to writers one lap of the ring later
+        slot.sequence.store(readPosition + numSlots, std::memory_order_release);
+        ++readPosition;
+    }
+
+    auto dropped = numDropped.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped) {
+        batch << "Logger dropped " << juce::String(dropped - reportedDropped)
+              << " messages" << juce::newLine;
+        reportedDropped = dropped;
+    }
+
+    if (batch.getDataSize() == 0 || stream == nullptr)
+        return;
+
+    stream->write(batch.getData(), batch.getDataSize());
+    stream->flush();
+
+    if (stream->getPosition() > options.maxFileSize)
+        rotate();
+}
+
+void AsyncLogger::openStream() {
+    stream = nullptr;
+    if (options.logFile == juce::File())
+        return;
+
+    options.logFile.getParentDirectory().createDirectory();
+    stream = std::make_unique<juce::FileOutputStream>(options.logFile);
+    if (stream->failedToOpen())
+        stream = nullptr;
+}
+
+void AsyncLogger::rotate() {
+    stream = nullptr;
+
+    // log.txt becomes log.1.txt, log.1.txt becomes log.2.txt and so on, the
+    // oldest one is dropped
+    getBackupFile(options.maxBackupFiles).deleteFile();
+    for (int i = options.maxBackupFiles - 1; i >= 1; --i)
+        getBackupFile(i).moveFileTo(getBackupFile(i + 1));
+
+    if (options.maxBackupFiles > 0)
+        options.logFile.moveFileTo(getBackupFile(1));
+    else
+        options.logFile.deleteFile();
+
+    openStream();
+}
+
+juce::File AsyncLogger::getBackupFile(int index) const {
+    return options.logFile.getSiblingFile(
+        options.logFile.getFileNameWithoutExtension() + "." +
+        juce::String(index) + options.logFile.getFileExtension());
+}
+
+} // namespace app_services
@@ -0,0 +1,92 @@
+#pragma once
+
+namespace app_services {
+
+// Application wide logger that never writes to disk on the calling thread.
+//
+// Messages are copied into a fixed ring of slots that any number of threads
+// can write to at once without locking or allocating, so it is safe to log
+// from the audio thread through the const char* overloads. A background
+// thread wakes up a few times a second, formats whatever has been queued and
+// appends it to the log file in one write, moving the file aside once it
+// grows past the size limit.
+//
+// If the ring fills up faster than it is drained, new messages are dropped
+// and counted rather than blocking the writer.
+class AsyncLogger : public juce::Logger, private juce::Thread {
+  public:
+    enum class Level { error, warning, info, debug };
+
+    struct Options {
+        juce::File logFile;
+        Level level = Level::info;
+        // the log is moved to a numbered backup once it is bigger than this
+        juce::int64 maxFileSize = 1024 * 1024;
+        int maxBackupFiles = 3;
+    };
+
+    explicit AsyncLogger(Options o);
+    ~AsyncLogger() override;
+
+    // Queues a message from any thread. Messages longer than a slot are cut
+    // short. Returns false if the message was filtered out by the level or
+    // dropped because the ring was full.
+    bool write(Level messageLevel, const char *message);
+    bool write(Level messageLevel, const juce::String &message);
+
+    // Writes to the most recently created logger, if there is one
+    static void log(Level messageLevel, const char *message);
+    static void log(Level messageLevel, const juce::String &message);
+
+    // Lets callers skip building messages that would be filtered out
+    static bool isEnabled(Level messageLevel);
+
+    void setLevel(Level newLevel);
+    Level getLevel() const;
+
+    static juce::String getLevelName(Level l);
+    static Level getLevelForName(const juce::String &name, Level fallback);
+
+    // Blocks until everything queued so far has been written to the file
+    void flush();
+
+    int getNumDropped() const;
+
+    // Messages sent through juce::Logger::writeToLog are logged as info
+    void logMessage(const juce::String &message) override;
+
+    static constexpr int numSlots = 1024;
+    static constexpr int maxMessageLength = 256;
+
+  private:
+    struct Slot {
+        std::atomic<juce::uint32> sequence{0};
+        Level level = Level::info;
+        juce::int64 time = 0;
+        int length = 0;
+        char text[maxMessageLength];
+    };
+
+    Options options;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<juce::uint32> writePosition{0};
+    std::atomic<int> level;
+    std::atomic<int> numDropped{0};
+
+    // only touched while holding the drain lock
+    juce::CriticalSection drainLock;
+    juce::uint32 readPosition = 0;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    int reportedDropped = 0;
+
+    static std::atomic<AsyncLogger *> instance;
+    static constexpr int flushIntervalMs = 200;
+
+    void run() override;
+    void drain();
+    void openStream();
+    void rotate();
+    juce::File getBackupFile(int index) const;
+};
+
+} // namespace app_services
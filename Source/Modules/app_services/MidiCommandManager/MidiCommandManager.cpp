@@ -2,43 +2,180 @@
 #include <typeinfo>
 namespace app_services {
 
+namespace {
+
+using Command = MidiCommandManager::Command;
+using Callback = void (MidiCommandManager::Listener::*)();
+
+struct CommandInfo {
+    const char *name;
+    // only the focused component is told, otherwise every listener is
+    bool focusedOnly;
+    // encoders send 1 to increase and 127 to decrease, buttons send 127 when
+    // pressed and 0 when released
+    bool isEncoder;
+    Callback increasedOrPressed;
+    Callback decreasedOrReleased;
+    // what the command does while the control button is held
+    Command withControl;
+};
+
+using L = MidiCommandManager::Listener;
+
+const std::array<CommandInfo, size_t(Command::numCommands)> commandInfos = {{
+    {"", false, false, nullptr, nullptr, Command::none},
+    {"encoder1", true, true, &L::encoder1Increased, &L::encoder1Decreased,
+     Command::none},
+    {"encoder2", true, true, &L::encoder2Increased, &L::encoder2Decreased,
+     Command::none},
+    {"encoder3", true, true, &L::encoder3Increased, &L::encoder3Decreased,
+     Command::none},
+    {"encoder4", true, true, &L::encoder4Increased, &L::encoder4Decreased,
+     Command::none},
+    {"encoder5", true, true, &L::encoder5Increased, &L::encoder5Decreased,
+     Command::none},
+    {"encoder6", true, true, &L::encoder6Increased, &L::encoder6Decreased,
+     Command::none},
+    {"encoder7", true, true, &L::encoder7Increased, &L::encoder7Decreased,
+     Command::none},
+    {"encoder8", true, true, &L::encoder8Increased, &L::encoder8Decreased,
+     Command::none},
+    {"encoder9", true, true, &L::encoder9Increased, &L::encoder9Decreased,
+     Command::none},
+    {"encoder1-button", true, false, &L::encoder1ButtonPressed,
+     &L::encoder1ButtonReleased, Command::none},
+    {"encoder2-button", true, false, &L::encoder2ButtonPressed,
+     &L::encoder2ButtonReleased, Command::none},
+    {"encoder3-button", true, false, &L::encoder3ButtonPressed,
+     &L::encoder3ButtonReleased, Command::none},
+    {"encoder4-button", true, false, &L::encoder4ButtonPressed,
+     &L::encoder4ButtonReleased, Command::none},
+    {"encoder5-button", true, false, &L::encoder5ButtonPressed,
+     &L::encoder5ButtonReleased, Command::none},
+    {"encoder6-button", true, false, &L::encoder6ButtonPressed,
+     &L::encoder6ButtonReleased, Command::none},
+    {"encoder7-button", true, false, &L::encoder7ButtonPressed,
+     &L::encoder7ButtonReleased, Command::none},
+    {"encoder8-button", true, false, &L::encoder8ButtonPressed,
+     &L::encoder8ButtonReleased, Command::none},
+    {"tracks", false, false, &L::tracksButtonPressed, &L::tracksButtonReleased,
+     Command::none},
+    {"plugins", false, false, &L::pluginsButtonPressed,
+     &L::pluginsButtonReleased, Command::none},
+    {"modifiers", false, false, &L::modifiersButtonPressed,
+     &L::modifiersButtonReleased, Command::none},
+    {"settings", false, false, &L::settingsButtonPressed,
+     &L::settingsButtonReleased, Command::none},
+    {"mixer", false, false, &L::mixerButtonPressed, &L::mixerButtonReleased,
+     Command::none},
+    {"tempo-settings", false, false, &L::tempoSettingsButtonPressed,
+     &L::tempoSettingsButtonReleased, Command::none},
+    {"save", false, false, &L::saveButtonPressed, &L::saveButtonReleased,
+     Command::render},
+    {"render", false, false, &L::renderButtonPressed, &L::renderButtonReleased,
+     Command::none},
+    {"record", true, false, &L::recordButtonPressed, &L::recordButtonReleased,
+     Command::none},
+    {"play", true, false, &L::playButtonPressed, &L::playButtonReleased,
+     Command::none},
+    {"stop", true, false, &L::stopButtonPressed, &L::stopButtonReleased,
+     Command::none},
+    {"plus", false, false, &L::plusButtonPressed, &L::plusButtonReleased,
+     Command::none},
+    {"minus", false, false, &L::minusButtonPressed, &L::minusButtonReleased,
+     Command::none},
+    {"cut", true, false, &L::cutButtonPressed, &L::cutButtonReleased,
+     Command::none},
+    {"paste", true, false, &L::pasteButtonPressed, &L::pasteButtonReleased,
+     Command::none},
+    {"slice", true, false, &L::sliceButtonPressed, &L::sliceButtonReleased,
+     Command::none},
+    {"sequencers", false, false, &L::sequencersButtonPressed,
+     &L::sequencersButtonReleased, Command::none},
+    {"control", false, false, &L::controlButtonPressed,
+     &L::controlButtonReleased, Command::none},
+    {"loop-in", false, false, &L::loopInButtonPressed, &L::loopInButtonReleased,
+     Command::none},
+    {"loop-out", false, false, &L::loopOutButtonPressed,
+     &L::loopOutButtonReleased, Command::none},
+    {"loop", true, false, &L::loopButtonPressed, &L::loopButtonReleased,
+     Command::undo},
+    {"undo", true, false, &L::undoButtonPressed, &L::undoButtonReleased,
+     Command::none},
+    // the octave is sent as a value rather than a press, see dispatch()
+    {"octave", false, false, nullptr, nullptr, Command::none},
+}};
+
+// clang-format off
+// The controllers the LMN-3 keyboard sends on every channel
+const std::pair<Command, int> defaultMapping[] = {
+    {Command::encoder1, 3},         {Command::encoder2, 9},
+    {Command::encoder3, 14},        {Command::encoder4, 15},
+    {Command::encoder1Button, 20},  {Command::encoder2Button, 21},
+    {Command::encoder3Button, 22},  {Command::encoder4Button, 23},
+    {Command::undo, 24},            {Command::tempoSettings, 25},
+    {Command::save, 26},            {Command::settings, 85},
+    {Command::tracks, 86},          {Command::mixer, 88},
+    {Command::plugins, 89},         {Command::modifiers, 90},
+    {Command::sequencers, 102},     {Command::loopIn, 103},
+    {Command::loopOut, 104},        {Command::loop, 105},
+    {Command::cut, 106},            {Command::paste, 107},
+    {Command::slice, 108},          {Command::record, 109},
+    {Command::play, 110},           {Command::stop, 111},
+    {Command::control, 112},        {Command::octave, 117},
+    {Command::plus, 118},           {Command::minus, 119},
+};
+// clang-format on
+
+} // namespace
+
 MidiCommandManager::MidiCommandManager(tracktion::Engine &e) : engine(e) {
     // need  to listen to midi events to pass to the midi command manager
     // to do this we need to call the addMidiInputDeviceCallback method
-    // on the JUCE deviceManager (not the tracktion wrapper)
-    // also we will enable the device if its disabled
-    auto &juceDeviceManager = engine.getDeviceManager().deviceManager;
-    auto list = juce::MidiInput::getAvailableDevices();
-    for (const auto &midiDevice : list) {
-        juce::Logger::writeToLog("enabling juce midi device: " +
-                                 midiDevice.name);
-        juceDeviceManager.setMidiInputDeviceEnabled(midiDevice.identifier,
-                                                    true);
+    // on the JUCE deviceManager (not the tracktion wrapper). An empty
+    // identifier receives the messages of every enabled device, so the
+    // devices don't have to be enumerated here.
+    engine.getDeviceManager().deviceManager.addMidiInputDeviceCallback({},
+                                                                       this);
 
-        juce::Logger::writeToLog("adding callback for juce midi device: " +
-                                 midiDevice.name);
-        juceDeviceManager.addMidiInputDeviceCallback(midiDevice.identifier,
-                                                     this);
-    }
+    resetMapping();
 }
 
 MidiCommandManager::~MidiCommandManager() {
+    engine.getDeviceManager().deviceManager.removeMidiInputDeviceCallback(
+        {}, this);
+}
+
+int MidiCommandManager::enableAllMidiInputs() {
     auto &juceDeviceManager = engine.getDeviceManager().deviceManager;
-    auto list = juce::MidiInput::getAvailableDevices();
-    for (const auto &midiDevice : list) {
-        juceDeviceManager.removeMidiInputDeviceCallback(midiDevice.identifier,
-                                                        this);
+    int numEnabled = 0;
+    for (const auto &midiDevice : juce::MidiInput::getAvailableDevices()) {
+        if (juceDeviceManager.isMidiInputDeviceEnabled(midiDevice.identifier))
+            continue;
+
+        AsyncLogger::log(AsyncLogger::Level::debug,
+                         "enabling juce midi device: " + midiDevice.name);
+        juceDeviceManager.setMidiInputDeviceEnabled(midiDevice.identifier,
+                                                    true);
+        numEnabled++;
     }
+
+    return numEnabled;
 }
 
 void MidiCommandManager::setFocusedComponent(juce::Component *c) {
     focusedComponent = c;
+    focusedListener = dynamic_cast<Listener *>(c);
 }
 
 juce::Component *MidiCommandManager::getFocusedComponent() {
     return focusedComponent;
 }
 
+void MidiCommandManager::setLogMessages(bool shouldLog) {
+    shouldLogMessages = shouldLog;
+}
+
 void MidiCommandManager::handleIncomingMidiMessage(
     juce::MidiInput *source, const juce::MidiMessage &message) {
     (new IncomingMessageCallback(*this, message, source->getName()))->post();
@@ -46,381 +183,135 @@ void MidiCommandManager::handleIncomingMidiMessage(
 
 void MidiCommandManager::midiMessageReceived(const juce::MidiMessage &message,
                                              const juce::String &source) {
-    juce::Logger::writeToLog(getMidiMessageDescription(message));
+    if (shouldLogMessages)
+        juce::Logger::writeToLog(getMidiMessageDescription(message));
 
     if (message.isNoteOn()) {
-        if (auto listener = dynamic_cast<Listener *>(focusedComponent))
-            listener->noteOnPressed(message.getNoteNumber());
+        if (focusedListener != nullptr)
+            focusedListener->noteOnPressed(message.getNoteNumber());
     }
 
     if (message.isController()) {
         listeners.call([message](Listener &l) {
             l.controllerEventReceived(message.getControllerNumber(),
-                                      message.getControllerValue());
+                                      message.getControllerValue(),
+                                      message.getChannel());
         });
 
-        switch (message.getControllerNumber()) {
-        case ENCODER_1:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder1Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder1Decreased();
-            }
-
-            break;
-
-        case ENCODER_2:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder2Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder2Decreased();
-            }
-
-            break;
-
-        case ENCODER_3:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder3Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder3Decreased();
-            }
-
-            break;
-
-        case ENCODER_4:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder4Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder4Decreased();
-            }
-
-            break;
-
-        case ENCODER_1_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder1ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder1ButtonReleased();
-            }
-
-            break;
-
-        case ENCODER_2_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder2ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder2ButtonReleased();
-            }
-
-            break;
-
-        case ENCODER_3_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder3ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder3ButtonReleased();
-            }
-
-            break;
-
-        case ENCODER_4_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder4ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder4ButtonReleased();
-            }
-
-            break;
-
-        case TRACKS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.tracksButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.tracksButtonReleased(); });
-
-            break;
-
-        case MIXER_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.mixerButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.mixerButtonReleased(); });
-
-            break;
-
-        case PLUGINS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.pluginsButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.pluginsButtonReleased(); });
-
-            break;
-
-        case MODIFIERS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.modifiersButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call(
-                    [](Listener &l) { l.modifiersButtonReleased(); });
-
-            break;
-
-        case SETTINGS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.settingsButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.settingsButtonReleased(); });
-
-            break;
-
-        case TEMPO_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call(
-                    [](Listener &l) { l.tempoSettingsButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call(
-                    [](Listener &l) { l.tempoSettingsButtonReleased(); });
-
-            break;
-
-        case SAVE_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-
-            if (isControlDown) {
-                if (message.getControllerValue() == 127)
-                    listeners.call(
-                        [](Listener &l) { l.renderButtonPressed(); });
-
-                if (message.getControllerValue() == 0)
-                    listeners.call(
-                        [](Listener &l) { l.renderButtonReleased(); });
-            } else {
-                if (message.getControllerValue() == 127)
-                    listeners.call([](Listener &l) { l.saveButtonPressed(); });
-
-                if (message.getControllerValue() == 0)
-                    listeners.call([](Listener &l) { l.saveButtonReleased(); });
-            }
-
-            break;
-
-        case RECORD_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->recordButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->recordButtonReleased();
-            }
-
-            break;
-
-        case PLAY_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->playButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->playButtonReleased();
-            }
-
-            break;
-
-        case STOP_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->stopButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->stopButtonReleased();
-            }
-
-            break;
-
-        case SEQUENCERS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call(
-                    [](Listener &l) { l.sequencersButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call(
-                    [](Listener &l) { l.sequencersButtonReleased(); });
-
-            break;
-
-        case CUT_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->cutButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->cutButtonReleased();
-            }
-
-            break;
-
-        case PASTE_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->pasteButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->pasteButtonReleased();
-            }
-
-            break;
-
-        case SLICE_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->sliceButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->sliceButtonReleased();
-            }
-
-            break;
-
-        case CONTROL_BUTTON:
-            if (message.getControllerValue() == 127) {
-                isControlDown = true;
-                listeners.call([](Listener &l) { l.controlButtonPressed(); });
-            }
-
-            if (message.getControllerValue() == 0) {
-                isControlDown = false;
-                listeners.call([](Listener &l) { l.controlButtonReleased(); });
-            }
-
-            break;
-
-        case LOOP_IN_BUTTON:
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.loopInButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.loopInButtonReleased(); });
-
-            break;
-
-        case LOOP_OUT_BUTTON:
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.loopOutButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.loopOutButtonReleased(); });
-
-            break;
+        dispatch(getCommandForController(message.getControllerNumber(),
+                                         message.getChannel()),
+                 message.getControllerValue());
+    }
+}
 
-        case LOOP_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (isControlDown) {
-                    if (message.getControllerValue() == 127)
-                        listener->undoButtonPressed();
+void MidiCommandManager::dispatch(Command command, int controllerValue) {
+    if (command == Command::none)
+        return;
 
-                    if (message.getControllerValue() == 0)
-                        listener->undoButtonReleased();
+    if (command == Command::octave) {
+        // controller values will be between 0 and 8, 4 is the "home" octave
+        // (we will display 0) 0 is min octave (-4) 8 is max octave (+4)
+        listeners.call([controllerValue](Listener &l) {
+            l.octaveChanged(controllerValue - 4);
+        });
+        return;
+    }
 
-                } else {
-                    if (message.getControllerValue() == 127)
-                        listener->loopButtonPressed();
+    auto *info = &commandInfos[size_t(command)];
+    if (isControlDown && info->withControl != Command::none)
+        info = &commandInfos[size_t(info->withControl)];
+
+    Callback callback = nullptr;
+    if (info->isEncoder) {
+        if (controllerValue == 1)
+            callback = info->increasedOrPressed;
+        else if (controllerValue == 127)
+            callback = info->decreasedOrReleased;
+    } else {
+        if (controllerValue == 127)
+            callback = info->increasedOrPressed;
+        else if (controllerValue == 0)
+            callback = info->decreasedOrReleased;
+    }
 
-                    if (message.getControllerValue() == 0)
-                        listener->loopButtonReleased();
-                }
-            }
+    if (callback == nullptr)
+        return;
+
+    bool isDown = controllerValue == 127;
+    if (command == Command::control)
+        isControlDown = isDown;
+    else if (command == Command::plus)
+        isPlusDown = isDown;
+    else if (command == Command::minus)
+        isMinusDown = isDown;
+
+    if (info->focusedOnly) {
+        if (focusedListener != nullptr)
+            (focusedListener->*callback)();
+    } else {
+        listeners.call([callback](Listener &l) { (l.*callback)(); });
+    }
+}
 
-            break;
+juce::String MidiCommandManager::getCommandName(Command command) {
+    if (command >= Command::numCommands)
+        return {};
 
-        case UNDO_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->undoButtonPressed();
+    return commandInfos[size_t(command)].name;
+}
 
-                if (message.getControllerValue() == 0)
-                    listener->undoButtonReleased();
-            }
+MidiCommandManager::Command
+MidiCommandManager::getCommandForName(const juce::String &name) {
+    for (size_t i = 1; i < commandInfos.size(); ++i)
+        if (name == commandInfos[i].name)
+            return Command(i);
 
-            break;
+    return Command::none;
+}
 
-        case OCTAVE_CHANGE:
-            // This should be called for all listeners, not just the currently
-            // focused component controller message values will be between 0 and
-            // 8, 4 is the "home" octave (we will display 0) 0 is min octave
-            // (-4) 8 is max octave (+4)
-            listeners.call([message](Listener &l) {
-                l.octaveChanged(message.getControllerValue() - 4);
-            });
+bool MidiCommandManager::mapController(Command command, int controllerNumber,
+                                       int channel) {
+    if (command >= Command::numCommands ||
+        !juce::isPositiveAndBelow(controllerNumber, numControllers) ||
+        !juce::isPositiveAndNotGreaterThan(channel, numChannels))
+        return false;
 
-            break;
+    for (int i = 0; i < numChannels; ++i)
+        if (channel == 0 || channel == i + 1)
+            dispatchTable[size_t(i)][size_t(controllerNumber)] = command;
 
-        case PLUS_BUTTON:
-            if (message.getControllerValue() == 127) {
-                isPlusDown = true;
-                listeners.call([](Listener &l) { l.plusButtonPressed(); });
-            }
+    return true;
+}
 
-            if (message.getControllerValue() == 0) {
-                isPlusDown = false;
-                listeners.call([](Listener &l) { l.plusButtonReleased(); });
-            }
+bool MidiCommandManager::mapController(const juce::String &commandName,
+                                       int controllerNumber, int channel) {
+    auto command = getCommandForName(commandName);
+    if (command == Command::none)
+        return false;
 
-            break;
+    return mapController(command, controllerNumber, channel);
+}
 
-        case MINUS_BUTTON:
-            if (message.getControllerValue() == 127) {
-                isMinusDown = true;
-                listeners.call([](Listener &l) { l.minusButtonPressed(); });
-            }
+MidiCommandManager::Command
+MidiCommandManager::getCommandForController(int controllerNumber,
+                                            int channel) const {
+    if (!juce::isPositiveAndBelow(controllerNumber, numControllers) ||
+        !juce::isPositiveAndNotGreaterThan(channel, numChannels) ||
+        channel == 0)
+        return Command::none;
 
-            if (message.getControllerValue() == 0) {
-                isMinusDown = false;
-                listeners.call([](Listener &l) { l.minusButtonReleased(); });
-            }
+    return dispatchTable[size_t(channel - 1)][size_t(controllerNumber)];
+}
 
-            break;
+void MidiCommandManager::resetMapping() {
+    clearMapping();
+    for (auto &mapping : defaultMapping)
+        mapController(mapping.first, mapping.second);
+}
 
-        default:
-            break;
-        }
-    }
+void MidiCommandManager::clearMapping() {
+    for (auto &channel : dispatchTable)
+        channel.fill(Command::none);
 }
 
 juce::String
@@ -1,13 +1,96 @@
 #pragma once
 namespace app_services {
 
+// Turns the controller messages from the keyboard into commands for the UI.
+//
+// Controllers are looked up in a flat table with an entry for each of the 128
+// controller numbers on each MIDI channel, so a message costs one array read
+// however many commands there are. The table starts out with the LMN-3
+// mapping and can be replaced, for example from config.yaml, to drive the app
+// from a different controller.
+//
+// Commands go either to every listener or only to the focused component. The
+// focused component's listener is looked up once when focus changes rather
+// than on every message.
 class MidiCommandManager : private juce::MidiInputCallback {
   public:
+    // Listens to every MIDI input the device manager has enabled, including
+    // ones enabled later, without enumerating the devices itself
     explicit MidiCommandManager(tracktion::Engine &e);
     ~MidiCommandManager() override;
 
+    // Enables every MIDI input that is connected, returning how many were
+    // not enabled yet. Boot runs this after the saved device setup has been
+    // restored to pick up devices that were plugged in since.
+    int enableAllMidiInputs();
+
+    enum class Command : juce::uint8 {
+        none,
+        encoder1,
+        encoder2,
+        encoder3,
+        encoder4,
+        encoder5,
+        encoder6,
+        encoder7,
+        encoder8,
+        encoder9,
+        encoder1Button,
+        encoder2Button,
+        encoder3Button,
+        encoder4Button,
+        encoder5Button,
+        encoder6Button,
+        encoder7Button,
+        encoder8Button,
+        tracks,
+        plugins,
+        modifiers,
+        settings,
+        mixer,
+        tempoSettings,
+        save,
+        render,
+        record,
+        play,
+        stop,
+        plus,
+        minus,
+        cut,
+        paste,
+        slice,
+        sequencers,
+        control,
+        loopIn,
+        loopOut,
+        loop,
+        undo,
+        octave,
+        numCommands
+    };
+
+    // Command names as they are written in config.yaml, empty for none
+    static juce::String getCommandName(Command command);
+    static Command getCommandForName(const juce::String &name);
+
+    // Sends a controller to a command. Channels are 1 to 16, channel 0 maps
+    // the controller on every channel. Returns false for an unknown command
+    // name or a controller or channel out of range.
+    bool mapController(Command command, int controllerNumber, int channel = 0);
+    bool mapController(const juce::String &commandName, int controllerNumber,
+                       int channel = 0);
+
+    Command getCommandForController(int controllerNumber, int channel) const;
+
+    void resetMapping();
+    void clearMapping();
+
     void setFocusedComponent(juce::Component *c);
     juce::Component *getFocusedComponent();
+
+    // Writes every incoming message to the log, off by default since the
+    // keyboard sends a message for every encoder tick
+    void setLogMessages(bool shouldLog);
     bool isControlDown = false;
     bool isPlusDown = false;
     bool isMinusDown = false;
@@ -18,8 +101,10 @@ class MidiCommandManager : private juce::MidiInputCallback {
       public:
         virtual ~Listener() = default;
 
+        // Every controller message, before it is dispatched as a command
         virtual void controllerEventReceived(int controllerNumber,
-                                             int controllerValue) {}
+                                             int controllerValue,
+                                             int channel) {}
 
         virtual void noteOnPressed(int noteNumber) {}
 
@@ -141,9 +226,17 @@ class MidiCommandManager : private juce::MidiInputCallback {
 
   private:
     tracktion::Engine &engine;
-    juce::Component *focusedComponent;
+    juce::Component *focusedComponent = nullptr;
+    // the focused component as a listener, nullptr if it is not one
+    Listener *focusedListener = nullptr;
+    bool shouldLogMessages = false;
     juce::ListenerList<Listener> listeners;
 
+    static constexpr int numChannels = 16;
+    static constexpr int numControllers = 128;
+    std::array<std::array<Command, numControllers>, numChannels>
+        dispatchTable{};
+
     // This is used to dispach an incoming message to the message thread
     class IncomingMessageCallback : public juce::CallbackMessage {
       public:
@@ -166,38 +259,7 @@ class MidiCommandManager : private juce::MidiInputCallback {
 
     static juce::String getMidiMessageDescription(const juce::MidiMessage &m);
 
-    static constexpr int encoder1 = 3;
-    // Midi mapping
-    static constexpr int ENCODER_1 = 3;
-    static constexpr int ENCODER_2 = 9;
-    static constexpr int ENCODER_3 = 14;
-    static constexpr int ENCODER_4 = 15;
-    static constexpr int ENCODER_1_BUTTON = 20;
-    static constexpr int ENCODER_2_BUTTON = 21;
-    static constexpr int ENCODER_3_BUTTON = 22;
-    static constexpr int ENCODER_4_BUTTON = 23;
-    static constexpr int UNDO_BUTTON = 24;
-    static constexpr int TEMPO_BUTTON = 25;
-    static constexpr int SAVE_BUTTON = 26;
-    static constexpr int SETTINGS_BUTTON = 85;
-    static constexpr int TRACKS_BUTTON = 86;
-    static constexpr int MIXER_BUTTON = 88;
-    static constexpr int PLUGINS_BUTTON = 89;
-    static constexpr int MODIFIERS_BUTTON = 90;
-    static constexpr int SEQUENCERS_BUTTON = 102;
-    static constexpr int LOOP_IN_BUTTON = 103;
-    static constexpr int LOOP_OUT_BUTTON = 104;
-    static constexpr int LOOP_BUTTON = 105;
-    static constexpr int CUT_BUTTON = 106;
-    static constexpr int PASTE_BUTTON = 107;
-    static constexpr int SLICE_BUTTON = 108;
-    static constexpr int RECORD_BUTTON = 109;
-    static constexpr int PLAY_BUTTON = 110;
-    static constexpr int STOP_BUTTON = 111;
-    static constexpr int CONTROL_BUTTON = 112;
-    static constexpr int OCTAVE_CHANGE = 117;
-    static constexpr int PLUS_BUTTON = 118;
-    static constexpr int MINUS_BUTTON = 119;
+    void dispatch(Command command, int controllerValue);
 };
 
 } // namespace app_services
@@ -0,0 +1,364 @@
+#include "SamplePreview.h"
+
+namespace app_services {
+
+// One file being auditioned. The audio thread plays the head and then pulls
+// from the fifo, the read thread opens the file and keeps the fifo filled
+// from where the head ends.
+class SamplePreview::Voice : public juce::AudioSource,
+                             public juce::TimeSliceClient {
+  public:
+    Voice(const juce::File &f, std::shared_ptr<const Head> h,
+          juce::AudioFormatManager &fm)
+        : file(f), head(std::move(h)), formatManager(fm),
+          readPosition(head->buffer.getNumSamples()) {}
+
+    // called on the message thread before the voice is handed over
+    void prepare(int blockSize, double deviceSampleRate) {
+        scratch.setSize(2, blockSize);
+        resampling = head->sampleRate != deviceSampleRate;
+        resampler.setResamplingRatio(head->sampleRate / deviceSampleRate);
+        resampler.prepareToPlay(blockSize, deviceSampleRate);
+    }
+
+    bool needsReader() const { return readPosition < head->lengthInSamples; }
+    bool isBuffered() const {
+        return !needsReader() || fifo.getFreeSpace() == 0;
+    }
+    bool isFinished() const { return finished.load(); }
+
+    void render(float *const *outputChannelData, int numOutputChannels,
+                int numSamples) {
+        for (int done = 0; done < numSamples;) {
+            auto num = juce::jmin(numSamples - done, scratch.getNumSamples());
+            juce::AudioSourceChannelInfo info(&scratch, 0, num);
+            if (resampling)
+                resampler.getNextAudioBlock(info);
+            else
+                getNextAudioBlock(info);
+
+            // the engine's master output is on the first two channels
+            for (int i = 0; i < juce::jmin(numOutputChannels, 2); ++i)
+                if (outputChannelData[i] != nullptr)
+                    juce::FloatVectorOperations::copy(
+                        outputChannelData[i] + done, scratch.getReadPointer(i),
+                        num);
+
+            done += num;
+        }
+    }
+
+    void prepareToPlay(int, double) override {}
+    void releaseResources() override {}
+
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo &info) override {
+        auto &buffer = *info.buffer;
+        auto start = info.startSample;
+        auto remaining = info.numSamples;
+
+        auto headLength = juce::int64(head->buffer.getNumSamples());
+        if (playPosition < headLength) {
+            auto num = int(juce::jmin(juce::int64(remaining),
+                                      headLength - playPosition));
+            for (int i = 0; i < 2; ++i)
+                buffer.copyFrom(i, start, head->buffer, i, int(playPosition),
+                                num);
+
+            playPosition += num;
+            start += num;
+            remaining -= num;
+        }
+
+        if (remaining > 0 && playPosition < head->lengthInSamples) {
+            int start1, size1, start2, size2;
+            fifo.prepareToRead(remaining, start1, size1, start2, size2);
+            for (int i = 0; i < 2; ++i) {
+                if (size1 > 0)
+                    buffer.copyFrom(i, start, fifoBuffer, i, start1, size1);
+                if (size2 > 0)
+                    buffer.copyFrom(i, start + size1, fifoBuffer, i, start2,
+                                    size2);
+            }
+            fifo.finishedRead(size1 + size2);
+
+            playPosition += size1 + size2;
+            start += size1 + size2;
+            remaining -= size1 + size2;
+        }
+
+        // either the end or the reader fell behind, which only costs a gap
+        if (remaining > 0) {
+            buffer.clear(start, remaining);
+            if (playPosition >= head->lengthInSamples)
+                finished = true;
+        }
+    }
+
+    int useTimeSlice() override {
+        if (!needsReader())
+            return 100;
+
+        if (reader == nullptr) {
+            reader.reset(formatManager.createReaderFor(file));
+            if (reader == nullptr) {
+                // gone since the head was read, the rest plays as silence
+                readPosition = head->lengthInSamples;
+                return 100;
+            }
+        }
+
+        auto num = int(juce::jmin(juce::int64(fifo.getFreeSpace()),
+                                  juce::int64(samplesPerRead),
+                                  head->lengthInSamples - readPosition));
+        if (num <= 0)
+            return 5;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(num, start1, size1, start2, size2);
+        if (size1 > 0)
+            reader->read(&fifoBuffer, start1, size1, readPosition, true, true);
+        if (size2 > 0)
+            reader->read(&fifoBuffer, start2, size2, readPosition + size1,
+                         true, true);
+        fifo.finishedWrite(size1 + size2);
+
+        readPosition += size1 + size2;
+        return 0;
+    }
+
+  private:
+    static constexpr int samplesPerRead = 8192;
+
+    juce::File file;
+    std::shared_ptr<const Head> head;
+    juce::AudioFormatManager &formatManager;
+
+    // only written on the read thread
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    std::atomic<juce::int64> readPosition;
+
+    juce::AbstractFifo fifo{numSamplesToBuffer};
+    juce::AudioBuffer<float> fifoBuffer{2, numSamplesToBuffer};
+
+    // only touched on the audio thread
+    juce::int64 playPosition = 0;
+    juce::AudioBuffer<float> scratch;
+    juce::ResamplingAudioSource resampler{this, false, 2};
+    bool resampling = false;
+
+    std::atomic<bool> finished{false};
+};
+
+SamplePreview::SamplePreview(juce::AudioDeviceManager &dm)
+    : deviceManager(dm) {
+    formatManager.registerBasicFormats();
+    readThread.addTimeSliceClient(this);
+    readThread.startThread();
+    deviceManager.addAudioCallback(this);
+}
+
+SamplePreview::~SamplePreview() {
+    deviceManager.removeAudioCallback(this);
+    stop();
+    readThread.removeTimeSliceClient(this);
+    readThread.stopThread(1000);
+}
+
+std::shared_ptr<SamplePreview>
+SamplePreview::getFor(juce::AudioDeviceManager &dm) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    static std::vector<std::weak_ptr<SamplePreview>> previews;
+
+    std::shared_ptr<SamplePreview> result;
+    for (auto it = previews.begin(); it != previews.end();) {
+        if (auto preview = it->lock()) {
+            if (&preview->deviceManager == &dm)
+                result = preview;
+
+            ++it;
+        } else {
+            it = previews.erase(it);
+        }
+    }
+
+    if (result == nullptr) {
+        result = std::make_shared<SamplePreview>(dm);
+        previews.push_back(result);
+    }
+
+    return result;
+}
+
+bool SamplePreview::play(const juce::File &file) {
+    auto rate = sampleRate.load();
+    auto blockSize = bufferSize.load();
+    auto head = rate > 0.0 && blockSize > 0 ? getHead(file) : nullptr;
+    if (head == nullptr) {
+        stop();
+        return false;
+    }
+
+    auto newVoice = std::make_unique<Voice>(file, head, formatManager);
+    newVoice->prepare(blockSize, rate);
+    if (newVoice->needsReader())
+        readThread.addTimeSliceClient(newVoice.get());
+
+    swapVoice(std::move(newVoice));
+    return true;
+}
+
+void SamplePreview::stop() { swapVoice(nullptr); }
+
+bool SamplePreview::isPlaying() const {
+    return voice != nullptr && !voice->isFinished();
+}
+
+bool SamplePreview::isBuffered() const {
+    return voice != nullptr && voice->isBuffered();
+}
+
+void SamplePreview::prefetch(const juce::Array<juce::File> &files) {
+    {
+        const juce::ScopedLock sl(headsLock);
+        // only the files around the latest selection are worth reading
+        prefetchQueue.assign(files.begin(), files.end());
+    }
+
+    readThread.moveToFrontOfQueue(this);
+}
+
+bool SamplePreview::hasHeadInMemory(const juce::File &file) const {
+    auto path = file.getFullPathName();
+    const juce::ScopedLock sl(headsLock);
+    return std::any_of(
+        heads.begin(), heads.end(),
+        [&path](const auto &head) { return head.first == path; });
+}
+
+void SamplePreview::audioDeviceIOCallbackWithContext(
+    const float *const *inputChannelData, int numInputChannels,
+    float *const *outputChannelData, int numOutputChannels, int numSamples,
+    const juce::AudioIODeviceCallbackContext &context) {
+    juce::ignoreUnused(inputChannelData, numInputChannels, context);
+
+    // the device manager mixes what extra callbacks write into the output
+    for (int i = 0; i < numOutputChannels; ++i)
+        if (outputChannelData[i] != nullptr)
+            juce::FloatVectorOperations::clear(outputChannelData[i],
+                                               numSamples);
+
+    const juce::SpinLock::ScopedTryLockType sl(voiceLock);
+    if (!sl.isLocked() || voice == nullptr || voice->isFinished())
+        return;
+
+    voice->render(outputChannelData, numOutputChannels, numSamples);
+}
+
+void SamplePreview::audioDeviceAboutToStart(juce::AudioIODevice *device) {
+    sampleRate = device->getCurrentSampleRate();
+    bufferSize = device->getCurrentBufferSizeSamples();
+}
+
+void SamplePreview::audioDeviceStopped() {}
+
+std::shared_ptr<const SamplePreview::Head>
+SamplePreview::getHead(const juce::File &file) {
+    if (auto head = findHead(file))
+        return head;
+
+    // not prefetched, read here so the preview still starts straight away
+    return readHead(file);
+}
+
+std::shared_ptr<const SamplePreview::Head>
+SamplePreview::findHead(const juce::File &file) {
+    auto path = file.getFullPathName();
+    auto size = file.getSize();
+    auto modificationTime = file.getLastModificationTime().toMilliseconds();
+
+    const juce::ScopedLock sl(headsLock);
+    for (auto cached = heads.begin(); cached != heads.end(); ++cached) {
+        if (cached->first != path)
+            continue;
+
+        auto head = cached->second;
+        heads.erase(cached);
+        if (head->size == size && head->modificationTime == modificationTime) {
+            heads.emplace_back(path, head);
+            return head;
+        }
+        break;
+    }
+
+    return nullptr;
+}
+
+std::shared_ptr<const SamplePreview::Head>
+SamplePreview::readHead(const juce::File &file) {
+    auto path = file.getFullPathName();
+    auto size = file.getSize();
+    auto modificationTime = file.getLastModificationTime().toMilliseconds();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->sampleRate <= 0.0 ||
+        reader->lengthInSamples <= 0)
+        return nullptr;
+
+    auto head = std::make_shared<Head>();
+    head->size = size;
+    head->modificationTime = modificationTime;
+    head->sampleRate = reader->sampleRate;
+    head->lengthInSamples = reader->lengthInSamples;
+
+    // mono files are read into both channels
+    auto numSamples = int(
+        juce::jmin(juce::int64(numHeadSamples), reader->lengthInSamples));
+    head->buffer.setSize(2, numSamples);
+    reader->read(&head->buffer, 0, numSamples, 0, true, true);
+
+    const juce::ScopedLock sl(headsLock);
+    // the other thread may have read the same file in the meantime
+    heads.erase(std::remove_if(heads.begin(), heads.end(),
+                               [&path](const auto &cached) {
+                                   return cached.first == path;
+                               }),
+                heads.end());
+    heads.emplace_back(path, head);
+    if (int(heads.size()) > numHeadsInMemory)
+        heads.erase(heads.begin());
+
+    return head;
+}
+
+int SamplePreview::useTimeSlice() {
+    juce::File file;
+    {
+        const juce::ScopedLock sl(headsLock);
+        if (prefetchQueue.empty())
+            return 500;
+
+        file = prefetchQueue.front();
+        prefetchQueue.pop_front();
+    }
+
+    if (findHead(file) == nullptr)
+        readHead(file);
+
+    return 0;
+}
+
+void SamplePreview::swapVoice(std::unique_ptr<Voice> newVoice) {
+    {
+        const juce::SpinLock::ScopedLockType sl(voiceLock);
+        std::swap(voice, newVoice);
+    }
+
+    // newVoice is the old one now, it is stopped and freed here rather than
+    // on the audio thread
+    if (newVoice != nullptr)
+        readThread.removeTimeSliceClient(newVoice.get());
+}
+
+} // namespace app_services
@@ -0,0 +1,104 @@
+#pragma once
+
+namespace app_services {
+
+// Auditions sample files on the audio device, outside of any edit.
+//
+// The preview registers itself as an extra callback on the device manager,
+// which mixes what it writes into the engine's output. A file starts playing
+// from its first few hundred milliseconds held in memory, kept for the files
+// auditioned most recently, while a reader on a background thread fills a
+// fifo with the rest. Files at another sample rate are resampled to the
+// device's.
+//
+// Heads can be prefetched, the read thread then reads them in the background
+// so a file next to the one being auditioned starts without being opened on
+// the message thread.
+//
+// Playing another file or stopping swaps the voice on the message thread,
+// and the audio thread drops the old one on its next block. The audio thread
+// never waits for the swap, if it can't take the voice it writes nothing for
+// that block.
+//
+// One preview is shared per device manager, the app keeps it for as long as
+// it runs and the sample browsers use it through getFor.
+class SamplePreview : public juce::AudioIODeviceCallback,
+                      private juce::TimeSliceClient {
+  public:
+    // what is read up front, about a third of a second at 44.1kHz
+    static constexpr int numHeadSamples = 16384;
+    static constexpr int numHeadsInMemory = 32;
+    // how far the background reader keeps ahead of playback
+    static constexpr int numSamplesToBuffer = 65536;
+
+    explicit SamplePreview(juce::AudioDeviceManager &dm);
+    ~SamplePreview() override;
+
+    // The preview playing on dm, created if nobody holds one yet
+    static std::shared_ptr<SamplePreview>
+    getFor(juce::AudioDeviceManager &dm);
+
+    // Plays file from the start, cutting off whatever played before. Returns
+    // false if no device is running or the file can't be read as audio.
+    bool play(const juce::File &file);
+    void stop();
+    bool isPlaying() const;
+
+    // Whether the reader has caught up, either with the end of the file or
+    // with a full fifo. False when nothing is playing.
+    bool isBuffered() const;
+
+    // Reads the heads of files on the read thread, in order, replacing any
+    // files still waiting from before
+    void prefetch(const juce::Array<juce::File> &files);
+
+    bool hasHeadInMemory(const juce::File &file) const;
+
+    void audioDeviceIOCallbackWithContext(
+        const float *const *inputChannelData, int numInputChannels,
+        float *const *outputChannelData, int numOutputChannels,
+        int numSamples,
+        const juce::AudioIODeviceCallbackContext &context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice *device) override;
+    void audioDeviceStopped() override;
+
+  private:
+    struct Head {
+        juce::int64 size = 0;
+        juce::int64 modificationTime = 0;
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+        juce::AudioBuffer<float> buffer;
+    };
+
+    class Voice;
+
+    juce::AudioDeviceManager &deviceManager;
+    juce::AudioFormatManager formatManager;
+    juce::TimeSliceThread readThread{"Sample Preview"};
+
+    // most recently used last, read on the message thread and filled from
+    // the read thread as well
+    juce::CriticalSection headsLock;
+    std::vector<std::pair<juce::String, std::shared_ptr<const Head>>> heads;
+    std::deque<juce::File> prefetchQueue;
+
+    // swapped on the message thread, rendered on the audio thread
+    juce::SpinLock voiceLock;
+    std::unique_ptr<Voice> voice;
+
+    // written when the device starts
+    std::atomic<double> sampleRate{0.0};
+    std::atomic<int> bufferSize{0};
+
+    std::shared_ptr<const Head> getHead(const juce::File &file);
+    std::shared_ptr<const Head> findHead(const juce::File &file);
+    std::shared_ptr<const Head> readHead(const juce::File &file);
+    void swapVoice(std::unique_ptr<Voice> newVoice);
+
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE(SamplePreview)
+};
+
+} // namespace app_services
@@ -0,0 +1,184 @@
+#include "TempoMap.h"
+
+namespace app_services {
+
+std::shared_ptr<TempoMap> TempoMap::getFor(tracktion::Edit &edit) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    static std::vector<std::weak_ptr<TempoMap>> maps;
+
+    std::shared_ptr<TempoMap> result;
+    for (auto it = maps.begin(); it != maps.end();) {
+        if (auto map = it->lock()) {
+            if (&map->getEdit() == &edit)
+                result = map;
+
+            ++it;
+        } else {
+            it = maps.erase(it);
+        }
+    }
+
+    if (result == nullptr) {
+        result = std::make_shared<TempoMap>(edit);
+        maps.push_back(result);
+    }
+
+    return result;
+}
+
+TempoMap::TempoMap(tracktion::Edit &e)
+    : edit(e), tempoSequenceState(edit.tempoSequence.getState()) {
+    tempoSequenceState.addListener(this);
+}
+
+TempoMap::~TempoMap() { tempoSequenceState.removeListener(this); }
+
+tracktion::BeatPosition TempoMap::toBeats(tracktion::TimePosition time) {
+    auto seconds = time.inSeconds();
+    auto &segment = findSegmentForSeconds(seconds);
+    return tracktion::BeatPosition::fromBeats(
+        segment.startBeats +
+        (seconds - segment.startSeconds) * segment.beatsPerSecond);
+}
+
+tracktion::TimePosition TempoMap::toTime(tracktion::BeatPosition beats) {
+    auto b = beats.inBeats();
+    auto &segment = findSegmentForBeats(b);
+    return tracktion::TimePosition::fromSeconds(
+        segment.startSeconds +
+        (b - segment.startBeats) / segment.beatsPerSecond);
+}
+
+double TempoMap::getBeatsPerSecondAt(tracktion::TimePosition time) {
+    return findSegmentForSeconds(time.inSeconds()).beatsPerSecond;
+}
+
+double TempoMap::getSecondsPerBeatAt(tracktion::TimePosition time) {
+    return 1.0 / getBeatsPerSecondAt(time);
+}
+
+tracktion::TimePosition TempoMap::getNextBeat(tracktion::TimePosition time) {
+    auto beats = toBeats(time).inBeats();
+    return toTime(tracktion::BeatPosition::fromBeats(
+        std::floor(beats + beatTolerance) + 1.0));
+}
+
+tracktion::TimePosition
+TempoMap::getPreviousBeat(tracktion::TimePosition time) {
+    auto beats = toBeats(time).inBeats();
+    return toTime(tracktion::BeatPosition::fromBeats(
+        juce::jmax(0.0, std::ceil(beats - beatTolerance) - 1.0)));
+}
+
+int TempoMap::getVersion() const { return version; }
+
+tracktion::Edit &TempoMap::getEdit() { return edit; }
+
+void TempoMap::rebuildIfNeeded() {
+    if (!needsRebuild)
+        return;
+
+    needsRebuild = false;
+    segments.clear();
+
+    auto &tempoSequence = edit.tempoSequence;
+
+    // every change of tempo or time signature starts a segment
+    juce::Array<double> boundaries;
+    boundaries.addUsingDefaultSort(0.0);
+    for (int i = 0; i < tempoSequence.getNumTempos(); ++i)
+        boundaries.addIfNotAlreadyThere(
+            tempoSequence.getTempo(i)->getStartBeat().inBeats());
+    for (int i = 0; i < tempoSequence.getNumTimeSigs(); ++i)
+        boundaries.addIfNotAlreadyThere(
+            tempoSequence.getTimeSig(i)->getStartBeat().inBeats());
+    boundaries.sort();
+
+    auto addSegment = [&](double startBeats) {
+        auto startSeconds =
+            tempoSequence
+                .toTime(tracktion::BeatPosition::fromBeats(startBeats))
+                .inSeconds();
+
+        // the rate of the previous segment is its average across it, which
+        // is what makes both ends of it exact
+        if (!segments.empty()) {
+            auto &previous = segments.back();
+            if (startSeconds > previous.startSeconds)
+                previous.beatsPerSecond =
+                    (startBeats - previous.startBeats) /
+                    (startSeconds - previous.startSeconds);
+        }
+
+        segments.push_back(
+            {startSeconds, startBeats,
+             tempoSequence.getBeatsPerSecondAt(
+                 tracktion::TimePosition::fromSeconds(startSeconds))});
+    };
+
+    for (int i = 0; i < boundaries.size(); ++i) {
+        auto start = boundaries[i];
+        addSegment(start);
+
+        if (i + 1 == boundaries.size())
+            break;
+
+        // a tempo that ramps towards the next one is split at every beat so
+        // the lookup stays close to the curve in between
+        auto end = boundaries[i + 1];
+        auto endRate = tempoSequence.getBeatsPerSecondAt(
+            tempoSequence.toTime(tracktion::BeatPosition::fromBeats(end)) -
+            tracktion::TimeDuration::fromSeconds(beatTolerance));
+        if (std::abs(endRate - segments.back().beatsPerSecond) > 1e-9)
+            for (auto beat = std::floor(start) + 1.0; beat < end; beat += 1.0)
+                addSegment(beat);
+    }
+}
+
+const TempoMap::Segment &TempoMap::findSegmentForSeconds(double seconds) {
+    rebuildIfNeeded();
+
+    auto it = std::upper_bound(segments.begin() + 1, segments.end(), seconds,
+                               [](double s, const Segment &segment) {
+                                   return s < segment.startSeconds;
+                               });
+    return *(it - 1);
+}
+
+const TempoMap::Segment &TempoMap::findSegmentForBeats(double beats) {
+    rebuildIfNeeded();
+
+    auto it = std::upper_bound(segments.begin() + 1, segments.end(), beats,
+                               [](double b, const Segment &segment) {
+                                   return b < segment.startBeats;
+                               });
+    return *(it - 1);
+}
+
+void TempoMap::invalidate() {
+    if (!needsRebuild) {
+        needsRebuild = true;
+        version++;
+    }
+}
+
+void TempoMap::valueTreePropertyChanged(juce::ValueTree &,
+                                        const juce::Identifier &) {
+    invalidate();
+}
+
+void TempoMap::valueTreeChildAdded(juce::ValueTree &, juce::ValueTree &) {
+    invalidate();
+}
+
+void TempoMap::valueTreeChildRemoved(juce::ValueTree &, juce::ValueTree &,
+                                     int) {
+    invalidate();
+}
+
+void TempoMap::valueTreeChildOrderChanged(juce::ValueTree &, int, int) {
+    invalidate();
+}
+
+} // namespace app_services
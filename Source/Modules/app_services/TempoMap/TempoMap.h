@@ -0,0 +1,74 @@
+#pragma once
+
+namespace app_services {
+
+// A cached snapshot of an edit's tempo sequence for converting between time
+// and beats.
+//
+// The tempo sequence is reduced to a sorted list of segments over which beats
+// advance at a constant rate, so a conversion is a binary search and a
+// multiply. Segment boundaries are taken from the tempo sequence itself at
+// every tempo and time signature change, and ramps are split at every beat.
+// The snapshot is rebuilt on the next query after the tempo sequence changes,
+// and the version is bumped so callers can tell their own derived data is
+// out of date.
+//
+// One map is shared per edit, the timeline, the clips and the step sequencer
+// all ask for the same one. It is only used on the message thread.
+class TempoMap : private juce::ValueTree::Listener {
+  public:
+    // Returns the map for the edit, creating it if needed. It goes away once
+    // nobody holds on to it.
+    static std::shared_ptr<TempoMap> getFor(tracktion::Edit &edit);
+
+    explicit TempoMap(tracktion::Edit &e);
+    ~TempoMap() override;
+
+    tracktion::BeatPosition toBeats(tracktion::TimePosition time);
+    tracktion::TimePosition toTime(tracktion::BeatPosition beats);
+
+    double getBeatsPerSecondAt(tracktion::TimePosition time);
+    double getSecondsPerBeatAt(tracktion::TimePosition time);
+
+    // The whole beat after or before the given time, a time already on a
+    // beat moves a full beat
+    tracktion::TimePosition getNextBeat(tracktion::TimePosition time);
+    tracktion::TimePosition getPreviousBeat(tracktion::TimePosition time);
+
+    // Changes every time the tempo sequence does
+    int getVersion() const;
+
+    tracktion::Edit &getEdit();
+
+  private:
+    struct Segment {
+        double startSeconds;
+        double startBeats;
+        double beatsPerSecond;
+    };
+
+    tracktion::Edit &edit;
+    juce::ValueTree tempoSequenceState;
+    std::vector<Segment> segments;
+    bool needsRebuild = true;
+    int version = 0;
+
+    // a time this close to a beat counts as being on it
+    static constexpr double beatTolerance = 1e-6;
+
+    void rebuildIfNeeded();
+    const Segment &findSegmentForSeconds(double seconds);
+    const Segment &findSegmentForBeats(double beats);
+
+    void invalidate();
+    void valueTreePropertyChanged(juce::ValueTree &tree,
+                                  const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parent,
+                             juce::ValueTree &child) override;
+    void valueTreeChildRemoved(juce::ValueTree &parent, juce::ValueTree &child,
+                               int indexFromWhichChildWasRemoved) override;
+    void valueTreeChildOrderChanged(juce::ValueTree &parent, int oldIndex,
+                                    int newIndex) override;
+};
+
+} // namespace app_services
@@ -0,0 +1,109 @@
+#include "UndoHistoryManager.h"
+
+namespace app_services {
+
+UndoHistoryManager::UndoHistoryManager(tracktion::Edit &e,
+                                       MidiCommandManager &mcm,
+                                       int limit)
+    : edit(e), midiCommandManager(mcm), memoryLimit(limit) {
+    setMemoryLimit(memoryLimit);
+    midiCommandManager.addListener(this);
+    startTimer(timerIntervalMs);
+}
+
+UndoHistoryManager::~UndoHistoryManager() {
+    stopTimer();
+    midiCommandManager.removeListener(this);
+    inhibitor = nullptr;
+}
+
+void UndoHistoryManager::setMemoryLimit(int newMemoryLimit) {
+    memoryLimit = juce::jmax(1, newMemoryLimit);
+    // the undo manager drops the oldest transactions until it is back under
+    // the limit
+    edit.getUndoManager().setMaxNumberOfStoredUnits(
+        memoryLimit, minimumTransactionsToKeep);
+}
+
+int UndoHistoryManager::getMemoryLimit() const { return memoryLimit; }
+
+int UndoHistoryManager::getMemoryUsage() const {
+    return edit.getUndoManager().getNumberOfUnitsTakenUpByStoredCommands();
+}
+
+void UndoHistoryManager::gestureStep(int gestureId) {
+    lastGestureStepTime = juce::Time::getMillisecondCounter();
+    if (isGestureActive() && gestureId == currentGestureId)
+        return;
+
+    endGesture();
+
+    // the gesture gets a transaction of its own, and the inhibitor keeps the
+    // edit from starting new ones every time the steps pause briefly
+    edit.getUndoManager().beginNewTransaction();
+    inhibitor =
+        std::make_unique<tracktion::Edit::UndoTransactionInhibitor>(edit);
+    currentGestureId = gestureId;
+}
+
+void UndoHistoryManager::endGesture() {
+    if (!isGestureActive())
+        return;
+
+    inhibitor = nullptr;
+    currentGestureId = -1;
+    edit.getUndoManager().beginNewTransaction();
+}
+
+bool UndoHistoryManager::isGestureActive() const {
+    return inhibitor != nullptr;
+}
+
+void UndoHistoryManager::controllerEventReceived(int controllerNumber,
+                                                 int controllerValue,
+                                                 int channel) {
+    juce::ignoreUnused(controllerValue);
+
+    // this is called before the focused view handles the message, so the
+    // change the step makes already lands in the gesture's transaction. The
+    // command comes from the mapping, so remapped encoders count too.
+    auto command =
+        midiCommandManager.getCommandForController(controllerNumber, channel);
+    if (isEncoder(command))
+        gestureStep(int(command));
+    else
+        endGesture();
+}
+
+void UndoHistoryManager::timerCallback() {
+    if (isGestureActive() && juce::Time::getMillisecondCounter() -
+                                     lastGestureStepTime >=
+                                 juce::uint32(gestureTimeoutMs))
+        endGesture();
+
+    if (++ticksSinceLog >= ticksPerLog) {
+        ticksSinceLog = 0;
+        logMemoryUsage();
+    }
+}
+
+void UndoHistoryManager::logMemoryUsage() {
+    auto usage = getMemoryUsage();
+    if (usage == lastLoggedUsage)
+        return;
+
+    lastLoggedUsage = usage;
+    juce::Logger::writeToLog(
+        "Undo history: " + juce::String(usage / 1024.0, 1) + " of " +
+        juce::String(memoryLimit / 1024.0, 1) + " KB in " +
+        juce::String(edit.getUndoManager().getUndoDescriptions().size()) +
+        " transactions");
+}
+
+bool UndoHistoryManager::isEncoder(MidiCommandManager::Command command) {
+    using Command = MidiCommandManager::Command;
+    return command == Command::encoder1 || command == Command::encoder2 ||
+           command == Command::encoder3 || command == Command::encoder4;
+}
+
+} // namespace app_services
@@ -0,0 +1,65 @@
+#pragma once
+
+namespace app_services {
+
+// Keeps the edit's undo history useful and bounded.
+//
+// Turning an encoder sends one step per detent and every step changes a
+// value, so without help a single sweep of a volume or plugin knob ends up
+// spread over many undo transactions. The manager watches the encoder
+// messages and treats a run of steps on the same encoder as one gesture: new
+// transactions are held off while it lasts and one is started when it ends, so
+// the whole sweep undoes in one go. Any button press, another encoder or a
+// pause ends the gesture.
+//
+// The undo manager is limited to the configured amount of memory, the oldest
+// transactions are dropped first once it is reached. The usage is measured in
+// the undo manager's units, which are an approximation of the bytes held by
+// the stored actions, and is written to the log every minute when it changed.
+class UndoHistoryManager : public MidiCommandManager::Listener,
+                           private juce::Timer {
+  public:
+    static constexpr int defaultMemoryLimit = 1024 * 1024;
+
+    UndoHistoryManager(tracktion::Edit &e, MidiCommandManager &mcm,
+                       int memoryLimit = defaultMemoryLimit);
+    ~UndoHistoryManager() override;
+
+    void setMemoryLimit(int newMemoryLimit);
+    int getMemoryLimit() const;
+    int getMemoryUsage() const;
+
+    // Steps with the same gesture id that follow each other within
+    // gestureTimeoutMs are kept in one undo transaction
+    void gestureStep(int gestureId);
+    void endGesture();
+    bool isGestureActive() const;
+
+    void controllerEventReceived(int controllerNumber, int controllerValue,
+                                 int channel) override;
+
+    static constexpr int gestureTimeoutMs = 500;
+
+  private:
+    tracktion::Edit &edit;
+    MidiCommandManager &midiCommandManager;
+    int memoryLimit;
+
+    std::unique_ptr<tracktion::Edit::UndoTransactionInhibitor> inhibitor;
+    int currentGestureId = -1;
+    juce::uint32 lastGestureStepTime = 0;
+
+    int lastLoggedUsage = -1;
+    int ticksSinceLog = 0;
+
+    static constexpr int timerIntervalMs = 100;
+    static constexpr int ticksPerLog = 600;
+    // the transactions that are always kept, however large they are
+    static constexpr int minimumTransactionsToKeep = 1;
+
+    void timerCallback() override;
+    void logMemoryUsage();
+    static bool isEncoder(MidiCommandManager::Command command);
+};
+
+} // namespace app_services
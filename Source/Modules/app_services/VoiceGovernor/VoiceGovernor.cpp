@@ -0,0 +1,290 @@
+#include "VoiceGovernor.h"
+
+namespace app_services {
+
+// governors are looked up by edit so the oscillator view models, which only
+// know their plugin, can reach the state of the one running for it
+static std::vector<VoiceGovernor *> &getGovernors() {
+    static std::vector<VoiceGovernor *> governors;
+    return governors;
+}
+
+VoiceGovernor::VoiceGovernor(tracktion::Edit &e) : edit(e) {
+    getGovernors().push_back(this);
+    startTimer(timerIntervalMs);
+}
+
+VoiceGovernor::ScopedRequestedValues::ScopedRequestedValues(
+    tracktion::Edit &edit)
+    : governor(getFor(edit)) {
+    if (governor != nullptr) {
+        governor->numRequestedValueScopes++;
+        governor->applyLimits();
+    }
+}
+
+VoiceGovernor::ScopedRequestedValues::~ScopedRequestedValues() {
+    if (governor != nullptr) {
+        governor->numRequestedValueScopes--;
+        governor->applyLimits();
+    }
+}
+
+VoiceGovernor::~VoiceGovernor() {
+    stopTimer();
+
+    // hand the plugins back exactly as the user set them
+    severity = 0;
+    applyLimits();
+    releaseTrackLevels();
+
+    auto &governors = getGovernors();
+    governors.erase(std::remove(governors.begin(), governors.end(), this),
+                    governors.end());
+}
+
+void VoiceGovernor::update(double cpuLoad) {
+    // readings are noisy from one callback to the next, so smooth them a
+    // little before acting on them
+    smoothedLoad += (cpuLoad - smoothedLoad) * .5;
+
+    int previousSeverity = severity;
+    if (smoothedLoad > highLoad) {
+        ticksBelowLowLoad = 0;
+        if (severity < maxSeverity)
+            severity++;
+    } else if (smoothedLoad < lowLoad) {
+        // only give voices back once the load has stayed down for a while,
+        // otherwise the limit would flap on every other tick
+        ticksBelowLowLoad++;
+        if (ticksBelowLowLoad >= recoveryTicks && severity > 0) {
+            severity--;
+            ticksBelowLowLoad = 0;
+        }
+    } else {
+        ticksBelowLowLoad = 0;
+    }
+
+    if (severity != previousSeverity)
+        juce::Logger::writeToLog(
+            "Voice governor severity changed from " +
+            juce::String(previousSeverity) + " to " + juce::String(severity) +
+            " at " + juce::String(smoothedLoad * 100.0, 1) + "% load");
+
+    // limits are applied on every reading so 4OSC instances that were just
+    // added and level changes are picked up too
+    applyLimits();
+}
+
+int VoiceGovernor::getSeverity() const { return severity; }
+
+VoiceGovernor::Limit VoiceGovernor::getLimitForSeverity(int s) {
+    // a limit of 0 means the user's values are played as they are
+    static constexpr Limit limits[maxSeverity + 1] = {
+        {0, 0}, {16, 4}, {8, 2}, {4, 2}, {2, 1}};
+    return limits[juce::jlimit(0, maxSeverity, s)];
+}
+
+int VoiceGovernor::getUnisonLimit(tracktion::FourOscPlugin &plugin) {
+    if (auto state = getState(plugin))
+        if (state->limit.unison > 0)
+            return state->limit.unison;
+
+    return maxUnison;
+}
+
+bool VoiceGovernor::isLimited(tracktion::FourOscPlugin &plugin) {
+    auto state = getState(plugin);
+    return state != nullptr && state->limit.unison > 0;
+}
+
+int VoiceGovernor::getRequestedUnison(tracktion::FourOscPlugin &plugin,
+                                      int oscIndex) {
+    auto &value = plugin.oscParams[oscIndex]->voicesValue;
+    if (auto state = getState(plugin))
+        return state->requestedUnison[size_t(oscIndex)].value_or(value.get());
+
+    return value.get();
+}
+
+void VoiceGovernor::setRequestedUnison(tracktion::FourOscPlugin &plugin,
+                                       int oscIndex, int voices) {
+    auto &value = plugin.oscParams[oscIndex]->voicesValue;
+    voices = juce::jlimit(1, maxUnison, voices);
+
+    if (!isLimited(plugin)) {
+        if (auto state = getState(plugin))
+            state->requestedUnison[size_t(oscIndex)].reset();
+
+        value.setValue(voices, nullptr);
+        return;
+    }
+
+    // the journal records what the user asked for before the limit goes
+    // back in unrecorded, the synth only sees it for a moment
+    getState(plugin)->requestedUnison[size_t(oscIndex)] = voices;
+    value.setValue(voices, nullptr);
+
+    const EditJournal::ScopedUnrecordedChanges unrecorded;
+    value.setValue(juce::jmin(voices, getUnisonLimit(plugin)), nullptr);
+}
+
+void VoiceGovernor::timerCallback() {
+    update(edit.engine.getDeviceManager().getCpuUsage());
+}
+
+void VoiceGovernor::applyLimits() {
+    updateTrackLevels();
+
+    std::vector<std::pair<float, tracktion::FourOscPlugin *>> instances;
+    for (auto plugin : tracktion::getAllPlugins(edit, false))
+        if (auto fourOsc = dynamic_cast<tracktion::FourOscPlugin *>(plugin))
+            instances.emplace_back(getLevel(*fourOsc), fourOsc);
+
+    // forget plugins that have been removed from the edit
+    for (auto it = pluginStates.begin(); it != pluginStates.end();) {
+        bool isInEdit = std::any_of(
+            instances.begin(), instances.end(),
+            [&it](const auto &i) { return i.second->itemID == it->first; });
+        it = isInEdit ? std::next(it) : pluginStates.erase(it);
+    }
+
+    if (instances.empty())
+        return;
+
+    std::stable_sort(
+        instances.begin(), instances.end(),
+        [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    // the quieter half takes the full severity, the louder half is held one
+    // step behind so the parts that are heard the most degrade last
+    int applied = numRequestedValueScopes > 0 ? 0 : severity;
+    auto numQuietInstances = (instances.size() + 1) / 2;
+    for (size_t i = 0; i < instances.size(); ++i)
+        applyLimit(*instances[i].second,
+                   i < numQuietInstances ? applied
+                                         : juce::jmax(0, applied - 1));
+}
+
+void VoiceGovernor::updateTrackLevels() {
+    std::map<tracktion::EditItemID, std::unique_ptr<TrackLevel>> levels;
+    for (auto track : tracktion::getAudioTracks(edit)) {
+        auto levelMeter = track->getLevelMeterPlugin();
+        if (levelMeter == nullptr)
+            continue;
+
+        auto &level = levels[track->itemID];
+        auto existing = trackLevels.find(track->itemID);
+        if (existing != trackLevels.end() &&
+            existing->second->levelMeter.get() == levelMeter) {
+            level = std::move(existing->second);
+        } else {
+            level = std::make_unique<TrackLevel>();
+            level->levelMeter = levelMeter;
+            level->levelDb = silenceDb;
+            levelMeter->measurer.addClient(level->client);
+        }
+
+        // the loudest the track got since the last tick, falling off slowly
+        // so a track between two notes does not count as silent
+        float peakDb = silenceDb;
+        for (int channel = 0; channel < 2; ++channel)
+            peakDb = juce::jmax(
+                peakDb, level->client.getAndClearAudioLevel(channel).dB);
+
+        level->levelDb = juce::jmax(peakDb, level->levelDb - levelDecayDb);
+    }
+
+    releaseTrackLevels();
+    trackLevels = std::move(levels);
+}
+
+void VoiceGovernor::releaseTrackLevels() {
+    // levels still here belong to tracks or meters that went away
+    for (auto &entry : trackLevels)
+        if (entry.second != nullptr)
+            entry.second->levelMeter->measurer.removeClient(
+                entry.second->client);
+
+    trackLevels.clear();
+}
+
+void VoiceGovernor::applyLimit(tracktion::FourOscPlugin &plugin, int s) {
+    auto limit = getLimitForSeverity(s);
+    auto &state = pluginStates[plugin.itemID];
+    state.limit = limit;
+
+    applyRequestedValue(state.requestedPolyphony, plugin.voicesValue,
+                        limit.polyphony);
+
+    for (int i = 0; i < juce::jmin(plugin.oscParams.size(), numOscillators);
+         ++i)
+        applyRequestedValue(state.requestedUnison[size_t(i)],
+                            plugin.oscParams[i]->voicesValue, limit.unison);
+
+    if (s == 0)
+        pluginStates.erase(plugin.itemID);
+}
+
+void VoiceGovernor::applyRequestedValue(std::optional<int> &requested,
+                                        juce::CachedValue<int> &value,
+                                        int limit) {
+    // the journal keeps the values the user asked for
+    const EditJournal::ScopedUnrecordedChanges unrecorded;
+
+    if (limit <= 0) {
+        // lifting the limit restores what the user asked for
+        if (requested.has_value()) {
+            value.setValue(*requested, nullptr);
+            requested.reset();
+        }
+
+        return;
+    }
+
+    if (!requested.has_value())
+        requested = value.get();
+
+    int applied = juce::jmin(*requested, limit);
+    if (value.get() != applied)
+        value.setValue(applied, nullptr);
+}
+
+float VoiceGovernor::getLevel(tracktion::FourOscPlugin &plugin) {
+    // the voices inside the synth cannot be reached from here, so the level
+    // the track's meter measured stands in for how loud they are. Muted
+    // tracks and plugins that are not on a track count as silent.
+    auto audioTrack =
+        dynamic_cast<tracktion::AudioTrack *>(plugin.getOwnerTrack());
+    if (audioTrack == nullptr || audioTrack->isMuted(true))
+        return silenceDb;
+
+    auto level = trackLevels.find(audioTrack->itemID);
+    if (level == trackLevels.end())
+        return silenceDb;
+
+    return level->second->levelDb;
+}
+
+VoiceGovernor *VoiceGovernor::getFor(tracktion::Edit &edit) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    for (auto governor : getGovernors())
+        if (&governor->edit == &edit)
+            return governor;
+
+    return nullptr;
+}
+
+VoiceGovernor::PluginState *
+VoiceGovernor::getState(tracktion::FourOscPlugin &plugin) {
+    if (auto governor = getFor(plugin.edit)) {
+        auto state = governor->pluginStates.find(plugin.itemID);
+        if (state != governor->pluginStates.end())
+            return &state->second;
+    }
+
+    return nullptr;
+}
+
+} // namespace app_services
@@ -0,0 +1,116 @@
+#pragma once
+
+namespace app_services {
+
+// Watches the audio callback load and caps the polyphony and unison of every
+// 4OSC instance in the edit when the device is running out of headroom.
+//
+// The governor works in severity steps. Each step up halves what the synths
+// are allowed to play, and each step down restores it after the load has
+// stayed low for a while. Voices are not stolen one by one, the synth does
+// not expose them. Instead whole instances are ranked by the level their
+// track's meter measured since the last tick, and at any severity the louder
+// half is held one step behind the quieter half, so the quietest tracks are
+// limited first.
+//
+// The synth only reads its voice counts from the plugin state, so the limits
+// have to be written there. The values the user asked for are kept here
+// meanwhile. Saving the edit and journal checkpoints put them back for as
+// long as they write, and the limits are written without being recorded by
+// the journal, so neither the edit file nor a recovered edit ever has the
+// limited values. Lifting a limit, which also happens when the governor is
+// destroyed, puts the sound back exactly as it was.
+class VoiceGovernor : private juce::Timer {
+  public:
+    struct Limit {
+        int polyphony;
+        int unison;
+    };
+
+    // Puts the values the user asked for back into the plugins of an edit
+    // while it exists, then applies the limits again. Does nothing if no
+    // governor is running for the edit.
+    class ScopedRequestedValues {
+      public:
+        explicit ScopedRequestedValues(tracktion::Edit &edit);
+        ~ScopedRequestedValues();
+
+      private:
+        VoiceGovernor *governor;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedRequestedValues)
+    };
+
+    explicit VoiceGovernor(tracktion::Edit &e);
+    ~VoiceGovernor() override;
+
+    // Feeds one callback load reading between 0 and 1 and applies the
+    // resulting limits. This is called from the timer with the device load.
+    void update(double cpuLoad);
+
+    int getSeverity() const;
+
+    static constexpr int maxSeverity = 4;
+    static constexpr int maxUnison = 8;
+    static Limit getLimitForSeverity(int severity);
+
+    // The unison limit currently applied to a plugin, maxUnison if none is.
+    // These look up the governor running for the plugin's edit, without one
+    // the plugin is never limited.
+    static int getUnisonLimit(tracktion::FourOscPlugin &plugin);
+    static bool isLimited(tracktion::FourOscPlugin &plugin);
+
+    // Unison as the user set it, which may be more than is being played
+    static int getRequestedUnison(tracktion::FourOscPlugin &plugin,
+                                  int oscIndex);
+    static void setRequestedUnison(tracktion::FourOscPlugin &plugin,
+                                   int oscIndex, int voices);
+
+  private:
+    static constexpr int numOscillators = 4;
+
+    struct PluginState {
+        Limit limit{0, 0};
+        std::optional<int> requestedPolyphony;
+        std::array<std::optional<int>, numOscillators> requestedUnison;
+    };
+
+    struct TrackLevel {
+        juce::ReferenceCountedObjectPtr<tracktion::LevelMeterPlugin>
+            levelMeter;
+        tracktion::LevelMeasurer::Client client;
+        float levelDb;
+    };
+
+    tracktion::Edit &edit;
+    double smoothedLoad = 0.0;
+    int severity = 0;
+    int ticksBelowLowLoad = 0;
+    int numRequestedValueScopes = 0;
+    std::map<tracktion::EditItemID, PluginState> pluginStates;
+    std::map<tracktion::EditItemID, std::unique_ptr<TrackLevel>> trackLevels;
+
+    static constexpr int timerIntervalMs = 250;
+    static constexpr double highLoad = .8;
+    static constexpr double lowLoad = .5;
+    // how many timer ticks the load has to stay low before a step is lifted
+    static constexpr int recoveryTicks = 8;
+    static constexpr float silenceDb = -100.0f;
+    // how far a track's level falls per tick once it gets quieter
+    static constexpr float levelDecayDb = 3.0f;
+
+    void timerCallback() override;
+    void applyLimits();
+    void updateTrackLevels();
+    void releaseTrackLevels();
+
+    void applyLimit(tracktion::FourOscPlugin &plugin, int severity);
+    static void applyRequestedValue(std::optional<int> &requested,
+                                    juce::CachedValue<int> &value, int limit);
+    float getLevel(tracktion::FourOscPlugin &plugin);
+
+    static VoiceGovernor *getFor(tracktion::Edit &edit);
+    static PluginState *getState(tracktion::FourOscPlugin &plugin);
+};
+
+} // namespace app_services
@@ -5,4 +5,37 @@
 #include "MidiCommandManager/MidiCommandManager.cpp"
 
 // TimelineCamera
-#include "TimelineCamera/TimelineCamera.cpp"
\ No newline at end of file
+#include "TimelineCamera/TimelineCamera.cpp"
+
+// VoiceGovernor
+#include "VoiceGovernor/VoiceGovernor.cpp"
+
+// AudioCallbackMonitor
+#include "AudioCallbackMonitor/AudioCallbackMonitor.cpp"
+
+// UndoHistory
+#include "UndoHistory/UndoHistoryManager.cpp"
+
+// EditCache
+#include "EditCache/EditCache.cpp"
+
+// EditJournal
+#include "EditJournal/EditJournal.cpp"
+
+// TempoMap
+#include "TempoMap/TempoMap.cpp"
+
+// LatencyProbe
+#include "LatencyProbe/LatencyProbe.cpp"
+
+// Logging
+#include "Logging/AsyncLogger.cpp"
+
+// BootPipeline
+#include "BootPipeline/BootPipeline.cpp"
+
+// DeviceSetup
+#include "DeviceSetup/DeviceSetupStore.cpp"
+
+// SamplePreview
+#include "SamplePreview/SamplePreview.cpp"
@@ -8,7 +8,7 @@
   description:      Service classes for app
   website:          http://github.com/stonepreston
   license:          GPL-3.0
-  dependencies:     juce_data_structures juce_events juce_core juce_graphics juce_gui_basics tracktion_engine
+  dependencies:     juce_audio_devices juce_data_structures juce_events juce_core juce_graphics juce_gui_basics tracktion_engine
  END_JUCE_MODULE_DECLARATION
 *******************************************************************************/
 
@@ -18,15 +18,36 @@ namespace app_services {
 
     class MidiCommandManager;
     class TimelineCamera;
+    class VoiceGovernor;
+    class AudioCallbackMonitor;
+    class UndoHistoryManager;
+    class EditCache;
+    class EditJournal;
+    class TempoMap;
+    class LatencyProbe;
+    class AsyncLogger;
+    class BootPipeline;
+    class DeviceSetupStore;
+    class SamplePreview;
 
 }
 
+#include <juce_audio_devices/juce_audio_devices.h>
 #include <juce_data_structures/juce_data_structures.h>
 #include <juce_events/juce_events.h>
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <deque>
 #include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
 
 // MidiCommandManager
 #include "MidiCommandManager/MidiCommandManager.h"
@@ -34,3 +55,36 @@ namespace app_services {
 
 // TimelineCamera
 #include "TimelineCamera/TimelineCamera.h"
+
+// VoiceGovernor
+#include "VoiceGovernor/VoiceGovernor.h"
+
+// AudioCallbackMonitor
+#include "AudioCallbackMonitor/AudioCallbackMonitor.h"
+
+// UndoHistory
+#include "UndoHistory/UndoHistoryManager.h"
+
+// EditCache
+#include "EditCache/EditCache.h"
+
+// EditJournal
+#include "EditJournal/EditJournal.h"
+
+// TempoMap
+#include "TempoMap/TempoMap.h"
+
+// LatencyProbe
+#include "LatencyProbe/LatencyProbe.h"
+
+// Logging
+#include "Logging/AsyncLogger.h"
+
+// BootPipeline
+#include "BootPipeline/BootPipeline.h"
+
+// DeviceSetup
+#include "DeviceSetup/DeviceSetupStore.h"
+
+// SamplePreview
+#include "SamplePreview/SamplePreview.h"
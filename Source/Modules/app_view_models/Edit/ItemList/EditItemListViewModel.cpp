@@ -6,12 +6,17 @@ EditItemListViewModel::EditItemListViewModel(
     juce::ValueTree stateToListenTo, juce::ValueTree parent,
     juce::Array<juce::Identifier> identifiersOfInterest, EditItemListAdapter *a)
     : stateToListenToForChildChanges(stateToListenTo),
+      dispatcher(ValueTreeChangeDispatcher::getFor(stateToListenTo)),
       childIdentifiersOfInterest(identifiersOfInterest), adapter(a),
       itemListState(parent, adapter->size()) {
-    stateToListenToForChildChanges.addListener(this);
+    dispatcher->addChildListener(this, stateToListenToForChildChanges);
+    dispatcher->addPropertyListener(
+        this, tracktion::IDs::enabled,
+        ValueTreeChangeDispatcher::Filter::within(
+            stateToListenToForChildChanges));
 }
 EditItemListViewModel::~EditItemListViewModel() {
-    stateToListenToForChildChanges.removeListener(this);
+    dispatcher->removeListener(this);
 }
 
 EditItemListAdapter *EditItemListViewModel::getAdapter() { return adapter; }
@@ -35,6 +35,9 @@ class EditItemListViewModel : public juce::ValueTree::Listener,
     // for plugins this is the track state
     // for modifiers this is the track state
     juce::ValueTree stateToListenToForChildChanges;
+    // routes only the child and enabled changes below that state to us
+    // instead of everything that happens in the edit
+    std::shared_ptr<ValueTreeChangeDispatcher> dispatcher;
     // this is used to check for a match in child added/removed
     juce::Array<juce::Identifier> childIdentifiersOfInterest;
     EditItemListAdapter *adapter;
@@ -2,21 +2,71 @@
 
 namespace app_view_models {
 
-TracksListAdapter::TracksListAdapter(tracktion::Edit &e) : edit(e) {}
+TracksListAdapter::TracksListAdapter(tracktion::Edit &e)
+    : edit(e), editState(edit.state),
+      dispatcher(ValueTreeChangeDispatcher::getFor(editState)) {
+    // the edit's own track list listens to the same tree and was registered
+    // before the dispatcher, so by the time a change gets here the track
+    // objects are up to date
+    dispatcher->addChildListener(this, editState);
+    dispatcher->addPropertyListener(
+        this, tracktion::IDs::name,
+        ValueTreeChangeDispatcher::Filter::ofType(tracktion::IDs::TRACK));
+}
 
-juce::StringArray TracksListAdapter::getItemNames() {
-    juce::StringArray itemNames;
-    for (auto track : tracktion::getAudioTracks(edit)) {
-        itemNames.add(track->getName());
-    }
+TracksListAdapter::~TracksListAdapter() { dispatcher->removeListener(this); }
 
-    return itemNames;
+juce::StringArray TracksListAdapter::getItemNames() {
+    updateCacheIfNeeded();
+    return trackNames;
 }
 
-int TracksListAdapter::size() { return tracktion::getAudioTracks(edit).size(); }
+int TracksListAdapter::size() {
+    updateCacheIfNeeded();
+    return tracks.size();
+}
 
 tracktion::EditItem *TracksListAdapter::getItemAtIndex(int index) {
-    return tracktion::getAudioTracks(edit)[index];
+    updateCacheIfNeeded();
+    return tracks[index];
+}
+
+void TracksListAdapter::updateCacheIfNeeded() {
+    if (cacheIsValid)
+        return;
+
+    tracks = tracktion::getAudioTracks(edit);
+    trackNames.clearQuick();
+    for (auto track : tracks)
+        trackNames.add(track->getName());
+
+    cacheIsValid = true;
+}
+
+void TracksListAdapter::valueTreePropertyChanged(
+    juce::ValueTree &treeWhosePropertyHasChanged,
+    const juce::Identifier &property) {
+    // only track renames are routed here
+    cacheIsValid = false;
+}
+
+void TracksListAdapter::valueTreeChildAdded(
+    juce::ValueTree &parentTree, juce::ValueTree &childWhichHasBeenAdded) {
+    if (tracktion::TrackList::isTrack(childWhichHasBeenAdded))
+        cacheIsValid = false;
+}
+
+void TracksListAdapter::valueTreeChildRemoved(
+    juce::ValueTree &parentTree, juce::ValueTree &childWhichHasBeenRemoved,
+    int indexFromWhichChildWasRemoved) {
+    if (tracktion::TrackList::isTrack(childWhichHasBeenRemoved))
+        cacheIsValid = false;
+}
+
+void TracksListAdapter::valueTreeChildOrderChanged(juce::ValueTree &parentTree,
+                                                   int oldIndex,
+                                                   int newIndex) {
+    cacheIsValid = false;
 }
 
 } // namespace app_view_models
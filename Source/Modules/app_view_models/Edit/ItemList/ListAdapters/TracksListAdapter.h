@@ -2,9 +2,16 @@
 
 namespace app_view_models {
 
-class TracksListAdapter : public EditItemListAdapter {
+// The tracks and their names are cached so lookups do not walk the edit every
+// time, the cache is rebuilt on the next query after a track is added,
+// removed, moved or renamed. Only those changes are routed here, through the
+// edit's ValueTreeChangeDispatcher. The app keeps its tracks at the top of
+// the edit, tracks inside folder tracks are not watched.
+class TracksListAdapter : public EditItemListAdapter,
+                          private juce::ValueTree::Listener {
   public:
     TracksListAdapter(tracktion::Edit &e);
+    ~TracksListAdapter() override;
 
     juce::StringArray getItemNames() override;
     int size() override;
@@ -12,6 +19,24 @@ class TracksListAdapter : public EditItemListAdapter {
 
   private:
     tracktion::Edit &edit;
+    juce::ValueTree editState;
+    std::shared_ptr<ValueTreeChangeDispatcher> dispatcher;
+
+    juce::Array<tracktion::AudioTrack *> tracks;
+    juce::StringArray trackNames;
+    bool cacheIsValid = false;
+
+    void updateCacheIfNeeded();
+
+    void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
+                                  const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parentTree,
+                             juce::ValueTree &childWhichHasBeenAdded) override;
+    void valueTreeChildRemoved(juce::ValueTree &parentTree,
+                               juce::ValueTree &childWhichHasBeenRemoved,
+                               int indexFromWhichChildWasRemoved) override;
+    void valueTreeChildOrderChanged(juce::ValueTree &parentTree,
+                                    int oldIndex, int newIndex) override;
 };
 
 } // namespace app_view_models
@@ -8,15 +8,27 @@ MixerTrackViewModel::MixerTrackViewModel(tracktion::Track::Ptr t)
         // For some reason listening to the track state does not work for the
         // master track Probably since the master track is not a "real" track
         // like the audio tracks are Must listen to the edit instead.
-        track->edit.state.addListener(this);
+        // The dispatcher keeps that from meaning every change in the edit, it
+        // only passes on the properties handled in valueTreePropertyChanged,
+        // and only for the master volume plugin and the master track.
+        using Filter = ValueTreeChangeDispatcher::Filter;
+        dispatcher = ValueTreeChangeDispatcher::getFor(track->edit.state);
+        auto volumeState = getVolumeAndPanPlugin()->state;
+        for (auto &property : {tracktion::IDs::volDb, tracktion::IDs::volume,
+                               tracktion::IDs::pan})
+            dispatcher->addPropertyListener(this, property,
+                                            Filter::onlyNode(volumeState));
+        for (auto &property : {tracktion::IDs::solo, tracktion::IDs::mute})
+            dispatcher->addPropertyListener(this, property,
+                                            Filter::onlyNode(track->state));
     } else {
         track->state.addListener(this);
     }
 }
 
 MixerTrackViewModel::~MixerTrackViewModel() {
-    if (track->isMasterTrack()) {
-        track->edit.state.removeListener(this);
+    if (dispatcher != nullptr) {
+        dispatcher->removeListener(this);
     } else {
         track->state.removeListener(this);
     }
@@ -32,6 +32,8 @@ class MixerTrackViewModel : public juce::ValueTree::Listener,
   private:
     tracktion::Track::Ptr track;
     juce::ValueTree state;
+    // only used for the master track, see the constructor
+    std::shared_ptr<ValueTreeChangeDispatcher> dispatcher;
     juce::ListenerList<Listener> listeners;
 
     // Async updater flags
@@ -0,0 +1,52 @@
+namespace app_view_models {
+
+DspLoadViewModel::DspLoadViewModel(app_services::AudioCallbackMonitor &m)
+    : monitor(m), snapshot(monitor.getSnapshot()) {
+    startTimer(timerIntervalMs);
+}
+
+DspLoadViewModel::~DspLoadViewModel() { stopTimer(); }
+
+void DspLoadViewModel::setPlugin(tracktion::Plugin *p) {
+    plugin = p;
+    pluginLoad = plugin != nullptr ? plugin->getCpuUsage() : -1.0;
+    listeners.call([](Listener &l) { l.dspLoadChanged(); });
+}
+
+double DspLoadViewModel::getLoad() const { return snapshot.load; }
+
+double DspLoadViewModel::getPeakLoad() const { return snapshot.peakLoad; }
+
+int DspLoadViewModel::getXruns() const { return snapshot.xruns; }
+
+double DspLoadViewModel::getPluginLoad() const { return pluginLoad; }
+
+void DspLoadViewModel::addListener(Listener *l) {
+    listeners.add(l);
+    l->dspLoadChanged();
+}
+
+void DspLoadViewModel::removeListener(Listener *l) { listeners.remove(l); }
+
+void DspLoadViewModel::timerCallback() {
+    auto newSnapshot = monitor.getSnapshot();
+    auto newPluginLoad = plugin != nullptr ? plugin->getCpuUsage() : -1.0;
+
+    // only repaint when something visible changed
+    bool changed =
+        juce::roundToInt(newSnapshot.load * 100.0) !=
+            juce::roundToInt(snapshot.load * 100.0) ||
+        juce::roundToInt(newSnapshot.peakLoad * 100.0) !=
+            juce::roundToInt(snapshot.peakLoad * 100.0) ||
+        newSnapshot.xruns != snapshot.xruns ||
+        juce::roundToInt(newPluginLoad * 1000.0) !=
+            juce::roundToInt(pluginLoad * 1000.0);
+
+    snapshot = newSnapshot;
+    pluginLoad = newPluginLoad;
+
+    if (changed)
+        listeners.call([](Listener &l) { l.dspLoadChanged(); });
+}
+
+} // namespace app_view_models
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace app_view_models {
+
+// Polls the audio callback monitor and, optionally, one plugin's CPU usage
+// and tells listeners when the numbers shown by the load overlay change.
+class DspLoadViewModel : private juce::Timer {
+  public:
+    explicit DspLoadViewModel(app_services::AudioCallbackMonitor &m);
+    ~DspLoadViewModel() override;
+
+    // The plugin whose own processing time is reported, nullptr for none
+    void setPlugin(tracktion::Plugin *p);
+
+    double getLoad() const;
+    double getPeakLoad() const;
+    int getXruns() const;
+    // The share of the callback the plugin takes, -1 without a plugin
+    double getPluginLoad() const;
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void dspLoadChanged() {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    app_services::AudioCallbackMonitor &monitor;
+    tracktion::Plugin::Ptr plugin;
+    app_services::AudioCallbackMonitor::Snapshot snapshot;
+    double pluginLoad = -1.0;
+
+    juce::ListenerList<Listener> listeners;
+
+    static constexpr int timerIntervalMs = 500;
+
+    void timerCallback() override;
+};
+
+} // namespace app_view_models
@@ -16,7 +16,17 @@ int OscillatorViewModel::getWaveShape() const {
 }
 
 int OscillatorViewModel::getVoices() const {
-    return plugin->oscParams[oscillatorIndex]->voicesValue.get();
+    return app_services::VoiceGovernor::getRequestedUnison(*plugin,
+                                                           oscillatorIndex);
+}
+
+int OscillatorViewModel::getVoiceLimit() const {
+    return app_services::VoiceGovernor::getUnisonLimit(*plugin);
+}
+
+bool OscillatorViewModel::isVoiceLimited() const {
+    return app_services::VoiceGovernor::isLimited(*plugin) &&
+           getVoices() > getVoiceLimit();
 }
 
 float OscillatorViewModel::getTune() const {
@@ -66,15 +76,22 @@ void OscillatorViewModel::decrementWaveShape() {
 }
 
 void OscillatorViewModel::incrementVoices() {
-    if (getVoices() < 8)
-        plugin->oscParams[oscillatorIndex]->voicesValue.setValue(
-            getVoices() + 1, nullptr);
+    // the governor stores what was asked for and plays what it can afford
+    if (getVoices() < app_services::VoiceGovernor::maxUnison) {
+        app_services::VoiceGovernor::setRequestedUnison(
+            *plugin, oscillatorIndex, getVoices() + 1);
+        // while limited the played value, and so the plugin state, may not
+        // change at all
+        markAndUpdate(shouldUpdateParameters);
+    }
 }
 
 void OscillatorViewModel::decrementVoices() {
-    if (getVoices() > 1)
-        plugin->oscParams[oscillatorIndex]->voicesValue.setValue(
-            getVoices() - 1, nullptr);
+    if (getVoices() > 1) {
+        app_services::VoiceGovernor::setRequestedUnison(
+            *plugin, oscillatorIndex, getVoices() - 1);
+        markAndUpdate(shouldUpdateParameters);
+    }
 }
 
 void OscillatorViewModel::incrementTune() {
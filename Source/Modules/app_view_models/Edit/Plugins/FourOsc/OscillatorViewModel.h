@@ -8,6 +8,9 @@ class OscillatorViewModel : public juce::ValueTree::Listener,
 
     int getWaveShape() const;
     int getVoices() const;
+    // The most voices the voice governor currently lets this oscillator play
+    int getVoiceLimit() const;
+    bool isVoiceLimited() const;
     float getTune() const;
     float getFineTune() const;
     float getLevel() const;
@@ -6,7 +6,7 @@ namespace app_view_models {
 
 PluginTreeGroup::PluginTreeGroup(tracktion::Edit &e)
     : name("Plugins"), edit(e) {
-    scanForPlugins();
+    scanForPlugins(edit.engine);
 
     // we need to add the app internal plugins to the cache:
     // edit.engine.getPluginManager().createBuiltInType<internal_plugins::DrumSamplerPlugin>();
@@ -91,7 +91,13 @@ void PluginTreeGroup::populateBuiltInEffects(int &num) {
     //        num);
 }
 
-void PluginTreeGroup::scanForPlugins() const {
+void PluginTreeGroup::scanForPlugins(tracktion::Engine &engine) {
+    // the boot warm up may still be scanning, the list it fills is used as is
+    static juce::CriticalSection scanLock;
+    const juce::ScopedTryLock sl(scanLock);
+    if (!sl.isLocked())
+        return;
+
     juce::Logger::writeToLog("scan for plugins called");
     // Scan for plugins
     juce::File homeDirectory = juce::File::getSpecialLocation(
@@ -101,24 +107,31 @@ void PluginTreeGroup::scanForPlugins() const {
         vst3Directory.createDirectory();
     }
 
-    edit.engine.getPluginManager().knownPluginList.clear();
+    auto &list = engine.getPluginManager().knownPluginList;
+
+    // plugins that were removed since the last scan are dropped instead of
+    // clearing the list, so the files still there are not scanned again
+    for (auto &description : list.getTypes())
+        if (juce::File::isAbsolutePath(description.fileOrIdentifier) &&
+            !juce::File(description.fileOrIdentifier).exists())
+            list.removeType(description);
 
-    for (auto format :
-         edit.engine.getPluginManager().pluginFormatManager.getFormats()) {
-        juce::Logger::writeToLog("looking for VST3 files...");
+    auto &formatManager = engine.getPluginManager().pluginFormatManager;
+    for (auto format : formatManager.getFormats()) {
+        app_services::AsyncLogger::log(app_services::AsyncLogger::Level::debug,
+                                       "looking for VST3 files...");
         if (format->getName() == "VST3") {
             juce::PluginDirectoryScanner scanner(
-                edit.engine.getPluginManager().knownPluginList,
-                reinterpret_cast<juce::AudioPluginFormat &>(*format),
+                list, reinterpret_cast<juce::AudioPluginFormat &>(*format),
                 juce::FileSearchPath(vst3Directory.getFullPathName()), true,
-                edit.engine.getTemporaryFileManager().getTempFile(
+                engine.getTemporaryFileManager().getTempFile(
                     "PluginScanDeadMansPedal"));
 
             juce::String pluginBeingScanned;
-            juce::Logger::writeToLog("scanning " + pluginBeingScanned);
-            while (scanner.scanNextFile(false, pluginBeingScanned)) {
-                scanner.scanNextFile(false, pluginBeingScanned);
-            }
+            while (scanner.scanNextFile(true, pluginBeingScanned))
+                app_services::AsyncLogger::log(
+                    app_services::AsyncLogger::Level::debug,
+                    "scanned " + pluginBeingScanned);
         }
     }
 }
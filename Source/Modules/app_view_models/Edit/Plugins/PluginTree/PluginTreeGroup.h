@@ -13,11 +13,15 @@ class PluginTreeGroup : public PluginTreeBase {
 
     juce::String name;
 
+    // Scans the VST3 folder into the engine's plugin list. Files that are
+    // already listed are skipped, so this is quick once the list is warm. It
+    // can run on a background thread, and returns straight away if another
+    // scan is already running.
+    static void scanForPlugins(tracktion::Engine &engine);
+
   private:
     tracktion::Edit &edit;
 
-    void scanForPlugins() const;
-
     void populateExternalInstruments(juce::KnownPluginList &list);
     void populateExternalEffects(juce::KnownPluginList &list);
 
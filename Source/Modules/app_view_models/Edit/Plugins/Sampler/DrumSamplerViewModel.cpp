@@ -111,6 +111,9 @@ void DrumSamplerViewModel::readMappingFileIntoSampler(
             samplerPlugin->setSoundOpenEnded(index, true);
         }
     }
+
+    // every pad of the kit is ready before it is selected
+    thumbnailCache->generate(drumSampleFiles);
 }
 
 void DrumSamplerViewModel::updateDrumKits() {
@@ -134,20 +137,13 @@ void DrumSamplerViewModel::updateDrumKits() {
                 entry.getFile().getFullPathName().toStdString());
         }
     }
+
+    // the other kits are generated after the pads of the selected one
+    thumbnailCache->generate(sampleDir);
 }
 
 void DrumSamplerViewModel::updateThumb() {
-    auto file = drumSampleFiles[selectedSoundIndex];
-    auto *reader = formatManager.createReaderFor(file);
-    if (reader != nullptr) {
-        std::unique_ptr<juce::AudioFormatReaderSource> newSource(
-            new juce::AudioFormatReaderSource(reader, true));
-        fullSampleThumbnail.clear();
-        fullSampleThumbnailCache.clear();
-        fullSampleThumbnail.setSource(new juce::FileInputSource(file));
-        readerSource.reset(newSource.release());
-    }
-
+    setThumbnailFile(drumSampleFiles[selectedSoundIndex]);
     markAndUpdate(shouldUpdateSample);
 }
 } // namespace app_view_models
@@ -6,9 +6,9 @@ SamplerViewModel::SamplerViewModel(tracktion::SamplerPlugin *sampler,
     : samplerPlugin(sampler),
       state(samplerPlugin->edit.state.getOrCreateChildWithName(stateIdentifier,
                                                                nullptr)),
-      itemListState(state, 100), fullSampleThumbnailCache(5),
+      itemListState(state, 100),
       fullSampleThumbnail(numSamplesForThumbnail, formatManager,
-                          fullSampleThumbnailCache) {
+                          *thumbnailCache) {
     formatManager.registerBasicFormats();
     selectedSoundIndex.referTo(state, IDs::selectedSoundIndex, nullptr, 0);
     samplerPlugin->state.addListener(this);
@@ -32,6 +32,14 @@ juce::AudioThumbnail &SamplerViewModel::getFullSampleThumbnail() {
     return fullSampleThumbnail;
 }
 
+void SamplerViewModel::setThumbnailFile(const juce::File &file) {
+    if (!file.existsAsFile())
+        return;
+
+    fullSampleThumbnail.setSource(
+        new ThumbnailCache::FileSource(*thumbnailCache, file));
+}
+
 double SamplerViewModel::getStartTime() {
     return samplerPlugin->getSoundStartTime(selectedSoundIndex);
 }
@@ -54,13 +62,17 @@ double SamplerViewModel::getSelectedClipLength() {
 }
 
 void SamplerViewModel::increaseSelectedIndex() {
-    itemListState.setSelectedItemIndex(itemListState.getSelectedItemIndex() +
-                                       1);
+    auto previousIndex = itemListState.getSelectedItemIndex();
+    itemListState.setSelectedItemIndex(previousIndex + 1);
+    if (itemListState.getSelectedItemIndex() != previousIndex)
+        selectionWasStepped = true;
 }
 
 void SamplerViewModel::decreaseSelectedIndex() {
-    itemListState.setSelectedItemIndex(itemListState.getSelectedItemIndex() -
-                                       1);
+    auto previousIndex = itemListState.getSelectedItemIndex();
+    itemListState.setSelectedItemIndex(previousIndex - 1);
+    if (itemListState.getSelectedItemIndex() != previousIndex)
+        selectionWasStepped = true;
 }
 
 void SamplerViewModel::increaseStartTime() {
@@ -154,6 +166,9 @@ void SamplerViewModel::handleAsyncUpdate() {
     if (compareAndReset(shouldUpdateSample))
         listeners.call([this](Listener &l) { l.sampleChanged(); });
 
+    if (compareAndReset(shouldUpdateItemNames))
+        listeners.call([this](Listener &l) { l.itemNamesChanged(); });
+
     if (compareAndReset(shouldUpdateFullSampleThumbnail))
         listeners.call([this](Listener &l) { l.fullSampleThumbnailChanged(); });
 
@@ -30,6 +30,10 @@ class SamplerViewModel : public juce::ChangeListener,
 
     virtual void loadSampleFile(const juce::File &file) {}
 
+    // Loads the highlighted sample and stops auditioning it, for samplers
+    // that only audition while the selection moves
+    virtual void confirmSelection() {}
+
     double getTotalSampleLength();
     double getSelectedClipLength();
 
@@ -66,6 +70,7 @@ class SamplerViewModel : public juce::ChangeListener,
         virtual ~Listener() = default;
 
         virtual void sampleChanged() {}
+        virtual void itemNamesChanged() {}
         virtual void sampleExcerptTimesChanged() {}
         virtual void fullSampleThumbnailChanged() {}
         virtual void sampleExcerptThumbnailChanged() {}
@@ -76,25 +81,34 @@ class SamplerViewModel : public juce::ChangeListener,
     void removeListener(Listener *l);
 
   protected:
-    const int numSamplesForThumbnail = 512;
+    const int numSamplesForThumbnail =
+        ThumbnailCache::samplesPerThumbnailSample;
     tracktion::SamplerPlugin *samplerPlugin;
 
     juce::ValueTree state;
     juce::CachedValue<int> selectedSoundIndex;
 
     juce::AudioFormatManager formatManager;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
 
-    juce::AudioThumbnailCache fullSampleThumbnailCache;
+    // thumbnails are kept on disk and shared by every sampler
+    juce::SharedResourcePointer<ThumbnailCache> thumbnailCache;
     juce::AudioThumbnail fullSampleThumbnail;
 
+    // Shows the thumbnail of file, straight from the cache if it has one
+    void setThumbnailFile(const juce::File &file);
+
     juce::ListenerList<Listener> listeners;
 
     bool shouldUpdateFullSampleThumbnail = false;
     bool shouldUpdateSampleExcerptTimes = false;
     bool shouldUpdateSample = false;
+    bool shouldUpdateItemNames = false;
     bool shouldUpdateGain = false;
 
+    // set when the selection moved by a scroll step rather than being set
+    // from code, until the subclass sees the change
+    bool selectionWasStepped = false;
+
     void handleAsyncUpdate() override;
 
   public:
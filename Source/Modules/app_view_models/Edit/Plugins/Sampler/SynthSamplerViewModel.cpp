@@ -1,6 +1,8 @@
 namespace app_view_models {
 SynthSamplerViewModel::SynthSamplerViewModel(tracktion::SamplerPlugin *sampler)
-    : SamplerViewModel(sampler, IDs::SYNTH_SAMPLER_VIEW_STATE) {
+    : SamplerViewModel(sampler, IDs::SYNTH_SAMPLER_VIEW_STATE),
+      samplePreview(app_services::SamplePreview::getFor(
+          sampler->engine.getDeviceManager().deviceManager)) {
     curFilePath.referTo(state, IDs::curFilePathID, nullptr, "");
 
     auto curFile = juce::File(curFilePath);
@@ -8,6 +10,8 @@ SynthSamplerViewModel::SynthSamplerViewModel(tracktion::SamplerPlugin *sampler)
     // Set curDir to samples directory
     curDir = ConfigurationHelpers::getTempSamplesDirectory(
         samplerPlugin->edit.engine);
+    sampleLibrary->addRoot(curDir);
+    sampleLibrary->addListener(this);
 
     if (curFile != juce::String{""} && curFile.existsAsFile()) {
         // File was previously selected, load it
@@ -17,10 +21,10 @@ SynthSamplerViewModel::SynthSamplerViewModel(tracktion::SamplerPlugin *sampler)
     // Otherwise, don't auto-load any file - let user choose
 
     updateFiles();
-    itemListState.listSize = files.size();
+    itemListState.listSize = int(entries.size());
 
     if (curFile.existsAsFile()) {
-        int curIndex = files.indexOf(curFile);
+        int curIndex = indexOfEntry(curFile);
         if (curIndex >= 0) {
             itemListState.setSelectedItemIndex(curIndex);
         }
@@ -29,31 +33,53 @@ SynthSamplerViewModel::SynthSamplerViewModel(tracktion::SamplerPlugin *sampler)
     markAndUpdate(shouldUpdateSample);
 }
 
-void SynthSamplerViewModel::updateFiles() {
-    files.clear();
+SynthSamplerViewModel::~SynthSamplerViewModel() {
+    sampleLibrary->removeListener(this);
+    samplePreview->stop();
+}
+
+void SynthSamplerViewModel::updateFiles(bool generateThumbnails) {
+    entries.clear();
     auto sampleDir = ConfigurationHelpers::getTempSamplesDirectory(
         samplerPlugin->edit.engine);
     if (curDir.isAChildOf(sampleDir)) {
-        auto parent = curDir.getParentDirectory();
-        files.add(parent);
+        SampleLibrary::Entry parent;
+        parent.file = curDir.getParentDirectory();
+        parent.name = "..";
+        parent.isDirectory = true;
+        entries.push_back(parent);
     }
-    files.addArray(curDir.findChildFiles(
-        juce::File::TypesOfFileToFind::findDirectories, false));
-    files.addArray(
-        curDir.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false));
+
+    // the list shows every name at once, so the whole directory is copied
+    // out of the index in one go
+    auto listed = sampleLibrary->getEntries(
+        curDir, 0, sampleLibrary->getNumEntries(curDir));
+    entries.insert(entries.end(), listed.begin(), listed.end());
+
+    if (!generateThumbnails)
+        return;
+
+    // the samples next to the one selected are likely to be scrolled to
+    juce::Array<juce::File> samples;
+    for (auto &entry : entries)
+        if (!entry.isDirectory)
+            samples.add(entry.file);
+
+    thumbnailCache->generate(samples);
 }
 
 juce::StringArray SynthSamplerViewModel::getItemNames() {
     juce::StringArray itemNames;
-    for (const juce::File &file : files) {
-        if (file.isDirectory()) {
-            if (file == curDir.getParentDirectory()) {
-                itemNames.add("..");
-            } else {
-                itemNames.add(file.getFileNameWithoutExtension() + "/");
-            }
+    for (auto &entry : entries) {
+        if (entry.isDirectory) {
+            itemNames.add(entry.file == curDir.getParentDirectory()
+                              ? entry.name
+                              : entry.name + "/");
+        } else if (entry.hasInfo) {
+            itemNames.add(entry.name + " " +
+                          juce::String(entry.lengthInSeconds, 2) + "s");
         } else {
-            itemNames.add(file.getFileNameWithoutExtension());
+            itemNames.add(entry.name);
         }
     }
     return itemNames;
@@ -75,8 +101,9 @@ juce::String SynthSamplerViewModel::getTitle() {
 bool SynthSamplerViewModel::isDir() { return nextFile.isDirectory(); }
 
 void SynthSamplerViewModel::refreshSampleList() {
+    sampleLibrary->refresh(curDir);
     updateFiles();
-    itemListState.listSize = files.size();
+    itemListState.listSize = int(entries.size());
     markAndUpdate(shouldUpdateSample);
 }
 
@@ -89,9 +116,11 @@ void SynthSamplerViewModel::loadSampleFile(const juce::File &file) {
     if (file.existsAsFile()) {
         curDir = file.getParentDirectory();
         curFilePath.setValue(file.getFullPathName(), nullptr);
+        // most likely just recorded, the index has not seen it yet
+        sampleLibrary->refresh(curDir);
         updateFiles();
-        itemListState.listSize = files.size();
-        int fileIndex = files.indexOf(file);
+        itemListState.listSize = int(entries.size());
+        int fileIndex = indexOfEntry(file);
         if (fileIndex >= 0) {
             itemListState.setSelectedItemIndex(fileIndex);
         }
@@ -99,13 +128,20 @@ void SynthSamplerViewModel::loadSampleFile(const juce::File &file) {
     }
 }
 
+void SynthSamplerViewModel::confirmSelection() {
+    samplePreview->stop();
+    if (nextFile.existsAsFile())
+        curFilePath.setValue(nextFile.getFullPathName(), nullptr);
+}
+
 void SynthSamplerViewModel::enterDir() {
     if (!isDir()) {
         return;
     }
     curDir = nextFile;
+    samplePreview->stop();
     updateFiles();
-    itemListState.listSize = files.size();
+    itemListState.listSize = int(entries.size());
     itemListState.setSelectedItemIndex(0);
     selectedIndexChanged(0);
 
@@ -113,20 +149,36 @@ void SynthSamplerViewModel::enterDir() {
 }
 
 void SynthSamplerViewModel::updateThumb() {
-    auto curFile = juce::File(curFilePath);
-    auto *reader = formatManager.createReaderFor(curFile);
-    if (reader != nullptr) {
-        std::unique_ptr<juce::AudioFormatReaderSource> newSource(
-            new juce::AudioFormatReaderSource(reader, true));
-        fullSampleThumbnail.clear();
-        fullSampleThumbnailCache.clear();
-        fullSampleThumbnail.setSource(new juce::FileInputSource(curFile));
-        readerSource.reset(newSource.release());
-    }
-
+    setThumbnailFile(juce::File(curFilePath));
     markAndUpdate(shouldUpdateFullSampleThumbnail);
 }
 
+int SynthSamplerViewModel::indexOfEntry(const juce::File &file) const {
+    for (size_t i = 0; i < entries.size(); ++i)
+        if (entries[i].file == file)
+            return int(i);
+
+    return -1;
+}
+
+void SynthSamplerViewModel::prefetchAroundSelection() {
+    // nearest first, so the next scroll step in either direction is read
+    // before the ones further away
+    juce::Array<juce::File> files;
+    auto selected = itemListState.getSelectedItemIndex();
+    for (int distance = 0; distance <= numEntriesToPrefetch; ++distance)
+        for (auto index : {selected + distance, selected - distance}) {
+            if (!juce::isPositiveAndBelow(index, int(entries.size())))
+                continue;
+
+            auto &entry = entries[size_t(index)];
+            if (!entry.isDirectory)
+                files.addIfNotAlreadyThere(entry.file);
+        }
+
+    samplePreview->prefetch(files);
+}
+
 void SynthSamplerViewModel::fileChanged() {
     auto curFile = juce::File(curFilePath);
     if (curFile == juce::String{""}) {
@@ -152,13 +204,46 @@ void SynthSamplerViewModel::fileChanged() {
 }
 
 void SynthSamplerViewModel::selectedIndexChanged(int newIndex) {
-    nextFile = files[newIndex];
-    if (!nextFile.isDirectory()) {
-        curFilePath.setValue(nextFile.getFullPathName(), nullptr);
+    nextFile = juce::isPositiveAndBelow(newIndex, int(entries.size()))
+                   ? entries[size_t(newIndex)].file
+                   : juce::File();
+
+    // scrolling only auditions the highlighted sample, it is loaded into the
+    // sampler once the selection is confirmed. A selection restored or moved
+    // from code stays silent.
+    if (compareAndReset(selectionWasStepped)) {
+        if (nextFile.existsAsFile())
+            samplePreview->play(nextFile);
+        else
+            samplePreview->stop();
     }
+
+    prefetchAroundSelection();
     markAndUpdate(shouldUpdateSample);
 }
 
+void SynthSamplerViewModel::sampleLibraryChanged() {
+    auto selectedFile =
+        entries.empty()
+            ? juce::File()
+            : entries[size_t(juce::jlimit(
+                          0, int(entries.size()) - 1,
+                          itemListState.getSelectedItemIndex()))]
+                  .file;
+
+    // only the info or the listing changed, the thumbnails are queued already
+    updateFiles(false);
+    itemListState.listSize = int(entries.size());
+
+    // entries may have moved, the selection stays on the same file
+    auto selectedIndex = indexOfEntry(selectedFile);
+    if (selectedIndex >= 0 &&
+        selectedIndex != itemListState.getSelectedItemIndex())
+        itemListState.setSelectedItemIndex(selectedIndex);
+
+    markAndUpdate(shouldUpdateItemNames);
+}
+
 void SynthSamplerViewModel::valueTreePropertyChanged(
     juce::ValueTree &treeWhosePropertyHasChanged,
     const juce::Identifier &property) {
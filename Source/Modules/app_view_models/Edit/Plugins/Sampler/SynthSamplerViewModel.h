@@ -7,9 +7,11 @@ const juce::Identifier curFilePathID("curFilePath");
 
 } // namespace IDs
 
-class SynthSamplerViewModel : public app_view_models::SamplerViewModel {
+class SynthSamplerViewModel : public app_view_models::SamplerViewModel,
+                              private SampleLibrary::Listener {
   public:
     SynthSamplerViewModel(tracktion::SamplerPlugin *sampler);
+    ~SynthSamplerViewModel() override;
 
     void enterDir() override;
     bool isDir() override;
@@ -20,6 +22,8 @@ class SynthSamplerViewModel : public app_view_models::SamplerViewModel {
 
     void loadSampleFile(const juce::File &file) override;
 
+    void confirmSelection() override;
+
     juce::String getTitle() override;
 
     juce::StringArray getItemNames() override;
@@ -31,14 +35,27 @@ class SynthSamplerViewModel : public app_view_models::SamplerViewModel {
                                   const juce::Identifier &property) override;
 
   protected:
-    juce::Array<juce::File> files;
+    juce::SharedResourcePointer<SampleLibrary> sampleLibrary;
+    std::vector<SampleLibrary::Entry> entries;
+
+    // how many entries either side of the selection have their heads read
+    // ahead, a few scroll steps' worth
+    static constexpr int numEntriesToPrefetch = 8;
+
+    // plays the highlighted sample without loading it into the sampler,
+    // shared with the rest of the app
+    std::shared_ptr<app_services::SamplePreview> samplePreview;
     juce::CachedValue<juce::String> curFilePath;
     juce::File curDir;
     juce::File nextFile;
 
     void fileChanged();
-    void updateFiles();
+    void updateFiles(bool generateThumbnails = true);
     void updateThumb();
+    int indexOfEntry(const juce::File &file) const;
+    void prefetchAroundSelection();
+
+    void sampleLibraryChanged() override;
 };
 
 } // namespace app_view_models
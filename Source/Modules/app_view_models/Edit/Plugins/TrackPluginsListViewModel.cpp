@@ -74,4 +74,8 @@ void TrackPluginsListViewModel::moveSelectedPluginDown() {
         juce::String(listViewModel.itemListState.getSelectedItemIndex()));
 }
 
+bool TrackPluginsListViewModel::isTrackFrozen() {
+    return track->isFrozen(tracktion::Track::individualFreeze);
+}
+
 } // namespace app_view_models
\ No newline at end of file
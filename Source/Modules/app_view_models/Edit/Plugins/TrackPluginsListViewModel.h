@@ -17,6 +17,9 @@ class TrackPluginsListViewModel {
     void moveSelectedPluginUp();
     void moveSelectedPluginDown();
 
+    // plugins of a frozen track are unloaded until it gets unfrozen
+    bool isTrackFrozen();
+
   private:
     tracktion::AudioTrack::Ptr track;
     juce::ValueTree state;
@@ -2,8 +2,9 @@ namespace app_view_models {
 // For playing clip only!!
 // https://forum.juce.com/t/createeditforpreviewingclip-how-is-it-used/32757
 StepSequencerViewModel::StepSequencerViewModel(tracktion::AudioTrack::Ptr t)
-    : track(t), state(track->state.getOrCreateChildWithName(
-                    IDs::STEP_SEQUENCER_STATE, nullptr)),
+    : track(t), tempoMap(app_services::TempoMap::getFor(t->edit)),
+      state(track->state.getOrCreateChildWithName(IDs::STEP_SEQUENCER_STATE,
+                                                  nullptr)),
       editState(track->edit.state.getChildWithName(IDs::EDIT_VIEW_STATE)),
       stepSequence(state.getOrCreateChildWithName(
           app_models::IDs::STEP_SEQUENCE, nullptr)) {
@@ -51,23 +52,33 @@ StepSequencerViewModel::StepSequencerViewModel(tracktion::AudioTrack::Ptr t)
 
     notesPerMeasure.referTo(state, IDs::notesPerMeasure, nullptr, 4);
 
-    double secondsPerBeat = 1.0 / track->edit.tempoSequence.getBeatsPerSecondAt(
-                                      tracktion::TimePosition::fromSeconds(0));
-
-    // Midi clip
+    // The pattern plays from a plugin at the start of the track while the
+    // sequencer is open, it is only written to a clip starting here when the
+    // sequencer closes
     midiClipStart = track->edit.getTransport().getPosition();
-    midiClipEnd = tracktion::TimePosition::fromSeconds(
-        midiClipStart.inSeconds() +
-        (numberOfNotes.get() * (4.0 / double(notesPerMeasure.get())) *
-         secondsPerBeat));
-    const tracktion::TimeRange midiClipTimeRange =
-        tracktion::TimeRange(midiClipStart, midiClipEnd);
-    midiClip = dynamic_cast<tracktion::MidiClip *>(track->insertNewClip(
-        tracktion::TrackItem::Type::midi, "step", midiClipTimeRange, nullptr));
 
-    generateMidiSequence();
+    for (auto plugin : track->pluginList)
+        if (auto sequencer =
+                dynamic_cast<internal_plugins::StepSequencerPlugin *>(plugin))
+            sequencerPlugin = sequencer;
+
+    if (sequencerPlugin == nullptr) {
+        auto plugin =
+            internal_plugins::StepSequencerPlugin::create(track->edit);
+        sequencerPlugin =
+            dynamic_cast<internal_plugins::StepSequencerPlugin *>(plugin.get());
+        jassert(sequencerPlugin != nullptr);
+
+        // added ahead of the other plugins without the undo manager, opening
+        // the sequencer is not something the user can undo
+        int index = 0;
+        while (index < track->state.getNumChildren() &&
+               !track->state.getChild(index).hasType(tracktion::IDs::PLUGIN))
+            index++;
+        track->state.addChild(plugin->state, index, nullptr);
+    }
 
-    loopAroundClip(*midiClip);
+    updatePattern();
 
     track->edit.getTransport().addListener(this);
 }
@@ -75,14 +86,14 @@ StepSequencerViewModel::StepSequencerViewModel(tracktion::AudioTrack::Ptr t)
 StepSequencerViewModel::~StepSequencerViewModel() {
     stop();
 
-    generateMidiSequence();
+    // only a pattern with notes is written to a clip, so opening and closing
+    // the sequencer without adding any leaves the edit as it was
+    if (hasNotes())
+        generateMidiSequence();
 
-    // if the sequence is empty, delete the clip
-    // and disable looping
-    if (midiClip->getSequence().isEmpty()) {
-        midiClip->removeFromParentTrack();
-        track->edit.getTransport().looping.setValue(false, nullptr);
-    }
+    // removed the way it was added, so closing leaves no undo step either
+    sequencerPlugin->state.getParent().removeChild(sequencerPlugin->state,
+                                                   nullptr);
 
     state.removeListener(this);
     editState.removeListener(this);
@@ -191,16 +202,14 @@ void StepSequencerViewModel::clearNotesAtSelectedIndex() {
 }
 
 void StepSequencerViewModel::play() {
-    // In the future maybe only the midi clip currently generated by the
-    // sequencer should be played not the whole edit. Might be challenging
-    // though. https://forum.juce.com/t/how-to-render-a-midiclip-any-hints/31004
-    // https://forum.juce.com/t/createeditforpreviewingclip-how-is-it-used/32757/11
+    // The plugin loops the pattern by itself, so the rest of the edit keeps
+    // playing along with it and nothing needs to be soloed or looped
     if (!track->edit.getTransport().isPlaying()) {
-        generateMidiSequence();
+        isPatternPlaying = true;
+        updatePattern();
         track->edit.clickTrackEnabled.setValue(false, nullptr);
         track->edit.getTransport().setCurrentPosition(
             midiClipStart.inSeconds());
-        track->setSolo(true);
         track->edit.getTransport().play(false);
     }
 }
@@ -208,9 +217,13 @@ void StepSequencerViewModel::play() {
 void StepSequencerViewModel::stop() {
     if (track->edit.getTransport().isPlaying()) {
         track->edit.clickTrackEnabled.setValue(true, nullptr);
-        track->setSolo(false);
         track->edit.getTransport().stop(false, false);
     }
+
+    if (isPatternPlaying) {
+        isPatternPlaying = false;
+        updatePattern();
+    }
 }
 
 void StepSequencerViewModel::handleAsyncUpdate() {
@@ -243,47 +256,29 @@ void StepSequencerViewModel::valueTreePropertyChanged(
     juce::ValueTree &treeWhosePropertyHasChanged,
     const juce::Identifier &property) {
     if (treeWhosePropertyHasChanged.hasType(app_models::IDs::STEP_CHANNEL))
-        if (property == app_models::IDs::stepPattern)
+        if (property == app_models::IDs::stepPattern) {
+            updatePattern();
             markAndUpdate(shouldUpdatePattern);
+        }
 
     if (treeWhosePropertyHasChanged == state) {
         if (property == IDs::selectedNoteIndex)
             markAndUpdate(shouldUpdateSelectedNoteIndex);
 
         if (property == IDs::numberOfNotes) {
-            double secondsPerBeat =
-                1.0 / track->edit.tempoSequence.getBeatsPerSecondAt(
-                          tracktion::TimePosition::fromSeconds(0.0));
-            midiClipEnd = tracktion::TimePosition::fromSeconds(
-                midiClipStart.inSeconds() +
-                (numberOfNotes.get() * (4.0 / double(notesPerMeasure.get())) *
-                 secondsPerBeat));
-            midiClip->setEnd(midiClipEnd, true);
-            loopAroundClip(*midiClip);
-
+            updatePattern();
             markAndUpdate(shouldUpdateNumberOfNotes);
         }
 
         if (property == IDs::notesPerMeasure) {
-            double secondsPerBeat =
-                1.0 / track->edit.tempoSequence.getBeatsPerSecondAt(
-                          tracktion::TimePosition::fromSeconds(0.0));
-            midiClipEnd = tracktion::TimePosition::fromSeconds(
-                midiClipStart.inSeconds() +
-                (numberOfNotes.get() * (4.0 / double(notesPerMeasure.get())) *
-                 secondsPerBeat));
-            midiClip->setEnd(midiClipEnd, true);
-            loopAroundClip(*midiClip);
-
+            updatePattern();
             markAndUpdate(shouldUpdateNotesPerMeasure);
         }
     }
 
     if (treeWhosePropertyHasChanged.hasType(IDs::EDIT_VIEW_STATE)) {
-        if (property == IDs::currentOctave) {
-            // Might need to detect changes in here at some point, for now do
-            // nothing
-        }
+        if (property == IDs::currentOctave)
+            updatePattern();
     }
 }
 
@@ -299,7 +294,25 @@ void StepSequencerViewModel::removeListener(Listener *l) {
     listeners.remove(l);
 }
 
+bool StepSequencerViewModel::hasNotes() {
+    for (int i = 0; i < getNumChannels(); i++)
+        for (int j = 0; j < getNumNotesPerChannel(); j++)
+            if (hasNoteAt(i, j))
+                return true;
+
+    return false;
+}
+
 void StepSequencerViewModel::generateMidiSequence() {
+    const tracktion::TimeRange midiClipTimeRange(midiClipStart,
+                                                 getMidiClipEnd());
+    if (midiClip == nullptr)
+        midiClip = dynamic_cast<tracktion::MidiClip *>(
+            track->insertNewClip(tracktion::TrackItem::Type::midi, "step",
+                                 midiClipTimeRange, nullptr));
+    else
+        midiClip->setEnd(midiClipTimeRange.getEnd(), true);
+
     auto &sequence = midiClip->getSequence();
     sequence.clear(nullptr);
 
@@ -322,25 +335,59 @@ void StepSequencerViewModel::generateMidiSequence() {
 
 void StepSequencerViewModel::setVideoPosition(
     tracktion::TimePosition timePosition, bool forceJump) {
-    // find beat of current time relative to the start of the midi clip
-    // round it down to nearest whole beat
-    // then account for the notes per measure
-    auto time = timePosition.inSeconds();
-    auto beats = track->edit.tempoSequence.toBeats(
-        tracktion::TimePosition::fromSeconds(time - midiClipStart.inSeconds()));
-    double beatTime =
-        floorToFraction(beats.inBeats(), double(notesPerMeasure.get()) / 4.0);
-    int note = (beatTime * notesPerMeasure.get()) / 4.0;
-    selectedNoteIndex.setValue(note, nullptr);
+    // follow the step the plugin is playing, it loops the pattern so the
+    // position is wrapped to the loop length first
+    auto &pattern = sequencerPlugin->getPattern();
+    auto loopLength = pattern.stepTimes[size_t(pattern.numberOfSteps)];
+    auto position = timePosition.inSeconds() - pattern.startSeconds;
+    if (!pattern.active || loopLength <= 0.0 || position < 0.0)
+        return;
+
+    position = std::fmod(position, loopLength);
+    auto stepsEnd = pattern.stepTimes.begin() + pattern.numberOfSteps;
+    auto step = std::upper_bound(pattern.stepTimes.begin(), stepsEnd,
+                                 position) -
+                pattern.stepTimes.begin() - 1;
+    selectedNoteIndex.setValue(int(step), nullptr);
+}
+
+void StepSequencerViewModel::updatePattern() {
+    internal_plugins::StepSequencerPlugin::Pattern pattern;
+    pattern.active = isPatternPlaying;
+    pattern.startSeconds = midiClipStart.inSeconds();
+    pattern.numberOfSteps = juce::jlimit(
+        1, internal_plugins::StepSequencerPlugin::maxNumberOfSteps,
+        numberOfNotes.get());
+    pattern.lowestNoteNumber =
+        (NOTES_PER_OCTAVE * getZeroBasedOctave()) + MIN_NOTE_NUMBER;
+
+    // step times are worked out through the tempo map here so the audio
+    // thread only has to compare seconds
+    auto startBeat = tempoMap->toBeats(midiClipStart).inBeats();
+    auto beatsPerStep = 4.0 / double(notesPerMeasure.get());
+    for (int step = 0; step <= pattern.numberOfSteps; step++)
+        pattern.stepTimes[size_t(step)] =
+            tempoMap
+                ->toTime(tracktion::BeatPosition::fromBeats(
+                    startBeat + step * beatsPerStep))
+                .inSeconds() -
+            pattern.startSeconds;
+
+    for (int i = 0; i < getNumChannels(); i++)
+        for (int j = 0; j < pattern.numberOfSteps; j++)
+            if (hasNoteAt(i, j))
+                pattern.channelSteps[size_t(i)] |= juce::uint32(1) << j;
+
+    sequencerPlugin->setPattern(pattern);
 }
 
-double StepSequencerViewModel::floorToFraction(double number,
-                                               double denominator) {
-    // https://stackoverflow.com/questions/14903379/rounding-to-nearest-fraction-half-quarter-etc
-    double x = number * denominator;
-    x = floor(x);
-    x = x / denominator;
-    return x;
+tracktion::TimePosition StepSequencerViewModel::getMidiClipEnd() {
+    // the clip is measured in beats from its start so it keeps its length
+    // in steps across tempo changes
+    auto lengthInBeats =
+        numberOfNotes.get() * (4.0 / double(notesPerMeasure.get()));
+    return tempoMap->toTime(tracktion::BeatPosition::fromBeats(
+        tempoMap->toBeats(midiClipStart).inBeats() + lengthInBeats));
 }
 
 int StepSequencerViewModel::getZeroBasedOctave() {
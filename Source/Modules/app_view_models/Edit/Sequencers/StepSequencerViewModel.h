@@ -43,6 +43,12 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
     void play();
     void stop();
 
+    // Writes the step pattern to a MIDI clip at the sequencer's start
+    // position, creating the clip the first time. The pattern plays from the
+    // track's step sequencer plugin while the sequencer is open, this is what
+    // keeps it in the edit once the sequencer closes.
+    void generateMidiSequence();
+
     class Listener {
       public:
         virtual ~Listener() = default;
@@ -62,14 +68,17 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
     const int MAX_OCTAVE = 4;
     const int NOTES_PER_OCTAVE = 12;
     tracktion::AudioTrack::Ptr track;
+    std::shared_ptr<app_services::TempoMap> tempoMap;
     tracktion::MidiClip::Ptr midiClip;
+    juce::ReferenceCountedObjectPtr<internal_plugins::StepSequencerPlugin>
+        sequencerPlugin;
+    bool isPatternPlaying = false;
 
     juce::ValueTree state;
     juce::ValueTree editState;
     app_models::StepSequence stepSequence;
 
     tracktion::TimePosition midiClipStart;
-    tracktion::TimePosition midiClipEnd;
 
     tracktion::ConstrainedCachedValue<int> selectedNoteIndex;
     tracktion::ConstrainedCachedValue<int> numberOfNotes;
@@ -89,8 +98,6 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
                                   const juce::Identifier &property) override;
 
-    void generateMidiSequence();
-
     // used for transport changes
     void playbackContextChanged() override {}
     void autoSaveNow() override {}
@@ -100,7 +107,10 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
     void startVideo() override {}
     void stopVideo() override {}
     int getZeroBasedOctave();
-    static double floorToFraction(double number, double denominator = 1);
+    bool hasNotes();
+    tracktion::TimePosition getMidiClipEnd();
+    // Publishes the pattern, octave and step timing to the plugin
+    void updatePattern();
 };
 
 } // namespace app_view_models
@@ -47,7 +47,17 @@ void AudioBufferSizeListViewModel::updateAudioBufferSize() {
     if (result != "") {
         juce::Logger::writeToLog("Error setting buffer size to " +
                                  getSelectedItem() + ": " + result);
+        return;
     }
+
+    // what the device adds on top of the engine latency the latency
+    // benchmarks measure for each buffer size
+    if (auto device = deviceManager.getCurrentAudioDevice())
+        juce::Logger::writeToLog(
+            "Buffer size set to " + getSelectedItem() +
+            ", device output latency " +
+            juce::String(device->getOutputLatencyInSamples()) + " samples at " +
+            juce::String(device->getCurrentSampleRate()) + "Hz");
 }
 
 void AudioBufferSizeListViewModel::selectedIndexChanged(int newIndex) {
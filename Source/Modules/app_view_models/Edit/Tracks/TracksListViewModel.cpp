@@ -9,13 +9,27 @@ TracksListViewModel::TracksListViewModel(tracktion::Edit &e,
       camera(cam), adapter(std::make_unique<TracksListAdapter>(edit)),
       state(edit.state.getOrCreateChildWithName(IDs::TRACKS_LIST_VIEW_STATE,
                                                 nullptr)),
+      tempoMap(app_services::TempoMap::getFor(edit)),
       listViewModel(edit.state, state, tracktion::IDs::TRACK, adapter.get()) {
     initialiseInputs();
     listViewModel.itemListState.addListener(this);
-    edit.state.addListener(this);
     edit.getTransport().addChangeListener(this);
     edit.getTransport().addListener(this);
-    edit.getTransport().state.addListener(this);
+
+    // only the properties handled in valueTreePropertyChanged are routed here,
+    // the rest of the edit's changes never reach this view model
+    using Filter = ValueTreeChangeDispatcher::Filter;
+    dispatcher = ValueTreeChangeDispatcher::getFor(edit.state);
+    dispatcher->addPropertyListener(this, IDs::tracksListViewType,
+                                    Filter::onlyNode(state));
+    dispatcher->addPropertyListener(
+        this, tracktion::IDs::looping,
+        Filter::onlyNode(edit.getTransport().state));
+    // clips have a mute property too, only the audio tracks' are wanted
+    for (auto &property : {tracktion::IDs::solo, tracktion::IDs::mute,
+                           tracktion::IDs::frozenIndividually})
+        dispatcher->addPropertyListener(
+            this, property, Filter::ofType(tracktion::IDs::TRACK));
 
     edit.getUndoManager().clearUndoHistory();
 
@@ -26,8 +40,9 @@ TracksListViewModel::TracksListViewModel(tracktion::Edit &e,
 }
 
 TracksListViewModel::~TracksListViewModel() {
+    stopTimer();
     listViewModel.removeListener(this);
-    edit.state.removeListener(this);
+    dispatcher->removeListener(this);
     edit.getTransport().removeChangeListener(this);
     edit.getTransport().removeListener(this);
 }
@@ -167,7 +182,7 @@ void TracksListViewModel::pasteClipboardContentToTrackAtPlayhead() {
                 double start = 0;
                 for (auto &i : clipContent->clips) {
                     auto end = i.hasBeatTimes
-                                   ? edit.tempoSequence.toTime(i.startBeats)
+                                   ? tempoMap->toTime(i.startBeats)
                                          .inSeconds()
                                    : (static_cast<double>(i.state.getProperty(
                                          tracktion::IDs::start)));
@@ -222,10 +237,7 @@ void TracksListViewModel::stopRecordingOrPlaying() {
     auto &transport = edit.getTransport();
     if (transport.isPlaying() || transport.isRecording()) {
         transport.stop(false, false);
-
-        tracktion::EditFileOperations fileOperations(edit);
-        fileOperations.save(true, true, false);
-
+        app_services::EditCache::saveEdit(edit);
     } else {
         // if we try to stop while currently not playing
         // return transport to beginning
@@ -254,42 +266,15 @@ void TracksListViewModel::nudgeTransportBackward() {
 }
 
 void TracksListViewModel::nudgeTransportForwardToNearestBeat() {
-    double nearestBeatTime =
-        tracktion::TimecodeSnapType::get1BeatSnapType()
-            .roundTimeUp(edit.getTransport().getPosition(), edit.tempoSequence)
-            .inSeconds();
-
-    // Check if we are on a beat already
-    if (nearestBeatTime == edit.getTransport().getCurrentPosition()) {
-        double secondsPerBeat =
-            1.0 / edit.tempoSequence.getBeatsPerSecondAt(
-                      tracktion::TimePosition::fromSeconds(0.0));
-        edit.getTransport().setCurrentPosition(
-            edit.getTransport().getCurrentPosition() + secondsPerBeat);
-
-    } else {
-        edit.getTransport().setCurrentPosition(nearestBeatTime);
-    }
+    // a position already on a beat moves on to the next one
+    edit.getTransport().setPosition(
+        tempoMap->getNextBeat(edit.getTransport().getPosition()));
 }
 
 void TracksListViewModel::nudgeTransportBackwardToNearestBeat() {
-    double nearestBeatTime =
-        tracktion::TimecodeSnapType::get1BeatSnapType()
-            .roundTimeDown(edit.getTransport().getPosition(),
-                           edit.tempoSequence)
-            .inSeconds();
-
-    // Check if we are on a beat already
-    if (nearestBeatTime == edit.getTransport().getCurrentPosition()) {
-        double secondsPerBeat =
-            1.0 / edit.tempoSequence.getBeatsPerSecondAt(
-                      tracktion::TimePosition::fromSeconds(0.0));
-        edit.getTransport().setCurrentPosition(
-            edit.getTransport().getCurrentPosition() - secondsPerBeat);
-
-    } else {
-        edit.getTransport().setCurrentPosition(nearestBeatTime);
-    }
+    // a position already on a beat moves back to the previous one
+    edit.getTransport().setPosition(
+        tempoMap->getPreviousBeat(edit.getTransport().getPosition()));
 }
 
 void TracksListViewModel::setLoopIn() {
@@ -357,22 +342,9 @@ void TracksListViewModel::nudgeLoopInForwardToNearestBeat() {
         edit.getTransport().looping.setValue(true, nullptr);
     edit.getTransport().setPosition(edit.getTransport().loopPoint1);
 
-    double nearestBeatTime =
-        tracktion::TimecodeSnapType::get1BeatSnapType()
-            .roundTimeUp(edit.getTransport().getPosition(), edit.tempoSequence)
-            .inSeconds();
-
-    // Check if we are on a beat already
-    if (nearestBeatTime == edit.getTransport().getCurrentPosition()) {
-        double secondsPerBeat =
-            1.0 / edit.tempoSequence.getBeatsPerSecondAt(
-                      tracktion::TimePosition::fromSeconds(0.0));
-        edit.getTransport().setCurrentPosition(
-            edit.getTransport().getCurrentPosition() + secondsPerBeat);
-
-    } else {
-        edit.getTransport().setCurrentPosition(nearestBeatTime);
-    }
+    // a position already on a beat moves on to the next one
+    edit.getTransport().setPosition(
+        tempoMap->getNextBeat(edit.getTransport().getPosition()));
 
     setLoopIn();
 }
@@ -383,23 +355,9 @@ void TracksListViewModel::nudgeLoopInBackwardToNearestBeat() {
 
     edit.getTransport().setPosition(edit.getTransport().loopPoint1);
 
-    double nearestBeatTime =
-        tracktion::TimecodeSnapType::get1BeatSnapType()
-            .roundTimeDown(edit.getTransport().getPosition(),
-                           edit.tempoSequence)
-            .inSeconds();
-
-    // Check if we are on a beat already
-    if (nearestBeatTime == edit.getTransport().getCurrentPosition()) {
-        double secondsPerBeat =
-            1.0 / edit.tempoSequence.getBeatsPerSecondAt(
-                      tracktion::TimePosition::fromSeconds(0.0));
-        edit.getTransport().setCurrentPosition(
-            edit.getTransport().getCurrentPosition() - secondsPerBeat);
-
-    } else {
-        edit.getTransport().setCurrentPosition(nearestBeatTime);
-    }
+    // a position already on a beat moves back to the previous one
+    edit.getTransport().setPosition(
+        tempoMap->getPreviousBeat(edit.getTransport().getPosition()));
 
     setLoopIn();
 }
@@ -409,22 +367,9 @@ void TracksListViewModel::nudgeLoopOutForwardToNearestBeat() {
         edit.getTransport().looping.setValue(true, nullptr);
     edit.getTransport().setPosition(edit.getTransport().loopPoint2);
 
-    double nearestBeatTime =
-        tracktion::TimecodeSnapType::get1BeatSnapType()
-            .roundTimeUp(edit.getTransport().getPosition(), edit.tempoSequence)
-            .inSeconds();
-
-    // Check if we are on a beat already
-    if (nearestBeatTime == edit.getTransport().getCurrentPosition()) {
-        double secondsPerBeat =
-            1.0 / edit.tempoSequence.getBeatsPerSecondAt(
-                      tracktion::TimePosition::fromSeconds(0.0));
-        edit.getTransport().setCurrentPosition(
-            edit.getTransport().getCurrentPosition() + secondsPerBeat);
-
-    } else {
-        edit.getTransport().setCurrentPosition(nearestBeatTime);
-    }
+    // a position already on a beat moves on to the next one
+    edit.getTransport().setPosition(
+        tempoMap->getNextBeat(edit.getTransport().getPosition()));
 
     setLoopOut();
 }
@@ -435,23 +380,9 @@ void TracksListViewModel::nudgeLoopOutBackwardToNearestBeat() {
 
     edit.getTransport().setPosition(edit.getTransport().loopPoint2);
 
-    double nearestBeatTime =
-        tracktion::TimecodeSnapType::get1BeatSnapType()
-            .roundTimeDown(edit.getTransport().getPosition(),
-                           edit.tempoSequence)
-            .inSeconds();
-
-    // Check if we are on a beat already
-    if (nearestBeatTime == edit.getTransport().getCurrentPosition()) {
-        double secondsPerBeat =
-            1.0 / edit.tempoSequence.getBeatsPerSecondAt(
-                      tracktion::TimePosition::fromSeconds(0.0));
-        edit.getTransport().setCurrentPosition(
-            edit.getTransport().getCurrentPosition() - secondsPerBeat);
-
-    } else {
-        edit.getTransport().setCurrentPosition(nearestBeatTime);
-    }
+    // a position already on a beat moves back to the previous one
+    edit.getTransport().setPosition(
+        tempoMap->getPreviousBeat(edit.getTransport().getPosition()));
 
     setLoopOut();
 }
@@ -484,6 +415,67 @@ void TracksListViewModel::toggleMute() {
         selectedTrack->setMute(!selectedTrack->isMuted(false));
 }
 
+bool TracksListViewModel::getSelectedTrackFreezeState() {
+    if (auto selectedTrack = dynamic_cast<tracktion::AudioTrack *>(
+            listViewModel.getSelectedItem()))
+        return selectedTrack->isFrozen(tracktion::Track::individualFreeze);
+    else
+        return false;
+}
+
+void TracksListViewModel::toggleFreeze() {
+    if (auto selectedTrack = dynamic_cast<tracktion::AudioTrack *>(
+            listViewModel.getSelectedItem())) {
+        // the freeze render needs the playback context to itself
+        auto &transport = edit.getTransport();
+        if (transport.isPlaying() || transport.isRecording())
+            return;
+
+        bool shouldBeFrozen =
+            !selectedTrack->isFrozen(tracktion::Track::individualFreeze);
+
+        // plugins have to be reloaded before the track is unfrozen so the
+        // rebuilt playback graph can process them again
+        if (!shouldBeFrozen)
+            for (auto plugin : selectedTrack->pluginList.getPlugins())
+                plugin->setProcessingEnabled(true);
+
+        // Tracktion renders the freeze file on a background job (shown with
+        // the progress view) and swaps playback over to it once done
+        selectedTrack->setFrozen(shouldBeFrozen,
+                                 tracktion::Track::individualFreeze);
+    }
+}
+
+void TracksListViewModel::updatePluginProcessingForFrozenTracks() {
+    bool isWaitingForRender = false;
+    for (auto track : tracktion::getAudioTracks(edit)) {
+        // only unload the plugins once the freeze file has been rendered
+        bool isFrozen = track->isFrozen(tracktion::Track::individualFreeze) &&
+                        track->getFreezeFile().existsAsFile();
+        if (track->isFrozen(tracktion::Track::individualFreeze) && !isFrozen)
+            isWaitingForRender = true;
+
+        // use the same plugin list the plugins tab shows so the volume and
+        // level meter plugins keep running
+        PluginsListAdapter pluginsAdapter(track);
+        for (int i = 0; i < pluginsAdapter.size(); i++)
+            if (auto plugin = dynamic_cast<tracktion::Plugin *>(
+                    pluginsAdapter.getItemAtIndex(i)))
+                if (plugin->isProcessingEnabled() == isFrozen)
+                    plugin->setProcessingEnabled(!isFrozen);
+    }
+
+    // the render runs on a background job and nothing in the edit changes
+    // when it finishes, so keep checking until the freeze file shows up
+    if (isWaitingForRender)
+        startTimer(freezeRenderPollMs);
+    else
+        stopTimer();
+}
+
+void TracksListViewModel::timerCallback() { markAndUpdate(shouldUpdateFreeze); }
+
 void TracksListViewModel::setSelectedTrackColour(juce::Colour colour) {
     if (auto selectedTrack = dynamic_cast<tracktion::AudioTrack *>(
             listViewModel.getSelectedItem()))
@@ -541,9 +533,18 @@ void TracksListViewModel::handleAsyncUpdate() {
             listeners.call([selectedTrack](Listener &l) {
                 l.muteStateChanged(selectedTrack->isMuted(false));
             });
+
+    if (compareAndReset(shouldUpdateFreeze)) {
+        updatePluginProcessingForFrozenTracks();
+        listeners.call([this](Listener &l) {
+            l.freezeStateChanged(getSelectedTrackFreezeState());
+        });
+    }
 }
 
 void TracksListViewModel::selectedIndexChanged(int newIndex) {
+    markAndUpdate(shouldUpdateFreeze);
+
     for (auto instance : edit.getAllInputDevices()) {
         if (instance->getInputDevice().getDeviceType() ==
             tracktion::InputDevice::physicalMidiDevice) {
@@ -593,6 +594,10 @@ void TracksListViewModel::valueTreePropertyChanged(
     if (tracktion::TrackList::isTrack(treeWhosePropertyHasChanged))
         if (property == tracktion::IDs::mute)
             markAndUpdate(shouldUpdateMute);
+
+    if (tracktion::TrackList::isTrack(treeWhosePropertyHasChanged))
+        if (property == tracktion::IDs::frozenIndividually)
+            markAndUpdate(shouldUpdateFreeze);
 }
 
 void TracksListViewModel::addListener(Listener *l) {
@@ -606,6 +611,8 @@ void TracksListViewModel::addListener(Listener *l) {
             listViewModel.getSelectedItem())) {
         l->soloStateChanged(selectedTrack->isSolo(false));
         l->muteStateChanged(selectedTrack->isMuted(false));
+        l->freezeStateChanged(
+            selectedTrack->isFrozen(tracktion::Track::individualFreeze));
     }
 }
 
@@ -14,7 +14,8 @@ class TracksListViewModel : public juce::ValueTree::Listener,
                             private juce::ChangeListener,
                             private tracktion::TransportControl::Listener,
                             private EditItemListViewModel::Listener,
-                            private ItemListState::Listener {
+                            private ItemListState::Listener,
+                            private juce::Timer {
   public:
     enum class TracksViewType { MULTI_TRACK, SINGLE_TRACK };
 
@@ -56,6 +57,11 @@ class TracksListViewModel : public juce::ValueTree::Listener,
     void toggleSolo();
     void toggleMute();
 
+    // Freezing renders the selected track's instrument and effects chain to
+    // a freeze file that is played back in place of the plugins
+    bool getSelectedTrackFreezeState();
+    void toggleFreeze();
+
     void setSelectedTrackColour(juce::Colour colour);
     juce::Colour getSelectedTrackColour();
 
@@ -71,6 +77,7 @@ class TracksListViewModel : public juce::ValueTree::Listener,
         virtual void loopingChanged(bool isLooping) {}
         virtual void soloStateChanged(bool solo) {}
         virtual void muteStateChanged(bool mute) {}
+        virtual void freezeStateChanged(bool frozen) {}
     };
 
     void addListener(Listener *l);
@@ -81,6 +88,8 @@ class TracksListViewModel : public juce::ValueTree::Listener,
     app_services::TimelineCamera &camera;
     std::unique_ptr<TracksListAdapter> adapter;
     juce::ValueTree state;
+    std::shared_ptr<ValueTreeChangeDispatcher> dispatcher;
+    std::shared_ptr<app_services::TempoMap> tempoMap;
 
     juce::CachedValue<int> tracksViewType;
     juce::ListenerList<Listener> listeners;
@@ -90,8 +99,14 @@ class TracksListViewModel : public juce::ValueTree::Listener,
     bool shouldUpdateLooping = false;
     bool shouldUpdateSolo = false;
     bool shouldUpdateMute = false;
+    bool shouldUpdateFreeze = false;
+
+    // how often to check for the freeze file while a render is running
+    static constexpr int freezeRenderPollMs = 250;
 
     void initialiseInputs();
+    void updatePluginProcessingForFrozenTracks();
+    void timerCallback() override;
 
     void handleAsyncUpdate() override;
 
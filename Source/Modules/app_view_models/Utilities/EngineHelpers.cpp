@@ -34,11 +34,4 @@ EngineHelpers::getVolumeAndPanPluginForTrack(tracktion::Track *track) {
         .getLast();
 }
 
-template <typename ClipType>
-typename ClipType::Ptr loopAroundClip(ClipType &clip) {
-    auto &transport = clip.edit.getTransport();
-    transport.setLoopRange(clip.getEditTimeRange());
-    transport.looping = true;
-    return clip;
-}
 } // namespace app_view_models
\ No newline at end of file
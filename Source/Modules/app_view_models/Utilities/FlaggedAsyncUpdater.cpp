@@ -1,6 +1,14 @@
 #include "FlaggedAsyncUpdater.h"
 
 namespace app_view_models {
+
+static std::atomic<juce::uint64> nextCreationOrder{0};
+
+FlaggedAsyncUpdater::FlaggedAsyncUpdater()
+    : creationOrder(nextCreationOrder.fetch_add(1)) {}
+
+FlaggedAsyncUpdater::~FlaggedAsyncUpdater() { cancelPendingUpdate(); }
+
 void FlaggedAsyncUpdater::markAndUpdate(bool &flag) {
     flag = true;
     triggerAsyncUpdate();
@@ -13,4 +21,24 @@ bool FlaggedAsyncUpdater::compareAndReset(bool &flag) noexcept {
     flag = false;
     return true;
 }
-} // namespace app_view_models
\ No newline at end of file
+
+void FlaggedAsyncUpdater::triggerAsyncUpdate() {
+    if (!updatePending.exchange(true))
+        batcher->schedule(*this);
+}
+
+void FlaggedAsyncUpdater::cancelPendingUpdate() noexcept {
+    updatePending = false;
+    batcher->cancel(*this);
+}
+
+void FlaggedAsyncUpdater::handleUpdateNowIfNeeded() {
+    if (updatePending.exchange(false))
+        handleAsyncUpdate();
+}
+
+bool FlaggedAsyncUpdater::isUpdatePending() const noexcept {
+    return updatePending;
+}
+
+} // namespace app_view_models
@@ -2,11 +2,43 @@
 
 namespace app_view_models {
 
-class FlaggedAsyncUpdater : public juce::AsyncUpdater {
+// Base for view models that collect changes in flags and hand them to their
+// listeners asynchronously.
+//
+// It keeps the juce::AsyncUpdater interface, but instead of every instance
+// posting its own message the pending updates are queued in the shared
+// UpdateBatcher, which runs all of them together once per UI frame.
+class FlaggedAsyncUpdater {
   public:
+    FlaggedAsyncUpdater();
+    virtual ~FlaggedAsyncUpdater();
+
     void markAndUpdate(bool &flag);
 
     bool compareAndReset(bool &flag) noexcept;
+
+    // Must be called on the message thread, handleAsyncUpdate runs with the
+    // next frame
+    void triggerAsyncUpdate();
+    void cancelPendingUpdate() noexcept;
+    // Runs a pending update right away, the tests use this to flush
+    void handleUpdateNowIfNeeded();
+    bool isUpdatePending() const noexcept;
+
+    virtual void handleAsyncUpdate() = 0;
+
+  private:
+    friend class UpdateBatcher;
+
+    // updates are flushed in the order their updaters were created, which
+    // puts models ahead of the ones created for them
+    const juce::uint64 creationOrder;
+    // only touched by the batcher
+    juce::uint64 lastFlushedFrame = 0;
+    std::atomic<bool> updatePending{false};
+    juce::SharedResourcePointer<UpdateBatcher> batcher;
+
+    JUCE_DECLARE_NON_COPYABLE(FlaggedAsyncUpdater)
 };
 
 } // namespace app_view_models
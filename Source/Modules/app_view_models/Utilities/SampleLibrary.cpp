@@ -0,0 +1,386 @@
+#include "SampleLibrary.h"
+
+namespace app_view_models {
+
+// Directories first, then files, in the order the browser shows them
+static bool comesBefore(const juce::File &a, bool aIsDirectory,
+                        const juce::File &b, bool bIsDirectory) {
+    if (aIsDirectory != bIsDirectory)
+        return aIsDirectory;
+
+    return a.getFileName().compareNatural(b.getFileName()) < 0;
+}
+
+SampleLibrary::SampleLibrary() : juce::Thread("Sample Library") {
+    formatManager.registerBasicFormats();
+    startThread();
+}
+
+SampleLibrary::~SampleLibrary() { stopThread(4000); }
+
+void SampleLibrary::addRoot(const juce::File &directory) {
+    {
+        const juce::ScopedLock sl(lock);
+        if (roots.contains(directory))
+            return;
+
+        roots.add(directory);
+    }
+
+    requestIndexing();
+}
+
+void SampleLibrary::refresh(const juce::File &directory) {
+    storeDirectory(directory, listDirectory(directory));
+    requestIndexing();
+    triggerAsyncUpdate();
+}
+
+int SampleLibrary::getNumEntries(const juce::File &directory) {
+    listIfNotIndexed(directory);
+
+    const juce::ScopedLock sl(lock);
+    auto found = directories.find(directory.getFullPathName());
+    return found == directories.end() ? 0 : int(found->second.items.size());
+}
+
+std::vector<SampleLibrary::Entry>
+SampleLibrary::getEntries(const juce::File &directory, int startIndex,
+                          int numEntries) {
+    listIfNotIndexed(directory);
+
+    std::vector<Entry> entries;
+    const juce::ScopedLock sl(lock);
+    auto found = directories.find(directory.getFullPathName());
+    if (found == directories.end())
+        return entries;
+
+    auto &items = found->second.items;
+    auto endIndex = juce::jmin(int(items.size()), startIndex + numEntries);
+    for (int i = juce::jmax(0, startIndex); i < endIndex; ++i)
+        entries.push_back(items[size_t(i)].entry);
+
+    return entries;
+}
+
+int SampleLibrary::indexOf(const juce::File &file) {
+    auto parent = file.getParentDirectory();
+    listIfNotIndexed(parent);
+
+    const juce::ScopedLock sl(lock);
+    auto found = directories.find(parent.getFullPathName());
+    if (found == directories.end())
+        return -1;
+
+    auto &items = found->second.items;
+    for (auto isDirectory : {false, true}) {
+        auto item = findItem(found->second, file, isDirectory);
+        if (item != items.end())
+            return int(std::distance(items.begin(), item));
+    }
+
+    return -1;
+}
+
+std::vector<SampleLibrary::Entry>
+SampleLibrary::search(const juce::String &prefix, int maxResults) {
+    const juce::ScopedLock sl(lock);
+    if (searchIndexIsStale) {
+        searchIndex.clear();
+        for (auto &directory : directories)
+            for (auto &item : directory.second.items)
+                if (item.entry.hasInfo)
+                    searchIndex.emplace_back(item.entry.name.toLowerCase(),
+                                             item.entry);
+
+        std::sort(
+            searchIndex.begin(), searchIndex.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+        searchIndexIsStale = false;
+    }
+
+    auto lowerCasePrefix = prefix.toLowerCase();
+    auto match = std::lower_bound(
+        searchIndex.begin(), searchIndex.end(), lowerCasePrefix,
+        [](const auto &a, const juce::String &p) { return a.first < p; });
+
+    std::vector<Entry> results;
+    for (; match != searchIndex.end() && int(results.size()) < maxResults &&
+           match->first.startsWith(lowerCasePrefix);
+         ++match)
+        results.push_back(match->second);
+
+    return results;
+}
+
+bool SampleLibrary::waitUntilIndexed(int timeoutMs) {
+    auto timeout =
+        juce::Time::getMillisecondCounter() + juce::uint32(timeoutMs);
+    for (;;) {
+        {
+            const juce::ScopedLock sl(lock);
+            if (numRequestsIndexed == numRequests)
+                return true;
+        }
+
+        if (juce::Time::getMillisecondCounter() >= timeout)
+            return false;
+
+        juce::Thread::sleep(5);
+    }
+}
+
+void SampleLibrary::addListener(Listener *l) { listeners.add(l); }
+
+void SampleLibrary::removeListener(Listener *l) { listeners.remove(l); }
+
+SampleLibrary::Directory
+SampleLibrary::listDirectory(const juce::File &directory) {
+    Directory listed;
+
+    // one pass for directories and files, each entry comes with its size
+    // and modification time without asking the filesystem again
+    for (const auto &child : juce::RangedDirectoryIterator(
+             directory, false, "*",
+             juce::File::findFilesAndDirectories)) {
+        Item item;
+        item.entry.file = child.getFile();
+        item.entry.name = item.entry.file.getFileNameWithoutExtension();
+        item.entry.isDirectory = child.isDirectory();
+        item.size = child.getFileSize();
+        item.modificationTime = child.getModificationTime().toMilliseconds();
+        item.hasBeenRead = item.entry.isDirectory;
+        listed.items.push_back(std::move(item));
+    }
+
+    std::sort(listed.items.begin(), listed.items.end(),
+              [](const Item &a, const Item &b) {
+                  return comesBefore(a.entry.file, a.entry.isDirectory,
+                                     b.entry.file, b.entry.isDirectory);
+              });
+    return listed;
+}
+
+bool SampleLibrary::isSameListing(const Directory &a, const Directory &b) {
+    return std::equal(
+        a.items.begin(), a.items.end(), b.items.begin(), b.items.end(),
+        [](const Item &x, const Item &y) {
+            return x.entry.file == y.entry.file &&
+                   x.entry.isDirectory == y.entry.isDirectory &&
+                   x.size == y.size &&
+                   x.modificationTime == y.modificationTime;
+        });
+}
+
+std::vector<SampleLibrary::Item>::iterator
+SampleLibrary::findItem(Directory &directory, const juce::File &file,
+                        bool isDirectory) {
+    auto &items = directory.items;
+    auto item = std::lower_bound(
+        items.begin(), items.end(), file,
+        [isDirectory](const Item &a, const juce::File &f) {
+            return comesBefore(a.entry.file, a.entry.isDirectory, f,
+                               isDirectory);
+        });
+
+    // names only differing in case compare equal
+    for (; item != items.end() &&
+           !comesBefore(file, isDirectory, item->entry.file,
+                        item->entry.isDirectory);
+         ++item)
+        if (item->entry.file == file)
+            return item;
+
+    return items.end();
+}
+
+void SampleLibrary::storeDirectory(const juce::File &directory,
+                                   Directory listed) {
+    const juce::ScopedLock sl(lock);
+    auto path = directory.getFullPathName();
+    auto previous = directories.find(path);
+    if (previous != directories.end()) {
+        // files that did not change keep what was read from them
+        for (auto &item : listed.items) {
+            if (item.entry.isDirectory)
+                continue;
+
+            auto old = findItem(previous->second, item.entry.file, false);
+            if (old != previous->second.items.end() && old->hasBeenRead &&
+                old->size == item.size &&
+                old->modificationTime == item.modificationTime) {
+                item.entry = old->entry;
+                item.hasBeenRead = true;
+            }
+        }
+    }
+
+    directories[path] = std::move(listed);
+    searchIndexIsStale = true;
+}
+
+void SampleLibrary::listIfNotIndexed(const juce::File &directory) {
+    {
+        const juce::ScopedLock sl(lock);
+        if (directories.count(directory.getFullPathName()) > 0)
+            return;
+    }
+
+    if (!directory.isDirectory())
+        return;
+
+    storeDirectory(directory, listDirectory(directory));
+    requestIndexing();
+}
+
+void SampleLibrary::requestIndexing() {
+    {
+        const juce::ScopedLock sl(lock);
+        ++numRequests;
+    }
+
+    notify();
+}
+
+bool SampleLibrary::rescan() {
+    std::vector<juce::File> pending;
+    {
+        const juce::ScopedLock sl(lock);
+        for (auto &root : roots)
+            pending.push_back(root);
+
+        // directories listed on demand outside the roots are kept current
+        // too
+        for (auto &directory : directories)
+            pending.push_back(juce::File(directory.first));
+    }
+
+    std::set<juce::String> visited;
+    auto changed = false;
+    while (!pending.empty() && !threadShouldExit()) {
+        auto directory = pending.back();
+        pending.pop_back();
+        if (!visited.insert(directory.getFullPathName()).second)
+            continue;
+
+        if (!directory.isDirectory()) {
+            const juce::ScopedLock sl(lock);
+            if (directories.erase(directory.getFullPathName()) > 0) {
+                searchIndexIsStale = true;
+                changed = true;
+            }
+            continue;
+        }
+
+        // listed every time rather than only when the directory changed,
+        // since rewriting a file in place leaves its directory untouched
+        auto listed = listDirectory(directory);
+        for (auto &item : listed.items)
+            if (item.entry.isDirectory)
+                pending.push_back(item.entry.file);
+
+        {
+            const juce::ScopedLock sl(lock);
+            auto found = directories.find(directory.getFullPathName());
+            if (found != directories.end() &&
+                isSameListing(found->second, listed))
+                continue;
+        }
+
+        storeDirectory(directory, std::move(listed));
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool SampleLibrary::readAudioInfo() {
+    std::vector<juce::File> unread;
+    {
+        const juce::ScopedLock sl(lock);
+        for (auto &directory : directories)
+            for (auto &item : directory.second.items)
+                if (!item.hasBeenRead)
+                    unread.push_back(item.entry.file);
+    }
+
+    for (auto &file : unread) {
+        if (threadShouldExit())
+            break;
+
+        Entry entry;
+        entry.file = file;
+        entry.name = file.getFileNameWithoutExtension();
+        readInfo(entry);
+
+        // the directory may have been listed again in the meantime
+        const juce::ScopedLock sl(lock);
+        auto directory =
+            directories.find(file.getParentDirectory().getFullPathName());
+        if (directory == directories.end())
+            continue;
+
+        auto item = findItem(directory->second, file, false);
+        if (item == directory->second.items.end())
+            continue;
+
+        item->entry = entry;
+        item->hasBeenRead = true;
+        searchIndexIsStale = true;
+    }
+
+    return !unread.empty();
+}
+
+void SampleLibrary::readInfo(Entry &entry) {
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(entry.file));
+    if (reader == nullptr || reader->sampleRate <= 0.0)
+        return;
+
+    entry.hasInfo = true;
+    entry.sampleRate = reader->sampleRate;
+    entry.numChannels = int(reader->numChannels);
+    entry.lengthInSeconds =
+        double(reader->lengthInSamples) / reader->sampleRate;
+
+    if (entry.numChannels <= 0 || reader->lengthInSamples <= 0)
+        return;
+
+    std::vector<juce::Range<float>> levels(size_t(entry.numChannels));
+    reader->readMaxLevels(0, reader->lengthInSamples, levels.data(),
+                          entry.numChannels);
+    for (auto &level : levels)
+        entry.peak = juce::jmax(entry.peak, std::abs(level.getStart()),
+                                std::abs(level.getEnd()));
+}
+
+void SampleLibrary::run() {
+    while (!threadShouldExit()) {
+        int requested;
+        {
+            const juce::ScopedLock sl(lock);
+            requested = numRequests;
+        }
+
+        auto changed = rescan();
+        changed = readAudioInfo() || changed;
+        if (changed) {
+            triggerAsyncUpdate();
+            continue;
+        }
+
+        {
+            const juce::ScopedLock sl(lock);
+            numRequestsIndexed = requested;
+        }
+
+        wait(rescanIntervalMs);
+    }
+}
+
+void SampleLibrary::handleAsyncUpdate() {
+    listeners.call([](Listener &l) { l.sampleLibraryChanged(); });
+}
+
+} // namespace app_view_models
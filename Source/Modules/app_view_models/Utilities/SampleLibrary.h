@@ -0,0 +1,119 @@
+#pragma once
+
+namespace app_view_models {
+
+// An index of the samples below a set of root directories, built and kept
+// current by a background thread so browsing them never touches the
+// filesystem.
+//
+// Each directory is listed once, directories first and then files, both in
+// natural name order. The thread then reads the duration, sample rate,
+// channel count and peak level of every audio file. Every few seconds it
+// lists the indexed directories again and reads only the files that are new
+// or whose size or modification time changed, which also catches a file
+// rewritten in place without its directory changing.
+//
+// Listeners are told on the message thread whenever entries changed. View
+// models share the library through juce::SharedResourcePointer.
+class SampleLibrary : private juce::Thread, private juce::AsyncUpdater {
+  public:
+    struct Entry {
+        juce::File file;
+        juce::String name;
+        bool isDirectory = false;
+
+        // set once the background thread read the file as audio, stays
+        // false for directories and anything that is not audio
+        bool hasInfo = false;
+        double lengthInSeconds = 0.0;
+        double sampleRate = 0.0;
+        int numChannels = 0;
+        float peak = 0.0f;
+    };
+
+    static constexpr int rescanIntervalMs = 5000;
+
+    SampleLibrary();
+    ~SampleLibrary() override;
+
+    // Indexes everything below directory, does nothing if it already is
+    void addRoot(const juce::File &directory);
+
+    // Lists directory again straight away, for when a file was just written
+    // to it
+    void refresh(const juce::File &directory);
+
+    // A directory that is not in the index yet is listed here, its audio info
+    // follows from the background thread
+    int getNumEntries(const juce::File &directory);
+    std::vector<Entry> getEntries(const juce::File &directory, int startIndex,
+                                  int numEntries);
+
+    // The index of file among the entries of its directory, or -1
+    int indexOf(const juce::File &file);
+
+    // Audio files anywhere in the index whose name starts with prefix,
+    // ignoring case, in name order
+    std::vector<Entry> search(const juce::String &prefix, int maxResults);
+
+    // Blocks until everything asked for has been listed and read or the
+    // timeout passed, returns whether the index is complete
+    bool waitUntilIndexed(int timeoutMs);
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void sampleLibraryChanged() = 0;
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    struct Item {
+        Entry entry;
+
+        // tell a file that was rewritten from one already read
+        juce::int64 size = 0;
+        juce::int64 modificationTime = 0;
+        bool hasBeenRead = false;
+    };
+
+    struct Directory {
+        std::vector<Item> items;
+    };
+
+    juce::AudioFormatManager formatManager;
+
+    juce::CriticalSection lock;
+    juce::Array<juce::File> roots;
+    std::map<juce::String, Directory> directories;
+    int numRequests = 0;
+    int numRequestsIndexed = 0;
+
+    // lower case names of every audio file, sorted, rebuilt after a change
+    std::vector<std::pair<juce::String, Entry>> searchIndex;
+    bool searchIndexIsStale = true;
+
+    juce::ListenerList<Listener> listeners;
+
+    static Directory listDirectory(const juce::File &directory);
+    static bool isSameListing(const Directory &a, const Directory &b);
+    static std::vector<Item>::iterator
+    findItem(Directory &directory, const juce::File &file, bool isDirectory);
+    void storeDirectory(const juce::File &directory, Directory listed);
+    void listIfNotIndexed(const juce::File &directory);
+    void requestIndexing();
+
+    bool rescan();
+    bool readAudioInfo();
+    void readInfo(Entry &entry);
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE(SampleLibrary)
+};
+
+} // namespace app_view_models
@@ -0,0 +1,258 @@
+#include "ThumbnailCache.h"
+
+namespace app_view_models {
+
+ThumbnailCache::ThumbnailCache()
+    : ThumbnailCache(ConfigurationHelpers::getThumbnailsDirectory()) {}
+
+ThumbnailCache::ThumbnailCache(const juce::File &d, juce::int64 maxBytes)
+    : juce::AudioThumbnailCache(numThumbnailsInMemory),
+      juce::Thread("Thumbnails"), directory(d), maxBytesOnDisk(maxBytes) {
+    formatManager.registerBasicFormats();
+    directory.createDirectory();
+    startThread(juce::Thread::Priority::low);
+}
+
+ThumbnailCache::~ThumbnailCache() { stopThread(4000); }
+
+void ThumbnailCache::addCopiedDirectory(const juce::File &copy,
+                                        const juce::File &source) {
+    const juce::ScopedLock sl(copiesLock);
+    copiedDirectories.emplace_back(copy, source);
+}
+
+ThumbnailCache::FileSource::FileSource(const ThumbnailCache &cache,
+                                       const juce::File &f)
+    : file(f), hash(cache.getHashCode(f)) {}
+
+juce::InputStream *ThumbnailCache::FileSource::createInputStream() {
+    return file.createInputStream().release();
+}
+
+juce::InputStream *ThumbnailCache::FileSource::createInputStreamFor(
+    const juce::String &relatedItemPath) {
+    return file.getSiblingFile(relatedItemPath).createInputStream().release();
+}
+
+juce::int64 ThumbnailCache::FileSource::hashCode() const { return hash; }
+
+juce::int64 ThumbnailCache::getHashCode(const juce::File &file) const {
+    auto source = getSourceFile(file);
+    auto hash = source.getFullPathName().hashCode64();
+    hash = hash * 31 + source.getSize();
+    return hash * 31 + source.getLastModificationTime().toMilliseconds();
+}
+
+void ThumbnailCache::generate(const juce::Array<juce::File> &files) {
+    {
+        const juce::ScopedLock sl(queueLock);
+        // the files asked for last are most likely the ones being looked at
+        for (int i = files.size(); --i >= 0;)
+            queue.push_front(files.getReference(i));
+    }
+
+    notify();
+}
+
+void ThumbnailCache::generate(const juce::File &fileOrDirectory) {
+    generate(juce::Array<juce::File>{fileOrDirectory});
+}
+
+bool ThumbnailCache::hasThumbnailOnDisk(const juce::File &file) const {
+    return getThumbnailFile(getHashCode(file)).existsAsFile();
+}
+
+bool ThumbnailCache::waitUntilGenerated(int timeoutMs) {
+    auto timeout =
+        juce::Time::getMillisecondCounter() + juce::uint32(timeoutMs);
+    for (;;) {
+        {
+            const juce::ScopedLock sl(queueLock);
+            if (queue.empty() && !generating && !hasNewThumbnails)
+                return true;
+        }
+
+        if (juce::Time::getMillisecondCounter() >= timeout)
+            return false;
+
+        juce::Thread::sleep(5);
+    }
+}
+
+const juce::File &ThumbnailCache::getDirectory() const { return directory; }
+
+bool ThumbnailCache::loadNewThumb(juce::AudioThumbnailBase &thumb,
+                                  juce::int64 hashCode) {
+    auto file = getThumbnailFile(hashCode);
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+        return false;
+
+    if (thumb.loadFrom(in)) {
+        // the oldest thumbnails are the first to go when the directory is
+        // pruned, so one in use is marked as new again
+        file.setLastModificationTime(juce::Time::getCurrentTime());
+        return true;
+    }
+
+    // written by an older version or cut short, it is generated again
+    file.deleteFile();
+    return false;
+}
+
+void ThumbnailCache::saveNewlyFinishedThumbnail(
+    const juce::AudioThumbnailBase &thumb, juce::int64 hashCode) {
+    auto file = getThumbnailFile(hashCode);
+    if (file.existsAsFile())
+        return;
+
+    // written beside the target and moved over it, so a reader never sees
+    // half a thumbnail
+    juce::TemporaryFile tempFile(file);
+    {
+        juce::FileOutputStream out(tempFile.getFile());
+        if (!out.openedOk())
+            return;
+
+        thumb.saveTo(out);
+    }
+
+    if (!tempFile.overwriteTargetFileWithTemporary())
+        return;
+
+    {
+        const juce::ScopedLock sl(queueLock);
+        hasNewThumbnails = true;
+    }
+
+    notify();
+}
+
+juce::File ThumbnailCache::getThumbnailFile(juce::int64 hashCode) const {
+    return directory.getChildFile(juce::String::toHexString(hashCode) +
+                                  ".thumb");
+}
+
+juce::File ThumbnailCache::getSourceFile(const juce::File &file) const {
+    const juce::ScopedLock sl(copiesLock);
+    for (auto &directories : copiedDirectories) {
+        if (!file.isAChildOf(directories.first))
+            continue;
+
+        auto source = directories.second.getChildFile(
+            file.getRelativePathFrom(directories.first));
+        if (source.existsAsFile())
+            return source;
+    }
+
+    // not a copy, or only the copy is left, like a sample just recorded
+    return file;
+}
+
+bool ThumbnailCache::generateThumbnail(const juce::File &file) {
+    auto hashCode = getHashCode(file);
+    if (getThumbnailFile(hashCode).existsAsFile())
+        return false;
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return false;
+
+    // the thumbnail has no listeners, so filling it here posts no messages
+    juce::AudioThumbnail thumbnail(samplesPerThumbnailSample, formatManager,
+                                   *this);
+    thumbnail.reset(int(reader->numChannels), reader->sampleRate,
+                    reader->lengthInSamples);
+
+    constexpr int blockSize = 65536;
+    juce::AudioBuffer<float> buffer(int(reader->numChannels), blockSize);
+    for (juce::int64 position = 0; position < reader->lengthInSamples;
+         position += blockSize) {
+        if (threadShouldExit())
+            return false;
+
+        auto numSamples = int(juce::jmin(juce::int64(blockSize),
+                                         reader->lengthInSamples - position));
+        reader->read(&buffer, 0, numSamples, position, true, true);
+        thumbnail.addBlock(position, buffer, 0, numSamples);
+    }
+
+    saveNewlyFinishedThumbnail(thumbnail, hashCode);
+    return true;
+}
+
+void ThumbnailCache::pruneDirectory() {
+    auto thumbnails =
+        directory.findChildFiles(juce::File::findFiles, false, "*.thumb");
+
+    juce::int64 totalBytes = 0;
+    for (auto &thumbnail : thumbnails)
+        totalBytes += thumbnail.getSize();
+
+    if (totalBytes <= maxBytesOnDisk)
+        return;
+
+    // least recently used first, loading a thumbnail touches its file
+    std::vector<std::pair<juce::int64, juce::File>> byAge;
+    for (auto &thumbnail : thumbnails)
+        byAge.emplace_back(
+            thumbnail.getLastModificationTime().toMilliseconds(), thumbnail);
+
+    std::sort(byAge.begin(), byAge.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    for (auto &entry : byAge) {
+        if (totalBytes <= maxBytesOnDisk)
+            break;
+
+        auto size = entry.second.getSize();
+        if (entry.second.deleteFile())
+            totalBytes -= size;
+    }
+}
+
+void ThumbnailCache::run() {
+    auto wildcard = formatManager.getWildcardForAllFormats();
+
+    while (!threadShouldExit()) {
+        juce::File file;
+        bool shouldPrune = false;
+        {
+            const juce::ScopedLock sl(queueLock);
+            if (!queue.empty()) {
+                file = queue.front();
+                queue.pop_front();
+            } else {
+                // pruned once the queue ran dry rather than after every file
+                shouldPrune = std::exchange(hasNewThumbnails, false);
+            }
+
+            generating = file != juce::File() || shouldPrune;
+        }
+
+        if (shouldPrune) {
+            pruneDirectory();
+            continue;
+        }
+
+        if (file == juce::File()) {
+            wait(-1);
+            continue;
+        }
+
+        if (file.isDirectory()) {
+            auto children = file.findChildFiles(juce::File::findFiles, true,
+                                                wildcard);
+            const juce::ScopedLock sl(queueLock);
+            for (auto &child : children)
+                queue.push_back(child);
+
+            continue;
+        }
+
+        generateThumbnail(file);
+    }
+}
+
+} // namespace app_view_models
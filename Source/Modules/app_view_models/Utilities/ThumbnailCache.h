@@ -0,0 +1,106 @@
+#pragma once
+
+namespace app_view_models {
+
+// A waveform thumbnail cache that keeps every thumbnail on disk as well as
+// the most recent ones in memory.
+//
+// Thumbnails are keyed by the file's path, size and modification time, so a
+// sample that is replaced or moved gets a new thumbnail. Samples are played
+// from copies of the user's directories made on every start, so files in a
+// copied directory are keyed on the file they were copied from instead.
+//
+// Each thumbnail is stored in its own file in the cache directory, written
+// once the whole file has been read. When the directory grows past its size
+// limit the thumbnails that were used least recently are deleted.
+//
+// Whole directories and kits can be queued for generation on a background
+// thread that decodes the files itself, so by the time a pad or sample is
+// selected its thumbnail is loaded from disk without reading any audio. The
+// files asked for last are generated first. The thread runs at low priority
+// so it does not compete with the audio or the UI.
+//
+// View models share the cache through juce::SharedResourcePointer.
+class ThumbnailCache : public juce::AudioThumbnailCache, private juce::Thread {
+  public:
+    // What the sampler thumbnails use, generated thumbnails match it
+    static constexpr int samplesPerThumbnailSample = 512;
+
+    // enough for the thumbnails of several thousand samples
+    static constexpr juce::int64 defaultMaxBytesOnDisk = 64 * 1024 * 1024;
+
+    ThumbnailCache();
+    explicit ThumbnailCache(const juce::File &directory,
+                            juce::int64 maxBytesOnDisk = defaultMaxBytesOnDisk);
+    ~ThumbnailCache() override;
+
+    // Files below copy are keyed on the file at the same place below source
+    // while that exists, so copying them again keeps their thumbnails
+    void addCopiedDirectory(const juce::File &copy, const juce::File &source);
+
+    // Thumbnail source for a file, use it with AudioThumbnail::setSource so
+    // the thumbnail is looked up under the right key
+    class FileSource : public juce::InputSource {
+      public:
+        FileSource(const ThumbnailCache &cache, const juce::File &f);
+
+        juce::InputStream *createInputStream() override;
+        juce::InputStream *
+        createInputStreamFor(const juce::String &relatedItemPath) override;
+        juce::int64 hashCode() const override;
+
+      private:
+        juce::File file;
+        juce::int64 hash;
+    };
+
+    // The key of a file's thumbnail, which changes with the size and
+    // modification time of the file or the one it was copied from
+    juce::int64 getHashCode(const juce::File &file) const;
+
+    // Queues files, or every audio file below a directory, for generation
+    void generate(const juce::Array<juce::File> &files);
+    void generate(const juce::File &fileOrDirectory);
+
+    bool hasThumbnailOnDisk(const juce::File &file) const;
+
+    // Blocks until everything queued has been generated or the timeout
+    // passed, returns whether the queue is empty
+    bool waitUntilGenerated(int timeoutMs);
+
+    const juce::File &getDirectory() const;
+
+  protected:
+    bool loadNewThumb(juce::AudioThumbnailBase &thumb,
+                      juce::int64 hashCode) override;
+    void saveNewlyFinishedThumbnail(const juce::AudioThumbnailBase &thumb,
+                                    juce::int64 hashCode) override;
+
+  private:
+    juce::File directory;
+    juce::int64 maxBytesOnDisk;
+    juce::AudioFormatManager formatManager;
+
+    juce::CriticalSection copiesLock;
+    std::vector<std::pair<juce::File, juce::File>> copiedDirectories;
+
+    juce::CriticalSection queueLock;
+    std::deque<juce::File> queue;
+    bool generating = false;
+    // set when a thumbnail was written, the thread then checks the size of
+    // the directory
+    bool hasNewThumbnails = false;
+
+    // enough for a drum kit and the samples around the one selected
+    static constexpr int numThumbnailsInMemory = 64;
+
+    juce::File getThumbnailFile(juce::int64 hashCode) const;
+    juce::File getSourceFile(const juce::File &file) const;
+    bool generateThumbnail(const juce::File &file);
+    void pruneDirectory();
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE(ThumbnailCache)
+};
+
+} // namespace app_view_models
@@ -0,0 +1,50 @@
+#include "UpdateBatcher.h"
+
+namespace app_view_models {
+
+UpdateBatcher::~UpdateBatcher() { stopTimer(); }
+
+void UpdateBatcher::schedule(FlaggedAsyncUpdater &updater) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    pending.insert({updater.creationOrder, &updater});
+    if (!isTimerRunning())
+        startTimerHz(framesPerSecond);
+}
+
+void UpdateBatcher::cancel(FlaggedAsyncUpdater &updater) noexcept {
+    pending.erase({updater.creationOrder, &updater});
+}
+
+void UpdateBatcher::flush() {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    frame++;
+
+    // updaters are taken one at a time instead of from a copy of the set, so
+    // one that is deleted by an earlier updater's listeners is never called
+    while (auto updater = popNextForFrame())
+        updater->handleUpdateNowIfNeeded();
+}
+
+FlaggedAsyncUpdater *UpdateBatcher::popNextForFrame() {
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
+        auto updater = it->second;
+        if (updater->lastFlushedFrame != frame) {
+            updater->lastFlushedFrame = frame;
+            pending.erase(it);
+            return updater;
+        }
+    }
+
+    return nullptr;
+}
+
+void UpdateBatcher::timerCallback() {
+    flush();
+
+    if (pending.empty())
+        stopTimer();
+}
+
+} // namespace app_view_models
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace app_view_models {
+
+// Collects the pending updates of every FlaggedAsyncUpdater and flushes them
+// together once per UI frame.
+//
+// A single transport or selection change marks flags in many view models.
+// Posting a message for each of them spreads their listener calls and the
+// repaints those cause over several message loop iterations. Here the first
+// update after an idle period starts a frame timer, and each tick runs every
+// pending update in creation order. Updates triggered while a frame is being
+// flushed run in the same frame, unless their updater has already been
+// flushed in it, then they wait for the next one. The timer stops again once
+// nothing is pending.
+//
+// Updaters share the batcher through juce::SharedResourcePointer, so it
+// exists for as long as any of them does. Everything here runs on the
+// message thread, where the view models are changed, so there is nothing to
+// lock.
+class UpdateBatcher : private juce::Timer {
+  public:
+    static constexpr int framesPerSecond = 60;
+
+    UpdateBatcher() = default;
+    ~UpdateBatcher() override;
+
+    // Both must be called on the message thread
+    void schedule(FlaggedAsyncUpdater &updater);
+    void cancel(FlaggedAsyncUpdater &updater) noexcept;
+
+    // Runs everything that is pending now, this is what each frame does
+    void flush();
+
+  private:
+    // keyed by creation order so the set iterates in flush order
+    std::set<std::pair<juce::uint64, FlaggedAsyncUpdater *>> pending;
+    juce::uint64 frame = 0;
+
+    FlaggedAsyncUpdater *popNextForFrame();
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE(UpdateBatcher)
+};
+
+} // namespace app_view_models
@@ -0,0 +1,210 @@
+#include "ValueTreeChangeDispatcher.h"
+
+namespace app_view_models {
+
+std::shared_ptr<ValueTreeChangeDispatcher>
+ValueTreeChangeDispatcher::getFor(const juce::ValueTree &tree) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    static std::vector<std::weak_ptr<ValueTreeChangeDispatcher>> dispatchers;
+
+    auto root = tree.getRoot();
+    std::shared_ptr<ValueTreeChangeDispatcher> result;
+
+    for (auto it = dispatchers.begin(); it != dispatchers.end();) {
+        if (auto dispatcher = it->lock()) {
+            if (dispatcher->getRoot() == root)
+                result = dispatcher;
+
+            ++it;
+        } else {
+            it = dispatchers.erase(it);
+        }
+    }
+
+    if (result == nullptr) {
+        result = std::make_shared<ValueTreeChangeDispatcher>(root);
+        dispatchers.push_back(result);
+    }
+
+    return result;
+}
+
+ValueTreeChangeDispatcher::ValueTreeChangeDispatcher(
+    juce::ValueTree rootToListenTo)
+    : root(std::move(rootToListenTo)) {
+    root.addListener(this);
+}
+
+ValueTreeChangeDispatcher::~ValueTreeChangeDispatcher() {
+    root.removeListener(this);
+}
+
+ValueTreeChangeDispatcher::Filter
+ValueTreeChangeDispatcher::Filter::ofType(const juce::Identifier &type) {
+    Filter filter;
+    filter.nodeType = type;
+    return filter;
+}
+
+ValueTreeChangeDispatcher::Filter
+ValueTreeChangeDispatcher::Filter::onlyNode(const juce::ValueTree &node) {
+    Filter filter;
+    filter.node = node;
+    return filter;
+}
+
+ValueTreeChangeDispatcher::Filter
+ValueTreeChangeDispatcher::Filter::within(const juce::ValueTree &subtree) {
+    Filter filter;
+    filter.subtree = subtree;
+    return filter;
+}
+
+bool ValueTreeChangeDispatcher::Filter::matches(
+    const juce::ValueTree &tree) const {
+    if (node.isValid() && tree != node)
+        return false;
+
+    if (nodeType.isValid() && !tree.hasType(nodeType))
+        return false;
+
+    if (subtree.isValid() && tree != subtree && !tree.isAChildOf(subtree))
+        return false;
+
+    return true;
+}
+
+void ValueTreeChangeDispatcher::addPropertyListener(
+    juce::ValueTree::Listener *l, const juce::Identifier &property,
+    const Filter &filter) {
+    jassert(l != nullptr);
+    propertySubscriptions[getKey(property)].push_back({l, filter});
+}
+
+void ValueTreeChangeDispatcher::addChildListener(
+    juce::ValueTree::Listener *l, const juce::ValueTree &parent) {
+    jassert(l != nullptr);
+    childSubscriptions.push_back({l, parent});
+}
+
+void ValueTreeChangeDispatcher::removeListener(juce::ValueTree::Listener *l) {
+    for (auto &entry : propertySubscriptions)
+        for (auto &subscription : entry.second)
+            if (subscription.listener == l)
+                subscription.listener = nullptr;
+
+    for (auto &subscription : childSubscriptions)
+        if (subscription.listener == l)
+            subscription.listener = nullptr;
+
+    hasRemovedListeners = true;
+    if (dispatchDepth == 0)
+        eraseRemovedListeners();
+}
+
+const juce::ValueTree &ValueTreeChangeDispatcher::getRoot() const {
+    return root;
+}
+
+const void *
+ValueTreeChangeDispatcher::getKey(const juce::Identifier &property) {
+    return property.getCharPointer().getAddress();
+}
+
+void ValueTreeChangeDispatcher::eraseRemovedListeners() {
+    if (!hasRemovedListeners)
+        return;
+
+    auto isRemoved = [](const auto &subscription) {
+        return subscription.listener == nullptr;
+    };
+
+    for (auto it = propertySubscriptions.begin();
+         it != propertySubscriptions.end();) {
+        auto &subscriptions = it->second;
+        subscriptions.erase(std::remove_if(subscriptions.begin(),
+                                           subscriptions.end(), isRemoved),
+                            subscriptions.end());
+
+        if (subscriptions.empty())
+            it = propertySubscriptions.erase(it);
+        else
+            ++it;
+    }
+
+    childSubscriptions.erase(std::remove_if(childSubscriptions.begin(),
+                                            childSubscriptions.end(),
+                                            isRemoved),
+                             childSubscriptions.end());
+
+    hasRemovedListeners = false;
+}
+
+template <typename Callback>
+void ValueTreeChangeDispatcher::dispatchToChildListeners(
+    const juce::ValueTree &parent, Callback &&callback) {
+    dispatchDepth++;
+
+    // indexed rather than iterated so listeners added by a callback do not
+    // invalidate the loop, they are called from the next change on
+    auto numSubscriptions = childSubscriptions.size();
+    for (size_t i = 0; i < numSubscriptions; ++i) {
+        auto listener = childSubscriptions[i].listener;
+        if (listener != nullptr && childSubscriptions[i].parent == parent)
+            callback(*listener);
+    }
+
+    if (--dispatchDepth == 0)
+        eraseRemovedListeners();
+}
+
+void ValueTreeChangeDispatcher::valueTreePropertyChanged(
+    juce::ValueTree &treeWhosePropertyHasChanged,
+    const juce::Identifier &property) {
+    auto found = propertySubscriptions.find(getKey(property));
+    if (found == propertySubscriptions.end())
+        return;
+
+    dispatchDepth++;
+
+    // the map is only erased from once no callbacks are running, so this
+    // reference stays valid
+    auto &subscriptions = found->second;
+    auto numSubscriptions = subscriptions.size();
+    for (size_t i = 0; i < numSubscriptions; ++i) {
+        auto listener = subscriptions[i].listener;
+        if (listener != nullptr &&
+            subscriptions[i].filter.matches(treeWhosePropertyHasChanged))
+            listener->valueTreePropertyChanged(treeWhosePropertyHasChanged,
+                                               property);
+    }
+
+    if (--dispatchDepth == 0)
+        eraseRemovedListeners();
+}
+
+void ValueTreeChangeDispatcher::valueTreeChildAdded(
+    juce::ValueTree &parentTree, juce::ValueTree &childWhichHasBeenAdded) {
+    dispatchToChildListeners(parentTree, [&](juce::ValueTree::Listener &l) {
+        l.valueTreeChildAdded(parentTree, childWhichHasBeenAdded);
+    });
+}
+
+void ValueTreeChangeDispatcher::valueTreeChildRemoved(
+    juce::ValueTree &parentTree, juce::ValueTree &childWhichHasBeenRemoved,
+    int indexFromWhichChildWasRemoved) {
+    dispatchToChildListeners(parentTree, [&](juce::ValueTree::Listener &l) {
+        l.valueTreeChildRemoved(parentTree, childWhichHasBeenRemoved,
+                                indexFromWhichChildWasRemoved);
+    });
+}
+
+void ValueTreeChangeDispatcher::valueTreeChildOrderChanged(
+    juce::ValueTree &parentTree, int oldIndex, int newIndex) {
+    dispatchToChildListeners(parentTree, [&](juce::ValueTree::Listener &l) {
+        l.valueTreeChildOrderChanged(parentTree, oldIndex, newIndex);
+    });
+}
+
+} // namespace app_view_models
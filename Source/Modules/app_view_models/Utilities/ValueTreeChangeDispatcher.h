@@ -0,0 +1,98 @@
+#pragma once
+
+namespace app_view_models {
+
+// Listens to a tree once and hands each change only to the listeners that
+// asked for it.
+//
+// Registering view models directly on the edit state means every one of them
+// is called for every property change in the edit, automation and plugin
+// parameters included, and has to filter them itself. Here property listeners
+// are indexed by the property they want, so a change costs one lookup and only
+// reaches the listeners for that property. A subscription can be narrowed
+// further to a node type, a single node or a subtree.
+//
+// Listeners keep implementing juce::ValueTree::Listener and receive the same
+// callbacks they would from the tree.
+class ValueTreeChangeDispatcher : private juce::ValueTree::Listener {
+  public:
+    // Returns the dispatcher for the root of the given tree, creating it if
+    // needed. It is shared by everyone listening to that root and goes away
+    // once nobody holds on to it.
+    static std::shared_ptr<ValueTreeChangeDispatcher>
+    getFor(const juce::ValueTree &tree);
+
+    explicit ValueTreeChangeDispatcher(juce::ValueTree rootToListenTo);
+    ~ValueTreeChangeDispatcher() override;
+
+    // Which nodes a property subscription covers, an empty filter matches
+    // every node in the tree
+    struct Filter {
+        juce::Identifier nodeType;
+        juce::ValueTree node;
+        juce::ValueTree subtree;
+
+        static Filter ofType(const juce::Identifier &type);
+        static Filter onlyNode(const juce::ValueTree &node);
+        static Filter within(const juce::ValueTree &subtree);
+
+        bool matches(const juce::ValueTree &tree) const;
+    };
+
+    void addPropertyListener(juce::ValueTree::Listener *l,
+                             const juce::Identifier &property,
+                             const Filter &filter = {});
+
+    // Child added, removed and order changed callbacks for one parent
+    void addChildListener(juce::ValueTree::Listener *l,
+                          const juce::ValueTree &parent);
+
+    // Removes every subscription of the listener, this is safe to call from
+    // inside a callback
+    void removeListener(juce::ValueTree::Listener *l);
+
+    const juce::ValueTree &getRoot() const;
+
+  private:
+    struct PropertySubscription {
+        juce::ValueTree::Listener *listener;
+        Filter filter;
+    };
+
+    struct ChildSubscription {
+        juce::ValueTree::Listener *listener;
+        juce::ValueTree parent;
+    };
+
+    juce::ValueTree root;
+
+    // identifiers are pooled strings, so the address of the name is a cheap
+    // key that is the same for every copy of an identifier
+    std::unordered_map<const void *, std::vector<PropertySubscription>>
+        propertySubscriptions;
+    std::vector<ChildSubscription> childSubscriptions;
+
+    // removed listeners are cleared in place while callbacks are running and
+    // erased once the outermost callback has finished
+    int dispatchDepth = 0;
+    bool hasRemovedListeners = false;
+
+    static const void *getKey(const juce::Identifier &property);
+    void eraseRemovedListeners();
+
+    template <typename Callback>
+    void dispatchToChildListeners(const juce::ValueTree &parent,
+                                  Callback &&callback);
+
+    void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
+                                  const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parentTree,
+                             juce::ValueTree &childWhichHasBeenAdded) override;
+    void valueTreeChildRemoved(juce::ValueTree &parentTree,
+                               juce::ValueTree &childWhichHasBeenRemoved,
+                               int indexFromWhichChildWasRemoved) override;
+    void valueTreeChildOrderChanged(juce::ValueTree &parentTree,
+                                    int oldIndex, int newIndex) override;
+};
+
+} // namespace app_view_models
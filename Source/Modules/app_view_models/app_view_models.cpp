@@ -3,7 +3,11 @@
 
 // Utilities
 #include "Utilities/FlaggedAsyncUpdater.cpp"
+#include "Utilities/UpdateBatcher.cpp"
+#include "Utilities/ValueTreeChangeDispatcher.cpp"
 #include "Utilities/EngineHelpers.cpp"
+#include "Utilities/ThumbnailCache.cpp"
+#include "Utilities/SampleLibrary.cpp"
 
 // EditItemList
 #include "Edit/ItemList/ItemListState.cpp"
@@ -61,6 +65,9 @@
 #include "Edit/Mixer/MixerViewModel.cpp"
 #include "Edit/Mixer/MixerTrackViewModel.cpp"
 
+// Performance
+#include "Edit/Performance/DspLoadViewModel.cpp"
+
 // Settings
 #include "Edit/Settings/SettingsListViewModel.cpp"
 #include "Edit/Settings/DeviceTypeListViewModel.cpp"
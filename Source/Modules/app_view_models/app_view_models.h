@@ -15,6 +15,10 @@
 
 namespace app_view_models {
     class FlaggedAsyncUpdater;
+    class UpdateBatcher;
+    class ValueTreeChangeDispatcher;
+    class ThumbnailCache;
+    class SampleLibrary;
     class MidiCommandManager;
     class ItemListState;
     class EditItemListViewModel;
@@ -58,6 +62,7 @@ namespace app_view_models {
     class AudioBufferSizeListViewModel;
     class MidiInputListViewModel;
     class EditViewModel;
+    class DspLoadViewModel;
 }
 
 #include <juce_data_structures/juce_data_structures.h>
@@ -68,12 +73,22 @@ namespace app_view_models {
 #include <app_models/app_models.h>
 #include <app_services/app_services.h>
 #include <internal_plugins/internal_plugins.h>
+#include <deque>
 #include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
 #include <app_configuration/app_configuration.h>
 
 // Utilities
 #include "Utilities/FlaggedAsyncUpdater.h"
+#include "Utilities/UpdateBatcher.h"
+#include "Utilities/ValueTreeChangeDispatcher.h"
 #include "Utilities/EngineHelpers.h"
+#include "Utilities/ThumbnailCache.h"
+#include "Utilities/SampleLibrary.h"
 
 // ItemList
 #include "Edit/ItemList/ItemListState.h"
@@ -132,6 +147,9 @@ namespace app_view_models {
 #include "Edit/Mixer/MixerViewModel.h"
 #include "Edit/Mixer/MixerTrackViewModel.h"
 
+// Performance
+#include "Edit/Performance/DspLoadViewModel.h"
+
 // Settings
 #include "Edit/Settings/SettingsListViewModel.h"
 #include "Edit/Settings/DeviceTypeListViewModel.h"
@@ -0,0 +1,179 @@
+#include "StepSequencerPlugin.h"
+
+namespace internal_plugins {
+
+const char *StepSequencerPlugin::xmlTypeName = "stepSequencer";
+
+StepSequencerPlugin::StepSequencerPlugin(tracktion::PluginCreationInfo info)
+    : tracktion::Plugin(info) {}
+
+StepSequencerPlugin::~StepSequencerPlugin() { notifyListenersOfDeletion(); }
+
+void StepSequencerPlugin::setPattern(const Pattern &newPattern) {
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+    pattern = newPattern;
+
+    auto v = version.load(std::memory_order_relaxed);
+    version.store(v + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int i = 0; i < maxNumberOfChannels; ++i)
+        sharedSteps[i].store(pattern.channelSteps[i],
+                             std::memory_order_relaxed);
+    for (int i = 0; i <= maxNumberOfSteps; ++i)
+        sharedStepTimes[i].store(pattern.stepTimes[i],
+                                 std::memory_order_relaxed);
+    sharedStartSeconds.store(pattern.startSeconds, std::memory_order_relaxed);
+    sharedNumberOfSteps.store(pattern.numberOfSteps, std::memory_order_relaxed);
+    sharedLowestNoteNumber.store(pattern.lowestNoteNumber,
+                                 std::memory_order_relaxed);
+    sharedActive.store(pattern.active, std::memory_order_relaxed);
+
+    version.store(v + 2, std::memory_order_release);
+}
+
+const StepSequencerPlugin::Pattern &StepSequencerPlugin::getPattern() const {
+    return pattern;
+}
+
+tracktion::Plugin::Ptr StepSequencerPlugin::create(tracktion::Edit &edit) {
+    auto plugin = edit.getPluginCache().createNewPlugin(xmlTypeName, {});
+    if (dynamic_cast<StepSequencerPlugin *>(plugin.get()) != nullptr)
+        return plugin;
+
+    edit.engine.getPluginManager().createBuiltInType<StepSequencerPlugin>();
+    return edit.getPluginCache().createNewPlugin(xmlTypeName, {});
+}
+
+void StepSequencerPlugin::initialise(
+    const tracktion::PluginInitialisationInfo &info) {
+    sampleRate = info.sampleRate;
+    lastBlockEnd = info.startTime.inSeconds();
+    soundingNotes.reset();
+}
+
+void StepSequencerPlugin::deinitialise() {}
+
+void StepSequencerPlugin::applyToBuffer(
+    const tracktion::PluginRenderContext &fc) {
+    if (fc.bufferForMidiMessages == nullptr)
+        return;
+
+    readPattern();
+
+    auto blockStart = fc.editTime.getStart().inSeconds();
+    auto blockEnd = fc.editTime.getEnd().inSeconds();
+
+    // stopping, switching the pattern off or the playhead jumping cuts off
+    // whatever is still sounding
+    bool jumped = std::abs(blockStart - lastBlockEnd) > 1.0 / sampleRate;
+    lastBlockEnd = blockEnd;
+
+    bool shouldPlay = fc.isPlaying && playingPattern.active;
+    if (!shouldPlay || jumped)
+        addNoteOffs(fc, 0.0);
+
+    if (shouldPlay)
+        addNotesInRange(fc, blockStart, blockEnd);
+
+    fc.bufferForMidiMessages->sortByTimestamp();
+}
+
+void StepSequencerPlugin::readPattern() {
+    auto v = version.load(std::memory_order_acquire);
+    if (v == playingVersion || (v & 1) != 0)
+        return;
+
+    Pattern newPattern;
+    for (int i = 0; i < maxNumberOfChannels; ++i)
+        newPattern.channelSteps[i] =
+            sharedSteps[i].load(std::memory_order_relaxed);
+    for (int i = 0; i <= maxNumberOfSteps; ++i)
+        newPattern.stepTimes[i] =
+            sharedStepTimes[i].load(std::memory_order_relaxed);
+    newPattern.startSeconds =
+        sharedStartSeconds.load(std::memory_order_relaxed);
+    newPattern.numberOfSteps =
+        sharedNumberOfSteps.load(std::memory_order_relaxed);
+    newPattern.lowestNoteNumber =
+        sharedLowestNoteNumber.load(std::memory_order_relaxed);
+    newPattern.active = sharedActive.load(std::memory_order_relaxed);
+
+    // if the message thread wrote while this was reading the copy may be
+    // torn, keep playing the old pattern and try again next block
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (version.load(std::memory_order_relaxed) != v)
+        return;
+
+    playingPattern = newPattern;
+    playingVersion = v;
+}
+
+void StepSequencerPlugin::addNotesInRange(
+    const tracktion::PluginRenderContext &fc, double blockStart,
+    double blockEnd) {
+    auto &p = playingPattern;
+    int numberOfSteps = juce::jlimit(1, maxNumberOfSteps, p.numberOfSteps);
+    auto loopLength = p.stepTimes[numberOfSteps];
+    if (loopLength <= 0.0)
+        return;
+
+    // times from here on are relative to the start of the pattern
+    auto rangeStart = blockStart - p.startSeconds;
+    auto rangeEnd = blockEnd - p.startSeconds;
+    if (rangeEnd <= 0.0)
+        return;
+
+    // notes end a sample before the next step starts so a note off never
+    // shares a timestamp with the note on that follows it
+    auto noteEndOffset = 1.0 / sampleRate;
+    auto isInBlock = [&](double t) { return t >= rangeStart && t < rangeEnd; };
+
+    auto firstLoop = int(std::floor(juce::jmax(0.0, rangeStart) / loopLength));
+    auto lastLoop = int(std::floor(rangeEnd / loopLength));
+
+    for (int loop = firstLoop; loop <= lastLoop; ++loop) {
+        auto loopStart = loop * loopLength;
+
+        for (int step = 0; step < numberOfSteps; ++step) {
+            auto noteOn = loopStart + p.stepTimes[step];
+            if (isInBlock(noteOn)) {
+                auto offset = fc.midiBufferOffset + (noteOn - rangeStart);
+
+                for (int channel = 0; channel < maxNumberOfChannels;
+                     ++channel) {
+                    int note = p.lowestNoteNumber + channel;
+                    if ((p.channelSteps[channel] >> step & 1) == 0 ||
+                        !juce::isPositiveAndBelow(note, 128))
+                        continue;
+
+                    fc.bufferForMidiMessages->addMidiMessage(
+                        juce::MidiMessage::noteOn(1, note, juce::uint8(127)),
+                        offset, tracktion::MidiMessageArray::notMPE);
+                    soundingNotes.set(size_t(note));
+                }
+            }
+
+            auto noteOff = loopStart + p.stepTimes[step + 1] - noteEndOffset;
+            if (isInBlock(noteOff))
+                addNoteOffs(fc, noteOff - rangeStart);
+        }
+    }
+}
+
+void StepSequencerPlugin::addNoteOffs(const tracktion::PluginRenderContext &fc,
+                                      double offset) {
+    if (soundingNotes.none())
+        return;
+
+    for (int note = 0; note < 128; ++note)
+        if (soundingNotes[size_t(note)])
+            fc.bufferForMidiMessages->addMidiMessage(
+                juce::MidiMessage::noteOff(1, note),
+                fc.midiBufferOffset + offset,
+                tracktion::MidiMessageArray::notMPE);
+
+    soundingNotes.reset();
+}
+
+} // namespace internal_plugins
@@ -0,0 +1,104 @@
+#pragma once
+
+namespace internal_plugins {
+
+// Plays a step pattern as MIDI from the audio thread.
+//
+// The plugin sits at the start of a track and adds the pattern's notes to the
+// MIDI flowing into the instrument after it, timed to the sample from the
+// edit time of each block, so the pattern plays along with the rest of the
+// edit without being written to a clip first. Incoming MIDI is passed
+// through untouched.
+//
+// The pattern is published from the message thread as a Pattern snapshot.
+// The snapshot is held in atomics behind a sequence counter, the audio
+// thread picks up the newest complete one at the start of each block and
+// keeps playing the previous one if a write is in progress, so neither side
+// ever locks or waits for the other.
+//
+// Nothing about the pattern is stored in the plugin state, it is only played
+// while the sequencer that owns it is open.
+class StepSequencerPlugin : public tracktion::Plugin {
+  public:
+    explicit StepSequencerPlugin(tracktion::PluginCreationInfo info);
+    ~StepSequencerPlugin() override;
+
+    static constexpr int maxNumberOfChannels = 24;
+    static constexpr int maxNumberOfSteps = 16;
+
+    struct Pattern {
+        // one bit per step for each channel
+        std::array<juce::uint32, maxNumberOfChannels> channelSteps{};
+        // step start times in seconds from the start of the pattern, the
+        // entry after the last step is the length of the loop
+        std::array<double, maxNumberOfSteps + 1> stepTimes{};
+        double startSeconds = 0.0;
+        int numberOfSteps = maxNumberOfSteps;
+        // note number played by channel 0
+        int lowestNoteNumber = 0;
+        bool active = false;
+    };
+
+    // Message thread only
+    void setPattern(const Pattern &newPattern);
+    const Pattern &getPattern() const;
+
+    // Creates a step sequencer for the edit, registering the plugin type with
+    // the engine the first time it is needed
+    static tracktion::Plugin::Ptr create(tracktion::Edit &edit);
+
+    static const char *getPluginName() {
+        return NEEDS_TRANS("StepSequencer");
+    }
+
+    static const char *xmlTypeName;
+
+    juce::String getName() override { return TRANS("StepSequencer"); }
+
+    juce::String getPluginType() override { return xmlTypeName; }
+
+    juce::String getShortName(int) override { return "StpSeq"; }
+
+    juce::String getSelectableDescription() override {
+        return TRANS("StepSequencer");
+    }
+
+    bool takesMidiInput() override { return true; }
+    bool takesAudioInput() override { return true; }
+    bool isSynth() override { return false; }
+    bool producesAudioWhenNoAudioInput() override { return false; }
+    int getNumOutputChannelsGivenInputs(int numInputChannels) override {
+        return numInputChannels;
+    }
+
+    void initialise(const tracktion::PluginInitialisationInfo &info) override;
+    void deinitialise() override;
+    void applyToBuffer(const tracktion::PluginRenderContext &fc) override;
+
+  private:
+    // the last pattern published, message thread only
+    Pattern pattern;
+
+    // the published snapshot, the version is odd while a write is in progress
+    std::atomic<juce::uint32> version{0};
+    std::array<std::atomic<juce::uint32>, maxNumberOfChannels> sharedSteps{};
+    std::array<std::atomic<double>, maxNumberOfSteps + 1> sharedStepTimes{};
+    std::atomic<double> sharedStartSeconds{0.0};
+    std::atomic<int> sharedNumberOfSteps{maxNumberOfSteps};
+    std::atomic<int> sharedLowestNoteNumber{0};
+    std::atomic<bool> sharedActive{false};
+
+    // audio thread only
+    Pattern playingPattern;
+    juce::uint32 playingVersion = 0;
+    std::bitset<128> soundingNotes;
+    double sampleRate = 44100.0;
+    double lastBlockEnd = 0.0;
+
+    void readPattern();
+    void addNotesInRange(const tracktion::PluginRenderContext &fc,
+                         double blockStart, double blockEnd);
+    void addNoteOffs(const tracktion::PluginRenderContext &fc, double offset);
+};
+
+} // namespace internal_plugins
@@ -2,3 +2,4 @@
 #include "internal_plugins.h"
 
 #include "DrumSamplerPlugin/DrumSamplerPlugin.cpp"
+#include "StepSequencerPlugin/StepSequencerPlugin.cpp"
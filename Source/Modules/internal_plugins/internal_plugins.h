@@ -16,6 +16,7 @@
 namespace internal_plugins {
 
     class DrumSamplerPlugin;
+    class StepSequencerPlugin;
 
 }
 
@@ -24,9 +25,13 @@ namespace internal_plugins {
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <functional>
 
 #include "DrumSamplerPlugin/DrumSamplerPlugin.h"
+#include "StepSequencerPlugin/StepSequencerPlugin.h"
 
 
 
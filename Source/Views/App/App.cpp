@@ -2,19 +2,15 @@
 #include "TrackView.h"
 #include <app_configuration/app_configuration.h>
 
-App::App(tracktion::Edit &e, app_services::MidiCommandManager &mcm)
+App::App(tracktion::Edit &e, app_services::MidiCommandManager &mcm,
+         app_services::AudioCallbackMonitor &acm)
     : edit(e), midiCommandManager(mcm),
-      editTabBarView(edit, midiCommandManager) {
+      editTabBarView(edit, midiCommandManager, acm) {
     edit.setTimecodeFormat(tracktion::TimecodeType::millisecs);
 
-    auto userAppDataDirectory = juce::File::getSpecialLocation(
-        juce::File::userApplicationDataDirectory);
-    auto configFile =
-        userAppDataDirectory.getChildFile(JUCE_APPLICATION_NAME_STRING)
-            .getChildFile("config.yaml");
-    auto width = int(ConfigurationHelpers::getWidth(configFile));
-    auto height = int(ConfigurationHelpers::getHeight(configFile));
-    setSize(width, height);
+    juce::SharedResourcePointer<AppConfiguration> configuration;
+    setSize(configuration->get().window.width,
+            configuration->get().window.height);
 
     setLookAndFeel(&lookAndFeel);
 
@@ -0,0 +1,44 @@
+#include "DspLoadOverlayComponent.h"
+
+DspLoadOverlayComponent::DspLoadOverlayComponent(
+    app_services::AudioCallbackMonitor &monitor)
+    : viewModel(monitor) {
+    setInterceptsMouseClicks(false, false);
+    viewModel.addListener(this);
+}
+
+DspLoadOverlayComponent::~DspLoadOverlayComponent() {
+    viewModel.removeListener(this);
+}
+
+void DspLoadOverlayComponent::paint(juce::Graphics &g) {
+    g.setColour(appLookAndFeel.backgroundColour.withAlpha(.75f));
+    g.fillRect(getLocalBounds());
+
+    juce::String text =
+        "DSP " + juce::String(juce::roundToInt(viewModel.getLoad() * 100.0)) +
+        "% PEAK " +
+        juce::String(juce::roundToInt(viewModel.getPeakLoad() * 100.0)) +
+        "% XRUNS " + juce::String(viewModel.getXruns());
+
+    if (viewModel.getPluginLoad() >= 0.0)
+        text += " PLUGIN " +
+                juce::String(viewModel.getPluginLoad() * 100.0, 1) + "%";
+
+    // warn once the peak gets close to the point where the device drops out
+    if (viewModel.getXruns() > 0 || viewModel.getPeakLoad() > .8)
+        g.setColour(appLookAndFeel.redColour);
+    else
+        g.setColour(appLookAndFeel.textColour);
+
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(),
+                         getHeight() * .7, juce::Font::plain));
+    g.drawText(text, getLocalBounds().reduced(getHeight() / 4, 0),
+               juce::Justification::centredRight);
+}
+
+void DspLoadOverlayComponent::setPlugin(tracktion::Plugin *plugin) {
+    viewModel.setPlugin(plugin);
+}
+
+void DspLoadOverlayComponent::dspLoadChanged() { repaint(); }
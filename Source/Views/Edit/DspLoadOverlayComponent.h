@@ -0,0 +1,29 @@
+#pragma once
+#include "AppLookAndFeel.h"
+#include <app_services/app_services.h>
+#include <app_view_models/app_view_models.h>
+#include <juce_gui_extra/juce_gui_extra.h>
+
+// A small strip showing the audio callback load, its recent peak and the
+// xrun count, plus the selected plugin's share of the callback when one is
+// set. It does not take mouse clicks so it can sit on top of other views.
+class DspLoadOverlayComponent
+    : public juce::Component,
+      public app_view_models::DspLoadViewModel::Listener {
+  public:
+    explicit DspLoadOverlayComponent(
+        app_services::AudioCallbackMonitor &monitor);
+    ~DspLoadOverlayComponent() override;
+
+    void paint(juce::Graphics &g) override;
+
+    void setPlugin(tracktion::Plugin *plugin);
+
+    void dspLoadChanged() override;
+
+  private:
+    app_view_models::DspLoadViewModel viewModel;
+    AppLookAndFeel appLookAndFeel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadOverlayComponent)
+};
@@ -9,9 +9,10 @@
 #include "TrackPluginsListView.h"
 #include "TracksView.h"
 EditTabBarView::EditTabBarView(tracktion::Edit &e,
-                               app_services::MidiCommandManager &mcm)
+                               app_services::MidiCommandManager &mcm,
+                               app_services::AudioCallbackMonitor &acm)
     : TabbedComponent(juce::TabbedButtonBar::Orientation::TabsAtTop), edit(e),
-      midiCommandManager(mcm), viewModel(edit) {
+      midiCommandManager(mcm), audioCallbackMonitor(acm), viewModel(edit) {
     // Note: Some tabs are on a per-track basis and are added in
     // selectedIndexChanged, not here this is possible since this view is a
     // listener of the tracks item list state
@@ -20,7 +21,8 @@ EditTabBarView::EditTabBarView(tracktion::Edit &e,
     addTab(tempoSettingsTabName, juce::Colours::transparentBlack,
            new TempoSettingsView(edit, midiCommandManager), true);
     addTab(mixerTabName, juce::Colours::transparentBlack,
-           new MixerView(edit, midiCommandManager), true);
+           new MixerView(edit, midiCommandManager, audioCallbackMonitor),
+           true);
     addTab(settingsTabName, juce::Colours::transparentBlack,
            new app_navigation::StackNavigationController(new SettingsListView(
                edit, edit.engine.getDeviceManager().deviceManager,
@@ -119,8 +121,7 @@ void EditTabBarView::tempoSettingsButtonReleased() {
 void EditTabBarView::saveButtonReleased() {
     if (isShowing()) {
         juce::Logger::writeToLog("Saving edit ...");
-        tracktion::EditFileOperations fileOperations(edit);
-        fileOperations.save(true, true, false);
+        app_services::EditCache::saveEdit(edit);
         juce::Logger::writeToLog("Save complete!");
 
         messageBox.setMessage("Save Complete!");
@@ -373,7 +374,8 @@ void EditTabBarView::resetTrackRelatedTabs() {
 
             addTab(pluginsTabName, juce::Colours::transparentBlack,
                    new app_navigation::StackNavigationController(
-                       new TrackPluginsListView(track, midiCommandManager)),
+                       new TrackPluginsListView(track, midiCommandManager,
+                                                audioCallbackMonitor)),
                    true);
             addTab(modifiersTabName, juce::Colours::transparentBlack,
                    new app_navigation::StackNavigationController(
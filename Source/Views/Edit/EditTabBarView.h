@@ -13,7 +13,8 @@ class EditTabBarView : public juce::TabbedComponent,
                        public app_view_models::EditViewModel::Listener,
                        juce::Timer {
   public:
-    EditTabBarView(tracktion::Edit &e, app_services::MidiCommandManager &mcm);
+    EditTabBarView(tracktion::Edit &e, app_services::MidiCommandManager &mcm,
+                   app_services::AudioCallbackMonitor &acm);
     ~EditTabBarView() override;
     void paint(juce::Graphics &) override;
     void resized() override;
@@ -45,6 +46,7 @@ class EditTabBarView : public juce::TabbedComponent,
   private:
     tracktion::Edit &edit;
     app_services::MidiCommandManager &midiCommandManager;
+    app_services::AudioCallbackMonitor &audioCallbackMonitor;
     app_view_models::EditViewModel viewModel;
     juce::String tracksTabName = "TRACKS";
     juce::String tempoSettingsTabName = "TEMPO_SETTINGS";
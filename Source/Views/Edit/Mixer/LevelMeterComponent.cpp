@@ -1,18 +1,53 @@
 #include "LevelMeterComponent.h"
 
-LevelMeterComponent::LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan)
-    : channel(chan), levelMeasurer(lm) {
-    prevLeveldB = currentLeveldB;
-    currentLeveldB = levelClient.getAndClearAudioLevel(channel).dB;
+LevelMeterComponent::LevelMeterComponent(int chan) : channel(chan) {
     setOpaque(true);
-    levelMeasurer.addClient(levelClient);
-    startTimerHz(120);
 }
 
-LevelMeterComponent::~LevelMeterComponent() {
-    levelMeasurer.removeClient(levelClient);
-    stopTimer();
+LevelMeterComponent::LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan)
+    : LevelMeterComponent(chan) {
+    setMeasurer(&lm);
+}
+
+LevelMeterComponent::~LevelMeterComponent() { setMeasurer(nullptr); }
+
+void LevelMeterComponent::setMeasurer(tracktion::LevelMeasurer *newMeasurer) {
+    if (newMeasurer == levelMeasurer)
+        return;
+
+    if (isClientRegistered) {
+        levelMeasurer->removeClient(levelClient);
+        isClientRegistered = false;
+    }
+
+    levelMeasurer = newMeasurer;
+    levelClient.reset();
+    currentLeveldB = prevLeveldB = RANGEMINdB;
+    updateRegistration();
+    repaint();
+}
+
+void LevelMeterComponent::visibilityChanged() { updateRegistration(); }
+
+void LevelMeterComponent::parentHierarchyChanged() { updateRegistration(); }
+
+void LevelMeterComponent::updateRegistration() {
+    bool shouldBeRegistered = levelMeasurer != nullptr && isShowing();
+    if (shouldBeRegistered == isClientRegistered)
+        return;
+
+    if (shouldBeRegistered) {
+        levelClient.reset();
+        levelMeasurer->addClient(levelClient);
+        startTimerHz(120);
+    } else {
+        levelMeasurer->removeClient(levelClient);
+        stopTimer();
+    }
+
+    isClientRegistered = shouldBeRegistered;
 }
+
 void LevelMeterComponent::paint(juce::Graphics &g) {
     g.fillAll(
         juce::Colour(appLookAndFeel.blackColour)); // fill the background black
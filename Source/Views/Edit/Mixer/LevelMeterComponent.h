@@ -3,12 +3,23 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
 
+// Meters one channel of a LevelMeasurer.
+//
+// The meter only registers its client with the measurer and runs its timer
+// while it has a measurer and is showing, so meters in strips that have been
+// scrolled away or recycled cost nothing on either thread.
 class LevelMeterComponent : public juce::Component, public juce::Timer {
   public:
-    explicit LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan);
+    explicit LevelMeterComponent(int chan);
+    LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan);
     ~LevelMeterComponent() override;
 
+    // Pass nullptr to detach the meter
+    void setMeasurer(tracktion::LevelMeasurer *newMeasurer);
+
     void paint(juce::Graphics &g) override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
 
     void timerCallback() override;
 
@@ -22,10 +33,13 @@ class LevelMeterComponent : public juce::Component, public juce::Timer {
     double currentLeveldB{0.0};
     double prevLeveldB{0.0};
 
-    tracktion::LevelMeasurer &levelMeasurer;
+    tracktion::LevelMeasurer *levelMeasurer = nullptr;
     tracktion::LevelMeasurer::Client levelClient;
+    bool isClientRegistered = false;
 
     AppLookAndFeel appLookAndFeel;
 
+    void updateRegistration();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeterComponent)
 };
@@ -27,22 +27,29 @@ juce::Component *MixerTableListBoxModel::refreshComponentForCell(
     // column id begins at 1!
     int itemIndex = (rowNumber * numCols) + (columnId - 1);
 
-    delete existingComponentToUpdate;
+    auto existingView =
+        dynamic_cast<MixerTrackView *>(existingComponentToUpdate);
 
-    if (juce::isPositiveAndBelow(rowNumber,
-                                 listViewModel.getAdapter()->size())) {
-        MixerTrackView *mixerTrackView = nullptr;
+    tracktion::Track *track = nullptr;
+    if (juce::isPositiveAndBelow(itemIndex, listViewModel.getAdapter()->size()))
+        track = dynamic_cast<tracktion::Track *>(
+            listViewModel.getAdapter()->getItemAtIndex(itemIndex));
 
-        if (auto track = dynamic_cast<tracktion::Track *>(
-                listViewModel.getAdapter()->getItemAtIndex(itemIndex))) {
-            mixerTrackView = new MixerTrackView(*track);
-            mixerTrackView->setSelected(
-                itemIndex ==
-                listViewModel.itemListState.getSelectedItemIndex());
-        }
+    if (track == nullptr) {
+        delete existingComponentToUpdate;
+        return nullptr;
+    }
 
-        return mixerTrackView;
+    // strips are recycled as rows scroll, only the track they show changes
+    if (existingView == nullptr) {
+        delete existingComponentToUpdate;
+        existingView = new MixerTrackView(track);
+    } else {
+        existingView->setTrack(track);
     }
 
-    return nullptr;
+    existingView->setSelected(
+        itemIndex == listViewModel.itemListState.getSelectedItemIndex());
+    existingView->repaint();
+    return existingView;
 }
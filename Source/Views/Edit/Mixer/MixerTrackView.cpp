@@ -1,42 +1,8 @@
 #include "MixerTrackView.h"
-MixerTrackView::MixerTrackView(tracktion::Track::Ptr t)
-    : track(t), viewModel(track),
-      levelMeter0(
-          (track->isMasterTrack())
-              ? std::make_unique<LevelMeterComponent>(
-                    t->edit.getCurrentPlaybackContext()->masterLevels, 0)
-              : std::make_unique<LevelMeterComponent>(
-                    track->pluginList
-                        .getPluginsOfType<tracktion::LevelMeterPlugin>()
-                        .getLast()
-                        ->measurer,
-                    0)),
-      levelMeter1(
-          (track->isMasterTrack())
-              ? std::make_unique<LevelMeterComponent>(
-                    t->edit.getCurrentPlaybackContext()->masterLevels, 1)
-              : std::make_unique<LevelMeterComponent>(
-                    track->pluginList
-                        .getPluginsOfType<tracktion::LevelMeterPlugin>()
-                        .getLast()
-                        ->measurer,
-                    1)) {
-    addAndMakeVisible(levelMeter0.get());
-    addAndMakeVisible(levelMeter1.get());
-    if (track->getName().contains("Track")) {
-        panKnob.getLabel().setText(
-            track->getName().trimCharactersAtStart("Track "),
-            juce::dontSendNotification);
-    }
-
-    if (track->isMasterTrack()) {
-        panKnob.getLabel().setText("M", juce::dontSendNotification);
-    }
+MixerTrackView::MixerTrackView(tracktion::Track::Ptr t) {
+    addAndMakeVisible(levelMeter0);
+    addAndMakeVisible(levelMeter1);
 
-    panKnob.getSlider().setRange(
-        viewModel.getVolumeAndPanPlugin()->panParam->getValueRange().getStart(),
-        viewModel.getVolumeAndPanPlugin()->panParam->getValueRange().getEnd(),
-        0);
     panKnob.getSlider().setColour(juce::Slider::rotarySliderFillColourId,
                                   appLookAndFeel.colour3);
     panKnob.getSlider().setColour(juce::Slider::thumbColourId,
@@ -63,8 +29,8 @@ MixerTrackView::MixerTrackView(tracktion::Track::Ptr t)
     grid.templateColumns = {Track(Fr(2)), Track(Fr(2)), Track(Fr(10)),
                             Track(Fr(1))};
 
-    grid.items.add(levelMeter0.get());
-    grid.items.add(levelMeter1.get());
+    grid.items.add(levelMeter0);
+    grid.items.add(levelMeter1);
     grid.items.add(panKnob);
     grid.items.add(volumeSlider);
 
@@ -84,10 +50,10 @@ MixerTrackView::MixerTrackView(tracktion::Track::Ptr t)
     muteLabel.setAlwaysOnTop(true);
     addAndMakeVisible(muteLabel);
 
-    viewModel.addListener(this);
+    setTrack(t);
 }
 
-MixerTrackView::~MixerTrackView() { viewModel.removeListener(this); }
+MixerTrackView::~MixerTrackView() { detach(); }
 
 void MixerTrackView::paint(juce::Graphics &g) {
     if (isSelected) {
@@ -111,6 +77,78 @@ void MixerTrackView::resized() {
     muteLabel.setBounds(muteX, iconY, iconWidth, iconHeight);
 }
 
+void MixerTrackView::visibilityChanged() { updateAttachment(); }
+
+void MixerTrackView::parentHierarchyChanged() { updateAttachment(); }
+
+void MixerTrackView::setTrack(tracktion::Track::Ptr t) {
+    if (t == track)
+        return;
+
+    detach();
+    track = t;
+    updateAttachment();
+}
+
+tracktion::Track *MixerTrackView::getTrack() const { return track.get(); }
+
+void MixerTrackView::updateAttachment() {
+    // a strip that is not on screen does not need to follow its track
+    bool shouldBeAttached = track != nullptr && isShowing();
+    if (shouldBeAttached && viewModel == nullptr)
+        attach();
+    else if (!shouldBeAttached && viewModel != nullptr)
+        detach();
+}
+
+void MixerTrackView::attach() {
+    viewModel = std::make_unique<app_view_models::MixerTrackViewModel>(track);
+
+    juce::String label;
+    if (track->isMasterTrack())
+        label = "M";
+    else if (track->getName().contains("Track"))
+        label = track->getName().trimCharactersAtStart("Track ");
+    panKnob.getLabel().setText(label, juce::dontSendNotification);
+
+    auto panRange =
+        viewModel->getVolumeAndPanPlugin()->panParam->getValueRange();
+    panKnob.getSlider().setRange(panRange.getStart(), panRange.getEnd(), 0);
+
+    auto levelMeasurer = getLevelMeasurer();
+    levelMeter0.setMeasurer(levelMeasurer);
+    levelMeter1.setMeasurer(levelMeasurer);
+
+    // adding the listener brings the controls up to date
+    viewModel->addListener(this);
+}
+
+void MixerTrackView::detach() {
+    if (viewModel != nullptr) {
+        viewModel->removeListener(this);
+        viewModel = nullptr;
+    }
+
+    levelMeter0.setMeasurer(nullptr);
+    levelMeter1.setMeasurer(nullptr);
+}
+
+tracktion::LevelMeasurer *MixerTrackView::getLevelMeasurer() {
+    if (track->isMasterTrack()) {
+        if (auto context = track->edit.getCurrentPlaybackContext())
+            return &context->masterLevels;
+
+        return nullptr;
+    }
+
+    if (auto levelMeterPlugin =
+            track->pluginList.getPluginsOfType<tracktion::LevelMeterPlugin>()
+                .getLast())
+        return &levelMeterPlugin->measurer;
+
+    return nullptr;
+}
+
 void MixerTrackView::setSelected(bool selected) {
     isSelected = selected;
     if (isSelected)
@@ -9,14 +9,25 @@
 #include <juce_gui_extra/juce_gui_extra.h>
 #include <tracktion_engine/tracktion_engine.h>
 
+// A channel strip in the mixer.
+//
+// Strips are recycled as the mixer scrolls, so the track can be changed after
+// construction. The strip only holds a view model and meter clients while it
+// has a track and is showing.
 class MixerTrackView : public juce::Component,
                        public app_view_models::MixerTrackViewModel::Listener {
   public:
-    MixerTrackView(tracktion::Track::Ptr t);
-    ~MixerTrackView();
+    explicit MixerTrackView(tracktion::Track::Ptr t);
+    ~MixerTrackView() override;
 
     void paint(juce::Graphics &g) override;
     void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+
+    // Pass nullptr to detach the strip
+    void setTrack(tracktion::Track::Ptr t);
+    tracktion::Track *getTrack() const;
 
     void setSelected(bool selected);
 
@@ -27,13 +38,13 @@ class MixerTrackView : public juce::Component,
 
   private:
     tracktion::Track::Ptr track;
-    app_view_models::MixerTrackViewModel viewModel;
+    std::unique_ptr<app_view_models::MixerTrackViewModel> viewModel;
     bool isSelected = false;
     LabeledKnob panKnob;
     juce::Slider volumeSlider;
     juce::Grid grid;
-    std::unique_ptr<LevelMeterComponent> levelMeter0;
-    std::unique_ptr<LevelMeterComponent> levelMeter1;
+    LevelMeterComponent levelMeter0{0};
+    LevelMeterComponent levelMeter1{1};
 
     juce::Typeface::Ptr faTypeface = juce::Typeface::createSystemTypefaceFor(
         FontData::FontAwesome6FreeSolid900_otf,
@@ -46,5 +57,10 @@ class MixerTrackView : public juce::Component,
 
     SelectedTrackMarker selectionShroud;
 
+    void updateAttachment();
+    void attach();
+    void detach();
+    tracktion::LevelMeasurer *getLevelMeasurer();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixerTrackView)
 };
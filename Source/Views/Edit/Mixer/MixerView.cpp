@@ -1,9 +1,11 @@
 #include "MixerView.h"
 
-MixerView::MixerView(tracktion::Edit &e, app_services::MidiCommandManager &mcm)
+MixerView::MixerView(tracktion::Edit &e, app_services::MidiCommandManager &mcm,
+                     app_services::AudioCallbackMonitor &acm)
     : edit(e), viewModel(edit), midiCommandManager(mcm),
       tableListModel(
-          std::make_unique<MixerTableListBoxModel>(viewModel.listViewModel)) {
+          std::make_unique<MixerTableListBoxModel>(viewModel.listViewModel)),
+      dspLoadOverlay(acm) {
     tableListBox.setModel(tableListModel.get());
     tableListBox.setHeaderHeight(0);
     tableListBox.getHeader().setStretchToFitActive(true);
@@ -18,6 +20,10 @@ MixerView::MixerView(tracktion::Edit &e, app_services::MidiCommandManager &mcm)
     tableListBox.setAlwaysOnTop(true);
     addAndMakeVisible(tableListBox);
 
+    // the table is always on top so the overlay has to be as well
+    dspLoadOverlay.setAlwaysOnTop(true);
+    addAndMakeVisible(dspLoadOverlay);
+
     viewModel.listViewModel.addListener(this);
     viewModel.listViewModel.itemListState.addListener(this);
 }
@@ -31,6 +37,8 @@ void MixerView::paint(juce::Graphics &g) {}
 
 void MixerView::resized() {
     tableListBox.setBounds(getLocalBounds());
+    dspLoadOverlay.setBounds(getLocalBounds().removeFromBottom(
+        juce::roundToInt(getHeight() * .06)));
     tableListBox.setRowHeight(getHeight() / 3);
     tableListBox.getHeader().resizeAllColumnsToFit(getWidth());
     tableListBox.scrollToEnsureRowIsOnscreen(
@@ -1,5 +1,6 @@
 #pragma once
 #include "AppLookAndFeel.h"
+#include "DspLoadOverlayComponent.h"
 #include "MixerTableListBoxModel.h"
 #include <app_services/app_services.h>
 #include <app_view_models/app_view_models.h>
@@ -10,7 +11,8 @@ class MixerView : public juce::Component,
                   public app_view_models::EditItemListViewModel::Listener,
                   public app_view_models::ItemListState::Listener {
   public:
-    MixerView(tracktion::Edit &e, app_services::MidiCommandManager &mcm);
+    MixerView(tracktion::Edit &e, app_services::MidiCommandManager &mcm,
+              app_services::AudioCallbackMonitor &acm);
     ~MixerView();
     void paint(juce::Graphics &g) override;
     void resized() override;
@@ -40,6 +42,7 @@ class MixerView : public juce::Component,
     app_view_models::MixerViewModel viewModel;
     std::unique_ptr<MixerTableListBoxModel> tableListModel;
     juce::TableListBox tableListBox;
+    DspLoadOverlayComponent dspLoadOverlay;
 
     AppLookAndFeel appLookAndFeel;
 
@@ -185,6 +185,14 @@ void OscillatorView::parametersChanged() {
                                                  juce::dontSendNotification);
     pluginKnobs.getKnob(1)->getSlider().setValue(viewModel.getVoices(),
                                                  juce::dontSendNotification);
+    // show when the voice governor is playing fewer voices than were set
+    if (viewModel.isVoiceLimited())
+        pluginKnobs.getKnob(1)->getLabel().setText(
+            "Voices (max " + juce::String(viewModel.getVoiceLimit()) + ")",
+            juce::dontSendNotification);
+    else
+        pluginKnobs.getKnob(1)->getLabel().setText("Voices",
+                                                   juce::dontSendNotification);
     pluginKnobs.getKnob(2)->getSlider().setValue(viewModel.getTune(),
                                                  juce::dontSendNotification);
     pluginKnobs.getKnob(3)->getSlider().setValue(viewModel.getFineTune(),
@@ -232,6 +232,12 @@ void SamplerView::sampleChanged() {
     resized();
 }
 
+void SamplerView::itemNamesChanged() {
+    titledList.setListItems(viewModel->getItemNames());
+    titledList.getListView().getListBox().selectRow(
+        viewModel->itemListState.getSelectedItemIndex());
+}
+
 void SamplerView::sampleExcerptTimesChanged() {
     updateSampleLengthLabel();
     repaint();
@@ -284,6 +290,7 @@ void SamplerView::encoder1ButtonReleased() {
                         titledList.setListItems(viewModel->getItemNames());
                         titledList.setTitleString(viewModel->getTitle());
                     } else {
+                        viewModel->confirmSelection();
                         titledList.setVisible(false);
                     }
                 } else {
@@ -31,6 +31,7 @@ class SamplerView
     void resized() override;
 
     void sampleChanged() override;
+    void itemNamesChanged() override;
     void sampleExcerptTimesChanged() override;
     void fullSampleThumbnailChanged() override;
     void sampleExcerptThumbnailChanged() override;
@@ -5,11 +5,13 @@
 #include "PluginView.h"
 #include <app_navigation/app_navigation.h>
 TrackPluginsListView::TrackPluginsListView(
-    tracktion::AudioTrack::Ptr t, app_services::MidiCommandManager &mcm)
+    tracktion::AudioTrack::Ptr t, app_services::MidiCommandManager &mcm,
+    app_services::AudioCallbackMonitor &acm)
     : track(t), midiCommandManager(mcm), viewModel(t),
       titledList(viewModel.listViewModel.getItemNames(), "Plugins",
                  ListTitle::IconType::FONT_AWESOME,
-                 juce::String::charToString(0xf1e6)) {
+                 juce::String::charToString(0xf1e6)),
+      dspLoadOverlay(acm) {
     viewModel.listViewModel.addListener(this);
     viewModel.listViewModel.itemListState.addListener(this);
     midiCommandManager.addListener(this);
@@ -25,6 +27,10 @@ TrackPluginsListView::TrackPluginsListView(
     addChildComponent(emptyListLabel);
 
     addAndMakeVisible(titledList);
+
+    dspLoadOverlay.setAlwaysOnTop(true);
+    addAndMakeVisible(dspLoadOverlay);
+    updateDspLoadOverlayPlugin();
 }
 
 TrackPluginsListView::~TrackPluginsListView() {
@@ -46,6 +52,8 @@ void TrackPluginsListView::resized() {
     emptyListLabel.setBounds(getLocalBounds());
 
     titledList.setBounds(getLocalBounds());
+    dspLoadOverlay.setBounds(getLocalBounds().removeFromBottom(
+        juce::roundToInt(getHeight() * .06)));
 
     titledList.getListView().getListBox().scrollToEnsureRowIsOnscreen(
         viewModel.listViewModel.itemListState.getSelectedItemIndex());
@@ -70,6 +78,11 @@ void TrackPluginsListView::encoder1Decreased() {
 void TrackPluginsListView::encoder1ButtonReleased() {
     if (isShowing()) {
         if (midiCommandManager.getFocusedComponent() == this) {
+            // a frozen track's plugins are unloaded so there is nothing to
+            // show until the track is unfrozen
+            if (viewModel.isTrackFrozen())
+                return;
+
             if (auto stackNavigationController = findParentComponentOfClass<
                     app_navigation::StackNavigationController>()) {
                 if (auto plugin = dynamic_cast<tracktion::Plugin *>(
@@ -128,6 +141,7 @@ void TrackPluginsListView::minusButtonReleased() {
 
 void TrackPluginsListView::selectedIndexChanged(int newIndex) {
     titledList.getListView().getListBox().selectRow(newIndex);
+    updateDspLoadOverlayPlugin();
     sendLookAndFeelChange();
 }
 
@@ -138,6 +152,7 @@ void TrackPluginsListView::itemsChanged() {
         emptyListLabel.setVisible(false);
 
     titledList.setListItems(viewModel.listViewModel.getItemNames());
+    updateDspLoadOverlayPlugin();
     titledList.getListView().getListBox().scrollToEnsureRowIsOnscreen(
         titledList.getListView().getListBox().getSelectedRow());
     sendLookAndFeelChange();
@@ -156,3 +171,9 @@ void TrackPluginsListView::encoder3Decreased() {
 void TrackPluginsListView::encoder4ButtonReleased() {
     viewModel.toggleSelectedPluginEnabled();
 }
+
+void TrackPluginsListView::updateDspLoadOverlayPlugin() {
+    // the overlay reports the cost of the selected plugin
+    dspLoadOverlay.setPlugin(dynamic_cast<tracktion::Plugin *>(
+        viewModel.listViewModel.getSelectedItem()));
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "DspLoadOverlayComponent.h"
 #include "LabelColour1LookAndFeel.h"
 #include "TitledListView.h"
 #include <app_services/app_services.h>
@@ -13,7 +14,8 @@ class TrackPluginsListView
       public app_services::MidiCommandManager::Listener {
   public:
     TrackPluginsListView(tracktion::AudioTrack::Ptr t,
-                         app_services::MidiCommandManager &mcm);
+                         app_services::MidiCommandManager &mcm,
+                         app_services::AudioCallbackMonitor &acm);
     ~TrackPluginsListView() override;
     void paint(juce::Graphics &) override;
     void resized() override;
@@ -39,7 +41,10 @@ class TrackPluginsListView
     app_view_models::TrackPluginsListViewModel viewModel;
     TitledListView titledList;
     juce::Label emptyListLabel;
+    DspLoadOverlayComponent dspLoadOverlay;
     LabelColour1LookAndFeel labelColour1LookAndFeel;
 
+    void updateDspLoadOverlayPlugin();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackPluginsListView)
 };
@@ -41,6 +41,14 @@ InformationPanelComponent::InformationPanelComponent() {
     muteLabel.setColour(juce::Label::textColourId, appLookAndFeel.colour4);
     muteLabel.setAlwaysOnTop(true);
     addAndMakeVisible(muteLabel);
+
+    frozenLabel.setFont(fontAwesomeFont);
+    frozenLabel.setText(juce::String::charToString(0xf2dc),
+                        juce::dontSendNotification);
+    frozenLabel.setJustificationType(juce::Justification::centred);
+    frozenLabel.setColour(juce::Label::textColourId, appLookAndFeel.colour1);
+    frozenLabel.setAlwaysOnTop(true);
+    addChildComponent(frozenLabel);
 }
 
 InformationPanelComponent::~InformationPanelComponent() {
@@ -57,6 +65,7 @@ void InformationPanelComponent::resized() {
     loopingLabel.setFont(fontAwesomeFont);
     soloLabel.setFont(fontAwesomeFont);
     muteLabel.setFont(fontAwesomeFont);
+    frozenLabel.setFont(fontAwesomeFont);
     float iconHeight = float(height);
 
     trackNumberLabel.setFont(
@@ -87,6 +96,9 @@ void InformationPanelComponent::resized() {
 
     int muteLabelX = soloLabelX + 60;
     muteLabel.setBounds(muteLabelX, 0, getHeight(), getHeight());
+
+    int frozenLabelX = muteLabelX + 60;
+    frozenLabel.setBounds(frozenLabelX, 0, getHeight(), getHeight());
 }
 
 void InformationPanelComponent::setIsPlaying(bool isPlaying) { resized(); }
@@ -127,4 +139,9 @@ void InformationPanelComponent::setIsSoloed(bool solo) {
 void InformationPanelComponent::setIsMuted(bool muted) {
     muteLabel.setVisible(muted);
     resized();
+}
+
+void InformationPanelComponent::setIsFrozen(bool frozen) {
+    frozenLabel.setVisible(frozen);
+    resized();
 }
\ No newline at end of file
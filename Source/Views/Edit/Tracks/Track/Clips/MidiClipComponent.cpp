@@ -2,7 +2,8 @@
 
 MidiClipComponent::MidiClipComponent(tracktion::Clip::Ptr c,
                                      app_services::TimelineCamera &camera)
-    : ClipComponent(c, camera) {}
+    : ClipComponent(c, camera),
+      tempoMap(app_services::TempoMap::getFor(c->edit)) {}
 
 tracktion::MidiClip *MidiClipComponent::getMidiClip() {
     return dynamic_cast<tracktion::MidiClip *>(clip.get());
@@ -23,11 +24,9 @@ void MidiClipComponent::paint(juce::Graphics &g) {
                                n->getEndBeat().inBeats() -
                                mc->getOffsetInBeats().inBeats();
 
-                auto &tempoSequence = clip->edit.tempoSequence;
-
-                auto startTime = tempoSequence.toTime(
+                auto startTime = tempoMap->toTime(
                     tracktion::BeatPosition::fromBeats(startBeat));
-                auto endTime = tempoSequence.toTime(
+                auto endTime = tempoMap->toTime(
                     tracktion::BeatPosition::fromBeats(endBeat));
 
                 if (auto p = getParentComponent()) {
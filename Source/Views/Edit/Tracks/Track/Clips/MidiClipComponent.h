@@ -9,4 +9,7 @@ class MidiClipComponent : public ClipComponent {
     tracktion::MidiClip *getMidiClip();
 
     void paint(juce::Graphics &g) override;
+
+  private:
+    std::shared_ptr<app_services::TempoMap> tempoMap;
 };
@@ -5,7 +5,8 @@
 
 TracksView::TracksView(tracktion::Edit &e,
                        app_services::MidiCommandManager &mcm)
-    : edit(e), midiCommandManager(mcm), camera(7), viewModel(e, camera),
+    : edit(e), midiCommandManager(mcm), camera(7),
+      tempoMap(app_services::TempoMap::getFor(e)), viewModel(e, camera),
       listModel(std::make_unique<TracksListBoxModel>(viewModel.listViewModel,
                                                      camera)),
       singleTrackView(std::make_unique<TrackView>(
@@ -126,6 +127,12 @@ void TracksView::encoder2Decreased() {
     }
 }
 
+void TracksView::encoder2ButtonReleased() {
+    if (isShowing())
+        if (midiCommandManager.getFocusedComponent() == this)
+            viewModel.toggleFreeze();
+}
+
 void TracksView::encoder3Increased() {
     if (isShowing()) {
         if (midiCommandManager.getFocusedComponent() == this) {
@@ -289,6 +296,7 @@ void TracksView::selectedIndexChanged(int newIndex) {
                 .trimCharactersAtStart("Track "));
         informationPanel.setIsSoloed(viewModel.getSelectedTrackSoloState());
         informationPanel.setIsMuted(viewModel.getSelectedTrackMuteState());
+        informationPanel.setIsFrozen(viewModel.getSelectedTrackFreezeState());
     }
 
     sendLookAndFeelChange();
@@ -373,33 +381,32 @@ void TracksView::soloStateChanged(bool solo) {
 void TracksView::muteStateChanged(bool mute) {
     informationPanel.setIsMuted(mute);
 }
+void TracksView::freezeStateChanged(bool frozen) {
+    informationPanel.setIsFrozen(frozen);
+}
 
 void TracksView::buildBeats() {
     juce::Colour beatColour = appLookAndFeel.colour3.darker(.5f);
     beats.clear();
 
     double pxPerSec = getWidth() / camera.getScope();
-    double secondsPerBeat =
-        (1.0 / edit.tempoSequence.getBeatsPerSecondAt(
-                   tracktion::TimePosition::fromSeconds(0.0)));
-    // give a few extra beats per screen
-    int beatsPerScreen =
-        static_cast<int>((camera.getScope() / secondsPerBeat) + 2);
-    double pxPerBeat = secondsPerBeat * pxPerSec;
-    auto leftEdgeBeat = edit.tempoSequence
-                            .toBeats(tracktion::TimePosition::fromSeconds(
-                                camera.getCenter() - (camera.getScope() / 2.0)))
-                            .inBeats();
-    double beatOffset = ceil(leftEdgeBeat) - leftEdgeBeat;
-    double timeOffset = secondsPerBeat * beatOffset;
-
-    double pxOffset = timeOffset * pxPerSec;
+    double leftEdge = camera.getCenter() - (camera.getScope() / 2.0);
+    double rightEdge = leftEdge + camera.getScope();
 
+    // beats are placed through the tempo map so they follow tempo changes
+    auto leftEdgeBeat =
+        tempoMap->toBeats(tracktion::TimePosition::fromSeconds(leftEdge))
+            .inBeats();
     int leftEdgeBeatNumber = static_cast<int>(ceil(leftEdgeBeat));
 
-    for (int i = 0; i < beatsPerScreen; i++) {
-        double beatX = (i * pxPerBeat) + pxOffset;
-        int beatNumber = leftEdgeBeatNumber + i;
+    for (int beatNumber = leftEdgeBeatNumber;; beatNumber++) {
+        double beatTime =
+            tempoMap->toTime(tracktion::BeatPosition::fromBeats(beatNumber))
+                .inSeconds();
+        if (beatTime > rightEdge)
+            break;
+
+        double beatX = (beatTime - leftEdge) * pxPerSec;
 
         beats.add(new juce::DrawableRectangle());
         beats.getLast()->setFill(juce::FillType(beatColour));
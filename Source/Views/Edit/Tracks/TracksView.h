@@ -29,6 +29,7 @@ class TracksView : public juce::Component,
 
     void encoder2Increased() override;
     void encoder2Decreased() override;
+    void encoder2ButtonReleased() override;
 
     void encoder3Increased() override;
     void encoder3Decreased() override;
@@ -70,6 +71,7 @@ class TracksView : public juce::Component,
     void loopingChanged(bool looping) override;
     void soloStateChanged(bool solo) override;
     void muteStateChanged(bool mute) override;
+    void freezeStateChanged(bool frozen) override;
 
     app_view_models::TracksListViewModel &getViewModel() { return viewModel; };
 
@@ -77,6 +79,7 @@ class TracksView : public juce::Component,
     tracktion::Edit &edit;
     app_services::MidiCommandManager &midiCommandManager;
     app_services::TimelineCamera camera;
+    std::shared_ptr<app_services::TempoMap> tempoMap;
     app_view_models::TracksListViewModel viewModel;
 
     InformationPanelComponent informationPanel;
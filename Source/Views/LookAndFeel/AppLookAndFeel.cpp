@@ -1,10 +1,34 @@
 #include "AppLookAndFeel.h"
 #include "SimpleListItemView.h"
-#include <yaml-cpp/yaml.h>
 
 AppLookAndFeel::AppLookAndFeel() {
     readColoursFromConfig();
+    applyColours();
+    configuration->addListener(this);
+}
+
+AppLookAndFeel::~AppLookAndFeel() { configuration->removeListener(this); }
+
+void AppLookAndFeel::readColoursFromConfig() {
+    // Overwrite the default colours with the ones from the config, which
+    // falls back to the same defaults for any it doesn't set
+    auto &configColours = configuration->get().colours;
+    backgroundColour = configColours.backgroundColour;
+    textColour = configColours.textColour;
+    colour1 = configColours.colours[0];
+    colour2 = configColours.colours[1];
+    colour3 = configColours.colours[2];
+    colour4 = configColours.colours[3];
+    colour5 = configColours.colours[4];
+    colour6 = configColours.colours[5];
+    colour7 = configColours.colours[6];
+    colour8 = configColours.colours[7];
+
+    colours = juce::Array<juce::Colour>(
+        {colour1, colour2, colour4, colour5, colour6, colour7, colour8});
+}
 
+void AppLookAndFeel::applyColours() {
     setColour(juce::DocumentWindow::backgroundColourId, backgroundColour);
 
     setColour(juce::TabbedComponent::backgroundColourId, backgroundColour);
@@ -23,74 +47,34 @@ AppLookAndFeel::AppLookAndFeel() {
     setColour(juce::ScrollBar::trackColourId, colour2);
 }
 
-void AppLookAndFeel::readColoursFromConfig() {
-    // Read the config file and overwrite the default colours (if
-    // appropriate config is found)
-    auto userAppDataDirectory = juce::File::getSpecialLocation(
-        juce::File::userApplicationDataDirectory);
-    auto configFile =
-        userAppDataDirectory.getChildFile(JUCE_APPLICATION_NAME_STRING)
-            .getChildFile("config.yaml");
-    if (configFile.existsAsFile()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-
-        if (rootNode) {
-            auto configNode = rootNode["config"];
-            if (configNode) {
-                auto coloursNode = configNode["colours"];
-                if (coloursNode) {
-                    if (coloursNode["backgroundColour"]) {
-                        backgroundColour = juce::Colour::fromString(
-                            coloursNode["backgroundColour"].as<std::string>());
-                    }
-
-                    if (coloursNode["textColour"]) {
-                        textColour = juce::Colour::fromString(
-                            coloursNode["textColour"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour1"]) {
-                        colour1 = juce::Colour::fromString(
-                            coloursNode["colour1"].as<std::string>());
-                    }
+void AppLookAndFeel::configurationChanged(
+    const AppConfiguration::Values &previous) {
+    auto &configColours = configuration->get().colours;
+    if (configColours.backgroundColour == previous.colours.backgroundColour &&
+        configColours.textColour == previous.colours.textColour &&
+        configColours.colours == previous.colours.colours)
+        return;
 
-                    if (coloursNode["colour2"]) {
-                        colour2 = juce::Colour::fromString(
-                            coloursNode["colour2"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour3"]) {
-                        colour3 = juce::Colour::fromString(
-                            coloursNode["colour3"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour4"]) {
-                        colour4 = juce::Colour::fromString(
-                            coloursNode["colour4"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour5"]) {
-                        colour5 = juce::Colour::fromString(
-                            coloursNode["colour5"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour6"]) {
-                        colour6 = juce::Colour::fromString(
-                            coloursNode["colour6"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour7"]) {
-                        colour7 = juce::Colour::fromString(
-                            coloursNode["colour7"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour8"]) {
-                        colour8 = juce::Colour::fromString(
-                            coloursNode["colour8"].as<std::string>());
-                    }
-                }
+    readColoursFromConfig();
+    applyColours();
+
+    // colours that views copied when they were created only change once
+    // they are created again, everything drawn from the look and feel
+    // changes straight away. Every view has its own look and feel and all of
+    // them are told about the change, the first one schedules a single resend
+    // for after they have all read the new colours.
+    static bool isResendPending = false;
+    if (isResendPending)
+        return;
+
+    isResendPending = true;
+    juce::MessageManager::callAsync([] {
+        isResendPending = false;
+        auto &desktop = juce::Desktop::getInstance();
+        for (int i = 0; i < desktop.getNumComponents(); ++i)
+            if (auto component = desktop.getComponent(i)) {
+                component->sendLookAndFeelChange();
+                component->repaint();
             }
-        }
-    }
-}
\ No newline at end of file
+    });
+}
@@ -1,10 +1,13 @@
 #pragma once
+#include <app_configuration/app_configuration.h>
 #include <juce_graphics/juce_graphics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
-class AppLookAndFeel : public juce::LookAndFeel_V4 {
+class AppLookAndFeel : public juce::LookAndFeel_V4,
+                       private AppConfiguration::Listener {
   public:
     AppLookAndFeel();
+    ~AppLookAndFeel() override;
 
     juce::Colour blueColour = juce::Colour(0xff458588);
     juce::Colour greenColour = juce::Colour(0xff689d6a);
@@ -36,5 +39,10 @@ class AppLookAndFeel : public juce::LookAndFeel_V4 {
     }
 
   private:
+    juce::SharedResourcePointer<AppConfiguration> configuration;
+
     void readColoursFromConfig();
+    void applyColours();
+    void
+    configurationChanged(const AppConfiguration::Values &previous) override;
 };
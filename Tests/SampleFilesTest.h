@@ -0,0 +1,46 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <gtest/gtest.h>
+
+namespace TestUtilities {
+
+// Base fixture for tests that read sample files. Every test gets its own
+// samples directory, which is deleted again afterwards.
+class SampleFilesTest : public ::testing::Test {
+  protected:
+    SampleFilesTest() { samplesDirectory.createDirectory(); }
+
+    ~SampleFilesTest() override { samplesDirectory.deleteRecursively(); }
+
+    // The same sine at gain on every channel
+    static juce::AudioBuffer<float> makeSine(int numChannels, int numSamples,
+                                             float gain = 1.0f) {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(channel, i, gain * std::sin(float(i) * .05f));
+
+        return buffer;
+    }
+
+    // Writes buffer as a 44.1kHz wav file to name below the samples
+    // directory, replacing whatever was there
+    juce::File writeSample(const juce::String &name,
+                           const juce::AudioBuffer<float> &buffer,
+                           int bitsPerSample = 16) {
+        auto file = samplesDirectory.getChildFile(name);
+        file.getParentDirectory().createDirectory();
+        file.deleteFile();
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(
+            file.createOutputStream().release(), 44100.0,
+            juce::uint32(buffer.getNumChannels()), bitsPerSample, {}, 0));
+        writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+        return file;
+    }
+
+    juce::File samplesDirectory = juce::File::createTempFile("samples");
+};
+
+} // namespace TestUtilities
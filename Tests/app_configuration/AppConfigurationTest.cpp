@@ -0,0 +1,168 @@
+#include <app_configuration/app_configuration.h>
+#include <gtest/gtest.h>
+
+namespace AppConfigurationTests {
+
+class AppConfigurationTest : public ::testing::Test {
+  protected:
+    AppConfigurationTest() : configFile(temp.getFile()) {}
+
+    class ChangeCounter : public AppConfiguration::Listener {
+      public:
+        void configurationChanged(const AppConfiguration::Values &) override {
+            numChanges++;
+        }
+
+        int numChanges = 0;
+    };
+
+    juce::TemporaryFile temp{".yaml"};
+    juce::File configFile;
+};
+
+TEST_F(AppConfigurationTest, defaultsWithoutConfig) {
+    AppConfiguration configuration(configFile);
+    auto &values = configuration.get();
+
+    EXPECT_TRUE(values.window.showTitleBar);
+    EXPECT_EQ(values.window.width, 800);
+    EXPECT_EQ(values.window.height, 480);
+    EXPECT_EQ(values.undoHistoryLimit, 1024 * 1024);
+    EXPECT_EQ(values.logging.level, "info");
+    EXPECT_FALSE(values.logging.midiMessages);
+    EXPECT_TRUE(values.controlMappings.empty());
+    EXPECT_TRUE(configuration.getErrors().isEmpty());
+}
+
+TEST_F(AppConfigurationTest, readsEverySection) {
+    configFile.replaceWithText("config:\n"
+                               "  show-title-bar: false\n"
+                               "  size:\n"
+                               "    width: 1024\n"
+                               "    height: 600\n"
+                               "  undo-history-kb: 512\n"
+                               "  colours:\n"
+                               "    backgroundColour: \"ff000000\"\n"
+                               "    colour3: \"00ff00\"\n"
+                               "  audio:\n"
+                               "    sample-rate: 48000\n"
+                               "    buffer-size: 256\n"
+                               "  logging:\n"
+                               "    level: debug\n"
+                               "    midi-messages: true\n");
+
+    AppConfiguration configuration(configFile);
+    auto &values = configuration.get();
+
+    EXPECT_TRUE(configuration.getErrors().isEmpty());
+    EXPECT_FALSE(values.window.showTitleBar);
+    EXPECT_EQ(values.window.width, 1024);
+    EXPECT_EQ(values.window.height, 600);
+    EXPECT_EQ(values.undoHistoryLimit, 512 * 1024);
+    EXPECT_EQ(values.colours.backgroundColour, juce::Colour(0xff000000));
+    EXPECT_EQ(values.colours.colours[2], juce::Colour(0xff00ff00));
+    EXPECT_EQ(values.colours.colours[0],
+              AppConfiguration::Colours().colours[0]);
+    EXPECT_EQ(values.audio.sampleRate, 48000.0);
+    EXPECT_EQ(values.audio.bufferSize, 256);
+    EXPECT_EQ(values.logging.level, "debug");
+    EXPECT_TRUE(values.logging.midiMessages);
+}
+
+TEST_F(AppConfigurationTest, capsUndoHistoryLimit) {
+    configFile.replaceWithText("config:\n"
+                               "  undo-history-kb: 4194304\n");
+
+    AppConfiguration configuration(configFile);
+    EXPECT_TRUE(configuration.getErrors().isEmpty());
+    EXPECT_EQ(configuration.get().undoHistoryLimit,
+              std::numeric_limits<int>::max());
+}
+
+TEST_F(AppConfigurationTest, readsControlMappings) {
+    configFile.replaceWithText("config:\n"
+                               "  control-mapping:\n"
+                               "    encoder1: 3\n"
+                               "    play:\n"
+                               "      controller: 64\n"
+                               "      channel: 2\n");
+
+    AppConfiguration configuration(configFile);
+    auto &mappings = configuration.get().controlMappings;
+    ASSERT_EQ(mappings.size(), size_t(2));
+    EXPECT_EQ(mappings[0].command, "encoder1");
+    EXPECT_EQ(mappings[0].controller, 3);
+    EXPECT_EQ(mappings[0].channel, 0);
+    EXPECT_EQ(mappings[1].command, "play");
+    EXPECT_EQ(mappings[1].controller, 64);
+    EXPECT_EQ(mappings[1].channel, 2);
+}
+
+TEST_F(AppConfigurationTest, readsPrefixedColours) {
+    AppConfiguration::Values values;
+    juce::StringArray errors;
+    EXPECT_TRUE(AppConfiguration::parse("config:\n"
+                                        "  colours:\n"
+                                        "    textColour: \"#ff0000ff\"\n"
+                                        "    colour1: \"0xff00ff00\"\n"
+                                        "    colour2: \"#123456\"\n",
+                                        values, errors));
+
+    EXPECT_TRUE(errors.isEmpty());
+    EXPECT_EQ(values.colours.textColour, juce::Colour(0xff0000ff));
+    EXPECT_EQ(values.colours.colours[0], juce::Colour(0xff00ff00));
+    EXPECT_EQ(values.colours.colours[1], juce::Colour(0xff123456));
+}
+
+TEST_F(AppConfigurationTest, invalidValuesFallBackToDefaults) {
+    AppConfiguration::Values values;
+    juce::StringArray errors;
+    EXPECT_TRUE(AppConfiguration::parse("config:\n"
+                                        "  show-title-bar: sometimes\n"
+                                        "  size:\n"
+                                        "    width: -5\n"
+                                        "  colours:\n"
+                                        "    textColour: purple\n"
+                                        "  logging:\n"
+                                        "    level: loud\n"
+                                        "  control-mapping:\n"
+                                        "    play: 300\n"
+                                        "  colour: \"ff000000\"\n",
+                                        values, errors));
+
+    EXPECT_TRUE(values.window.showTitleBar);
+    EXPECT_EQ(values.window.width, 800);
+    EXPECT_EQ(values.colours.textColour,
+              AppConfiguration::Colours().textColour);
+    EXPECT_EQ(values.logging.level, "info");
+    EXPECT_TRUE(values.controlMappings.empty());
+    EXPECT_EQ(errors.size(), 6);
+}
+
+TEST_F(AppConfigurationTest, reloadsChangedFile) {
+    configFile.replaceWithText("config:\n  size:\n    width: 900\n");
+    AppConfiguration configuration(configFile);
+    ChangeCounter counter;
+    configuration.addListener(&counter);
+
+    EXPECT_FALSE(configuration.reloadIfChanged());
+
+    configFile.replaceWithText("config:\n  size:\n    width: 1000\n");
+    EXPECT_TRUE(configuration.reloadIfChanged());
+    EXPECT_EQ(configuration.get().window.width, 1000);
+    EXPECT_EQ(counter.numChanges, 1);
+
+    configuration.removeListener(&counter);
+}
+
+TEST_F(AppConfigurationTest, keepsSettingsWhenFileIsNotYaml) {
+    configFile.replaceWithText("config:\n  size:\n    width: 900\n");
+    AppConfiguration configuration(configFile);
+
+    configFile.replaceWithText("config: [unclosed\n");
+    EXPECT_TRUE(configuration.reloadIfChanged());
+    EXPECT_EQ(configuration.get().window.width, 900);
+    EXPECT_FALSE(configuration.getErrors().isEmpty());
+}
+
+} // namespace AppConfigurationTests
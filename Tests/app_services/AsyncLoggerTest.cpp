@@ -0,0 +1,123 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace AppServicesTests {
+
+using Level = app_services::AsyncLogger::Level;
+
+class AsyncLoggerTest : public ::testing::Test {
+  protected:
+    AsyncLoggerTest() {
+        options.logFile = directory.getFile().getChildFile("log.txt");
+        options.level = Level::info;
+        directory.getFile().createDirectory();
+    }
+
+    void TearDown() override { directory.getFile().deleteRecursively(); }
+
+    juce::StringArray readLines(const juce::File &file) {
+        juce::StringArray lines;
+        lines.addLines(file.loadFileAsString());
+        lines.removeEmptyStrings();
+        return lines;
+    }
+
+    juce::TemporaryFile directory;
+    app_services::AsyncLogger::Options options;
+};
+
+TEST_F(AsyncLoggerTest, writesMessagesWithLevel) {
+    app_services::AsyncLogger logger(options);
+    EXPECT_TRUE(logger.write(Level::warning, "low on memory"));
+    logger.logMessage("from juce");
+    logger.flush();
+
+    auto lines = readLines(options.logFile);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_TRUE(lines[0].contains("WARNING"));
+    EXPECT_TRUE(lines[0].endsWith("low on memory"));
+    EXPECT_TRUE(lines[1].contains("INFO"));
+    EXPECT_TRUE(lines[1].endsWith("from juce"));
+}
+
+TEST_F(AsyncLoggerTest, filtersBelowLevel) {
+    app_services::AsyncLogger logger(options);
+    EXPECT_FALSE(logger.write(Level::debug, "hidden"));
+
+    logger.setLevel(Level::debug);
+    EXPECT_TRUE(logger.write(Level::debug, "shown"));
+    logger.flush();
+
+    auto lines = readLines(options.logFile);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_TRUE(lines[0].endsWith("shown"));
+}
+
+TEST_F(AsyncLoggerTest, cutsLongMessagesShort) {
+    app_services::AsyncLogger logger(options);
+    logger.write(Level::info, juce::String::repeatedString("x", 1000));
+    logger.flush();
+
+    auto lines = readLines(options.logFile);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_TRUE(lines[0].endsWith(juce::String::repeatedString(
+        "x", app_services::AsyncLogger::maxMessageLength)));
+    EXPECT_FALSE(lines[0].contains(juce::String::repeatedString(
+        "x", app_services::AsyncLogger::maxMessageLength + 1)));
+}
+
+TEST_F(AsyncLoggerTest, keepsMessagesFromConcurrentWriters) {
+    app_services::AsyncLogger logger(options);
+
+    constexpr int numThreads = 4;
+    constexpr int messagesPerThread = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < messagesPerThread; i++)
+                logger.write(Level::info, "thread " + juce::String(t) +
+                                              " message " + juce::String(i));
+        });
+
+    for (auto &thread : threads)
+        thread.join();
+    logger.flush();
+
+    EXPECT_EQ(logger.getNumDropped(), 0);
+    EXPECT_EQ(readLines(options.logFile).size(),
+              numThreads * messagesPerThread);
+}
+
+TEST_F(AsyncLoggerTest, rotatesFullLogFile) {
+    options.maxFileSize = 1024;
+    options.maxBackupFiles = 2;
+    app_services::AsyncLogger logger(options);
+
+    for (int i = 0; i < 10; i++) {
+        logger.write(Level::info, juce::String::repeatedString("y", 200));
+        logger.flush();
+    }
+
+    auto backup1 = options.logFile.getSiblingFile("log.1.txt");
+    auto backup2 = options.logFile.getSiblingFile("log.2.txt");
+    EXPECT_TRUE(backup1.existsAsFile());
+    EXPECT_TRUE(backup2.existsAsFile());
+    EXPECT_FALSE(options.logFile.getSiblingFile("log.3.txt").exists());
+    EXPECT_LT(options.logFile.getSize(), options.maxFileSize);
+}
+
+TEST_F(AsyncLoggerTest, levelNamesRoundTrip) {
+    for (auto level :
+         {Level::error, Level::warning, Level::info, Level::debug})
+        EXPECT_EQ(app_services::AsyncLogger::getLevelForName(
+                      app_services::AsyncLogger::getLevelName(level),
+                      Level::error),
+                  level);
+
+    EXPECT_EQ(app_services::AsyncLogger::getLevelForName("verbose",
+                                                         Level::warning),
+              Level::warning);
+}
+
+} // namespace AppServicesTests
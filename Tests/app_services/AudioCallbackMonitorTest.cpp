@@ -0,0 +1,24 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+class AudioCallbackMonitorTest : public ::testing::Test {
+  protected:
+    // no device is opened
+    juce::AudioDeviceManager deviceManager;
+    app_services::AudioCallbackMonitor monitor{deviceManager};
+};
+
+TEST_F(AudioCallbackMonitorTest, reportsNothingWithoutADevice) {
+    monitor.update();
+
+    auto snapshot = monitor.getSnapshot();
+    EXPECT_EQ(snapshot.load, 0.0);
+    EXPECT_EQ(snapshot.peakLoad, 0.0);
+    EXPECT_EQ(snapshot.xruns, 0);
+    EXPECT_EQ(snapshot.bufferSize, 0);
+    EXPECT_EQ(snapshot.sampleRate, 0.0);
+}
+
+} // namespace AppServicesTests
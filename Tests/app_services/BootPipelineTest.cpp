@@ -0,0 +1,119 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+using Thread = app_services::BootPipeline::Thread;
+
+class BootPipelineTest : public ::testing::Test {
+  protected:
+    // message thread tasks and the finished callback are posted to the
+    // message loop, so it has to run for the pipeline to make progress
+    bool runUntilFinished(app_services::BootPipeline &pipeline) {
+        auto timeout = juce::Time::getMillisecondCounter() + 5000;
+        while (!finished && juce::Time::getMillisecondCounter() < timeout)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(5);
+
+        return finished && pipeline.isFinished();
+    }
+
+    void record(const juce::String &name) {
+        const juce::ScopedLock sl(lock);
+        order.add(name);
+    }
+
+    juce::CriticalSection lock;
+    juce::StringArray order;
+    bool finished = false;
+};
+
+TEST_F(BootPipelineTest, runsTasksAfterTheirDependencies) {
+    app_services::BootPipeline pipeline(2);
+    pipeline.addTask("window", Thread::message, {"edit", "devices"},
+                     [this] { record("window"); });
+    pipeline.addTask("parse", Thread::worker, {}, [this] { record("parse"); });
+    pipeline.addTask("edit", Thread::message, {"parse"},
+                     [this] { record("edit"); });
+    pipeline.addTask("devices", Thread::message, {},
+                     [this] { record("devices"); });
+
+    pipeline.start([this] { finished = true; });
+    ASSERT_TRUE(runUntilFinished(pipeline));
+
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_LT(order.indexOf("parse"), order.indexOf("edit"));
+    EXPECT_LT(order.indexOf("edit"), order.indexOf("window"));
+    EXPECT_LT(order.indexOf("devices"), order.indexOf("window"));
+    EXPECT_EQ(order[3], "window");
+}
+
+TEST_F(BootPipelineTest, runsWorkerTasksConcurrently) {
+    // each task waits for the other to start, which only works if they run
+    // at the same time
+    juce::WaitableEvent firstStarted, secondStarted;
+    std::atomic<bool> firstSawSecond{false}, secondSawFirst{false};
+
+    app_services::BootPipeline pipeline(2);
+    pipeline.addTask("first", Thread::worker, {}, [&] {
+        firstStarted.signal();
+        firstSawSecond = secondStarted.wait(2000);
+    });
+    pipeline.addTask("second", Thread::worker, {}, [&] {
+        secondStarted.signal();
+        secondSawFirst = firstStarted.wait(2000);
+    });
+
+    pipeline.start([this] { finished = true; });
+    ASSERT_TRUE(runUntilFinished(pipeline));
+
+    EXPECT_TRUE(firstSawSecond);
+    EXPECT_TRUE(secondSawFirst);
+}
+
+TEST_F(BootPipelineTest, runsTasksOnTheirThreads) {
+    std::atomic<bool> workerOnMessageThread{true};
+    std::atomic<bool> messageOnMessageThread{false};
+
+    app_services::BootPipeline pipeline(1);
+    pipeline.addTask("worker", Thread::worker, {}, [&] {
+        workerOnMessageThread =
+            juce::MessageManager::getInstance()->isThisTheMessageThread();
+    });
+    pipeline.addTask("message", Thread::message, {"worker"}, [&] {
+        messageOnMessageThread =
+            juce::MessageManager::getInstance()->isThisTheMessageThread();
+    });
+
+    pipeline.start([this] { finished = true; });
+    ASSERT_TRUE(runUntilFinished(pipeline));
+
+    EXPECT_FALSE(workerOnMessageThread);
+    EXPECT_TRUE(messageOnMessageThread);
+}
+
+TEST_F(BootPipelineTest, recordsTaskDurations) {
+    app_services::BootPipeline pipeline(1);
+    pipeline.addTask("sleep", Thread::worker, {},
+                     [] { juce::Thread::sleep(20); });
+    pipeline.addTask("after", Thread::message, {"sleep"}, nullptr);
+
+    EXPECT_FALSE(pipeline.isTaskFinished("sleep"));
+    EXPECT_LT(pipeline.getTaskDurationMs("sleep"), 0.0);
+
+    pipeline.start([this] { finished = true; });
+    ASSERT_TRUE(runUntilFinished(pipeline));
+
+    EXPECT_TRUE(pipeline.isTaskFinished("sleep"));
+    EXPECT_TRUE(pipeline.isTaskFinished("after"));
+    EXPECT_GE(pipeline.getTaskDurationMs("sleep"), 15.0);
+    EXPECT_LT(pipeline.getTaskDurationMs("unknown"), 0.0);
+}
+
+TEST_F(BootPipelineTest, finishesStraightAwayWithoutTasks) {
+    app_services::BootPipeline pipeline(1);
+    pipeline.start([this] { finished = true; });
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(pipeline.isFinished());
+}
+
+} // namespace AppServicesTests
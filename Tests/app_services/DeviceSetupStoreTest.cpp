@@ -0,0 +1,183 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+// A device that opens instantly and never calls back, so the tests don't
+// depend on the sound hardware of the machine they run on
+class FakeDevice : public juce::AudioIODevice {
+  public:
+    explicit FakeDevice(const juce::String &name)
+        : AudioIODevice(name, "Fake") {}
+
+    juce::StringArray getOutputChannelNames() override {
+        return {"Left", "Right"};
+    }
+    juce::StringArray getInputChannelNames() override { return {}; }
+    juce::Array<double> getAvailableSampleRates() override {
+        return {44100.0, 48000.0};
+    }
+    juce::Array<int> getAvailableBufferSizes() override {
+        return {128, 256, 512};
+    }
+    int getDefaultBufferSize() override { return 512; }
+
+    juce::String open(const juce::BigInteger &, const juce::BigInteger &outputs,
+                      double rate, int bufferSizeSamples) override {
+        outputChannels = outputs;
+        sampleRate = rate;
+        bufferSize = bufferSizeSamples;
+        opened = true;
+        return {};
+    }
+    void close() override { opened = false; }
+    bool isOpen() override { return opened; }
+
+    void start(juce::AudioIODeviceCallback *newCallback) override {
+        callback = newCallback;
+        if (callback != nullptr)
+            callback->audioDeviceAboutToStart(this);
+    }
+    void stop() override {
+        if (callback != nullptr)
+            callback->audioDeviceStopped();
+        callback = nullptr;
+    }
+    bool isPlaying() override { return callback != nullptr; }
+    juce::String getLastError() override { return {}; }
+
+    int getCurrentBufferSizeSamples() override { return bufferSize; }
+    double getCurrentSampleRate() override { return sampleRate; }
+    int getCurrentBitDepth() override { return 32; }
+    juce::BigInteger getActiveOutputChannels() const override {
+        return outputChannels;
+    }
+    juce::BigInteger getActiveInputChannels() const override { return {}; }
+    int getOutputLatencyInSamples() override { return 0; }
+    int getInputLatencyInSamples() override { return 0; }
+
+  private:
+    juce::AudioIODeviceCallback *callback = nullptr;
+    juce::BigInteger outputChannels;
+    double sampleRate = 44100.0;
+    int bufferSize = 512;
+    bool opened = false;
+};
+
+class FakeDeviceType : public juce::AudioIODeviceType {
+  public:
+    FakeDeviceType() : AudioIODeviceType("Fake") {}
+
+    void scanForDevices() override {}
+    juce::StringArray getDeviceNames(bool wantInputNames) const override {
+        if (wantInputNames)
+            return {};
+
+        return {"Fake A", "Fake B"};
+    }
+    int getDefaultDeviceIndex(bool) const override { return 0; }
+    int getIndexOfDevice(juce::AudioIODevice *device,
+                         bool asInput) const override {
+        return device == nullptr
+                   ? -1
+                   : getDeviceNames(asInput).indexOf(device->getName());
+    }
+    bool hasSeparateInputsAndOutputs() const override { return false; }
+
+    juce::AudioIODevice *
+    createDevice(const juce::String &outputDeviceName,
+                 const juce::String &inputDeviceName) override {
+        auto name = outputDeviceName.isNotEmpty() ? outputDeviceName
+                                                  : inputDeviceName;
+        if (!getDeviceNames(false).contains(name))
+            return nullptr;
+
+        return new FakeDevice(name);
+    }
+};
+
+class FakeDeviceManager : public juce::AudioDeviceManager {
+  public:
+    void createAudioDeviceTypes(
+        juce::OwnedArray<juce::AudioIODeviceType> &types) override {
+        types.add(new FakeDeviceType());
+    }
+};
+
+class DeviceSetupStoreTest : public ::testing::Test {
+  protected:
+    juce::TemporaryFile setupFile{".xml"};
+};
+
+TEST_F(DeviceSetupStoreTest, restoreFailsWithoutSavedSetup) {
+    FakeDeviceManager deviceManager;
+    app_services::DeviceSetupStore store(deviceManager, setupFile.getFile());
+    EXPECT_FALSE(store.restore(0, 2));
+    EXPECT_EQ(deviceManager.getCurrentAudioDevice(), nullptr);
+}
+
+TEST_F(DeviceSetupStoreTest, doesNotSaveWithoutDevice) {
+    FakeDeviceManager deviceManager;
+    app_services::DeviceSetupStore store(deviceManager, setupFile.getFile());
+    EXPECT_EQ(store.createSetupXml(), nullptr);
+    EXPECT_FALSE(store.save());
+    EXPECT_FALSE(setupFile.getFile().existsAsFile());
+}
+
+TEST_F(DeviceSetupStoreTest, restoresChosenSetup) {
+    {
+        FakeDeviceManager deviceManager;
+        app_services::DeviceSetupStore store(deviceManager,
+                                             setupFile.getFile());
+        ASSERT_TRUE(deviceManager.initialiseWithDefaultDevices(0, 2).isEmpty());
+
+        auto setup = deviceManager.getAudioDeviceSetup();
+        setup.outputDeviceName = "Fake B";
+        setup.sampleRate = 48000.0;
+        setup.bufferSize = 128;
+        ASSERT_TRUE(deviceManager.setAudioDeviceSetup(setup, true).isEmpty());
+
+        EXPECT_TRUE(store.save());
+        // nothing changed since
+        EXPECT_FALSE(store.save());
+    }
+
+    FakeDeviceManager deviceManager;
+    app_services::DeviceSetupStore store(deviceManager, setupFile.getFile());
+    ASSERT_TRUE(store.restore(0, 2));
+
+    auto device = deviceManager.getCurrentAudioDevice();
+    ASSERT_NE(device, nullptr);
+    EXPECT_EQ(device->getName(), "Fake B");
+    EXPECT_DOUBLE_EQ(device->getCurrentSampleRate(), 48000.0);
+    EXPECT_EQ(device->getCurrentBufferSizeSamples(), 128);
+}
+
+TEST_F(DeviceSetupStoreTest, savesDefaultSetup) {
+    {
+        FakeDeviceManager deviceManager;
+        app_services::DeviceSetupStore store(deviceManager,
+                                             setupFile.getFile());
+        ASSERT_TRUE(deviceManager.initialiseWithDefaultDevices(0, 2).isEmpty());
+        EXPECT_TRUE(store.save());
+    }
+
+    FakeDeviceManager deviceManager;
+    app_services::DeviceSetupStore store(deviceManager, setupFile.getFile());
+    ASSERT_TRUE(store.restore(0, 2));
+    ASSERT_NE(deviceManager.getCurrentAudioDevice(), nullptr);
+    EXPECT_EQ(deviceManager.getCurrentAudioDevice()->getName(), "Fake A");
+}
+
+TEST_F(DeviceSetupStoreTest, restoreFailsWhenDeviceIsGone) {
+    juce::XmlElement xml("DEVICESETUP");
+    xml.setAttribute("deviceType", "Fake");
+    xml.setAttribute("audioOutputDeviceName", "Unplugged");
+    ASSERT_TRUE(xml.writeTo(setupFile.getFile()));
+
+    FakeDeviceManager deviceManager;
+    app_services::DeviceSetupStore store(deviceManager, setupFile.getFile());
+    EXPECT_FALSE(store.restore(0, 2));
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,65 @@
+#include "EditFileTest.h"
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+class EditCacheTest : public EditFileTest {
+  protected:
+    void SetUp() override {
+        EditFileTest::SetUp();
+        ASSERT_TRUE(app_services::EditCache::saveEdit(*edit));
+    }
+};
+
+TEST_F(EditCacheTest, saveWritesMatchingSnapshot) {
+    EXPECT_TRUE(app_services::EditCache::getCacheFile(editFile).existsAsFile());
+
+    auto state = app_services::EditCache::read(editFile);
+    ASSERT_TRUE(state.isValid());
+    EXPECT_TRUE(state.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditCacheTest, compressedSnapshotRoundTrips) {
+    ASSERT_TRUE(app_services::EditCache::write(editFile, edit->state, true));
+
+    auto state = app_services::EditCache::read(editFile);
+    ASSERT_TRUE(state.isValid());
+    EXPECT_TRUE(state.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditCacheTest, snapshotIsStaleAfterXmlChanges) {
+    tracktion::getAudioTracks(*edit)[0]->setName("changed");
+    tracktion::EditFileOperations(*edit).save(true, true, false);
+
+    EXPECT_FALSE(app_services::EditCache::read(editFile).isValid());
+}
+
+TEST_F(EditCacheTest, corruptSnapshotIsIgnored) {
+    auto cacheFile = app_services::EditCache::getCacheFile(editFile);
+    juce::MemoryBlock data;
+    ASSERT_TRUE(cacheFile.loadFileAsData(data));
+    data[data.getSize() - 1] = char(data[data.getSize() - 1] ^ 0xff);
+    ASSERT_TRUE(cacheFile.replaceWithData(data.getData(), data.getSize()));
+
+    EXPECT_FALSE(app_services::EditCache::read(editFile).isValid());
+
+    // the XML is loaded instead and the snapshot is rewritten from it
+    auto loaded = app_services::EditCache::loadEdit(engine, editFile);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(tracktion::getAudioTracks(*loaded).size(), 4);
+    EXPECT_TRUE(app_services::EditCache::read(editFile).isValid());
+}
+
+TEST_F(EditCacheTest, loadsEditFromSnapshot) {
+    tracktion::getAudioTracks(*edit)[2]->setName("snapshot");
+    ASSERT_TRUE(app_services::EditCache::saveEdit(*edit));
+
+    auto loaded = app_services::EditCache::loadEdit(engine, editFile);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(tracktion::getAudioTracks(*loaded).size(), 4);
+    EXPECT_EQ(tracktion::getAudioTracks(*loaded)[2]->getName(), "snapshot");
+    EXPECT_EQ(tracktion::EditFileOperations(*loaded).getEditFile(), editFile);
+}
+
+} // namespace AppServicesTests
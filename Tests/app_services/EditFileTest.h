@@ -0,0 +1,29 @@
+#pragma once
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+// Base fixture for tests of files written next to the edit file. Every test
+// gets its own directory with an edit of four audio tracks saved as "edit"
+// in it, and the directory is deleted again afterwards.
+class EditFileTest : public ::testing::Test {
+  protected:
+    EditFileTest()
+        : editFile(directory.getFile().getChildFile("edit")),
+          edit(tracktion::createEmptyEdit(engine, editFile)) {}
+
+    void SetUp() override {
+        directory.getFile().createDirectory();
+        edit->ensureNumberOfAudioTracks(4);
+    }
+
+    void TearDown() override { directory.getFile().deleteRecursively(); }
+
+    tracktion::Engine engine{"ENGINE"};
+    juce::TemporaryFile directory;
+    juce::File editFile;
+    std::unique_ptr<tracktion::Edit> edit;
+};
+
+} // namespace AppServicesTests
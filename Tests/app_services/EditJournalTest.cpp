@@ -0,0 +1,87 @@
+#include "EditFileTest.h"
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+class EditJournalTest : public EditFileTest {
+  protected:
+    void SetUp() override {
+        EditFileTest::SetUp();
+        journal = std::make_unique<app_services::EditJournal>(*edit, editFile);
+    }
+
+    void TearDown() override {
+        journal = nullptr;
+        EditFileTest::TearDown();
+    }
+
+    std::unique_ptr<app_services::EditJournal> journal;
+};
+
+TEST_F(EditJournalTest, replaysChanges) {
+    auto tracks = tracktion::getAudioTracks(*edit);
+    tracks[0]->setName("renamed");
+    edit->deleteTrack(tracks[3]);
+    edit->ensureNumberOfAudioTracks(6);
+    journal->flush();
+
+    auto state = app_services::EditJournal::readJournal(editFile);
+    ASSERT_TRUE(state.isValid());
+    EXPECT_TRUE(state.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditJournalTest, replaysChangesAfterCompaction) {
+    tracktion::getAudioTracks(*edit)[0]->setName("beforeCompaction");
+    journal->compact();
+    EXPECT_EQ(journal->getBytesSinceCheckpoint(), 0);
+
+    tracktion::getAudioTracks(*edit)[1]->setName("afterCompaction");
+    EXPECT_GT(journal->getBytesSinceCheckpoint(), 0);
+    journal->flush();
+
+    auto state = app_services::EditJournal::readJournal(editFile);
+    ASSERT_TRUE(state.isValid());
+    EXPECT_TRUE(state.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditJournalTest, ignoresPartlyWrittenRecord) {
+    journal->flush();
+    auto beforeChange = edit->state.createCopy();
+
+    tracktion::getAudioTracks(*edit)[0]->setName("torn");
+    journal->flush();
+
+    // drop the last byte as if the app died in the middle of a write
+    auto journalFile = app_services::EditJournal::getJournalFile(editFile);
+    juce::MemoryBlock data;
+    ASSERT_TRUE(journalFile.loadFileAsData(data));
+    ASSERT_TRUE(journalFile.replaceWithData(data.getData(),
+                                            data.getSize() - 1));
+
+    auto state = app_services::EditJournal::readJournal(editFile);
+    ASSERT_TRUE(state.isValid());
+    EXPECT_TRUE(state.isEquivalentTo(beforeChange));
+}
+
+TEST_F(EditJournalTest, recoversEditAfterCrash) {
+    tracktion::getAudioTracks(*edit)[2]->setName("recovered");
+    journal->flush();
+
+    auto recovered = app_services::EditJournal::recoverEdit(engine, editFile);
+    ASSERT_NE(recovered, nullptr);
+    EXPECT_EQ(tracktion::getAudioTracks(*recovered)[2]->getName(),
+              "recovered");
+}
+
+TEST_F(EditJournalTest, cleanShutdownRemovesJournal) {
+    auto journalFile = app_services::EditJournal::getJournalFile(editFile);
+    EXPECT_TRUE(journalFile.existsAsFile());
+
+    journal = nullptr;
+    EXPECT_FALSE(journalFile.existsAsFile());
+    EXPECT_EQ(app_services::EditJournal::recoverEdit(engine, editFile),
+              nullptr);
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,91 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+TEST(LatencyProbeTest, summarisesLatencies) {
+    std::vector<double> latencies;
+    for (int i = 100; i >= 1; i--)
+        latencies.push_back(double(i));
+
+    auto result =
+        app_services::LatencyProbe::Result::fromLatencies(latencies, 64, 48000);
+    EXPECT_EQ(result.numTrials, 100);
+    EXPECT_EQ(result.blockSize, 64);
+    EXPECT_DOUBLE_EQ(result.minMs, 1.0);
+    EXPECT_DOUBLE_EQ(result.medianMs, 51.0);
+    EXPECT_DOUBLE_EQ(result.p99Ms, 99.0);
+    EXPECT_NEAR(result.jitterMs, 28.866, .001);
+    EXPECT_DOUBLE_EQ(result.latenciesMs.front(), 1.0);
+}
+
+TEST(LatencyProbeTest, constantLatencyHasNoJitter) {
+    auto result = app_services::LatencyProbe::Result::fromLatencies(
+        {5.0, 5.0, 5.0}, 128, 44100);
+    EXPECT_DOUBLE_EQ(result.p99Ms, 5.0);
+    EXPECT_DOUBLE_EQ(result.jitterMs, 0.0);
+}
+
+TEST(LatencyProbeTest, silentInstrumentHasNoTrials) {
+    auto result =
+        app_services::LatencyProbe::Result::fromLatencies({}, 256, 48000);
+    EXPECT_EQ(result.numTrials, 0);
+    EXPECT_DOUBLE_EQ(result.medianMs, 0.0);
+}
+
+class LatencyProbeMeasureTest : public ::testing::Test {
+  protected:
+    LatencyProbeMeasureTest()
+        : track(*tracktion::getAudioTracks(*edit)[0]), probe(engine) {}
+
+    void addFourOsc() {
+        auto plugin = edit->getPluginCache().createNewPlugin(
+            tracktion::FourOscPlugin::xmlTypeName, {});
+        track.pluginList.insertPlugin(plugin, 0, nullptr);
+    }
+
+    // the probe drives the engine through its hosted device
+    tracktion::Engine engine{
+        "LATENCY", nullptr,
+        std::make_unique<app_services::LatencyProbe::HostedEngineBehaviour>()};
+    std::unique_ptr<tracktion::Edit> edit{
+        tracktion::Edit::createSingleTrackEdit(engine)};
+    tracktion::AudioTrack &track;
+    app_services::LatencyProbe probe;
+};
+
+TEST_F(LatencyProbeMeasureTest, measuresEveryTrial) {
+    addFourOsc();
+    probe.setInstrument(track);
+
+    auto result = probe.measure(48000.0, 256, 5);
+    EXPECT_EQ(result.blockSize, 256);
+    EXPECT_EQ(result.numTrials, 5);
+    ASSERT_EQ(result.latenciesMs.size(), 5u);
+
+    // the note is played within the block it arrives in or a few after it,
+    // never before it and never after the probe gave up on it
+    EXPECT_GE(result.minMs, 0.0);
+    EXPECT_LT(result.latenciesMs.back(), 1000.0);
+}
+
+TEST_F(LatencyProbeMeasureTest, includesOutputLatency) {
+    addFourOsc();
+    probe.setInstrument(track);
+
+    auto withoutDevice = probe.measure(48000.0, 128, 3);
+    auto withDevice = probe.measure(48000.0, 128, 3, 480);
+    ASSERT_EQ(withDevice.numTrials, 3);
+    EXPECT_GE(withDevice.minMs, 10.0);
+    EXPECT_NEAR(withDevice.medianMs - withoutDevice.medianMs, 10.0,
+                128 * 1000.0 / 48000.0);
+}
+
+TEST_F(LatencyProbeMeasureTest, silentTrackGivesNoTrials) {
+    probe.setInstrument(track);
+
+    auto result = probe.measure(48000.0, 256, 2);
+    EXPECT_EQ(result.numTrials, 0);
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,124 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+using Command = app_services::MidiCommandManager::Command;
+
+class RecordingListener : public juce::Component,
+                          public app_services::MidiCommandManager::Listener {
+  public:
+    juce::StringArray calls;
+
+    void encoder1Increased() override { calls.add("encoder1Increased"); }
+    void encoder1Decreased() override { calls.add("encoder1Decreased"); }
+    void playButtonPressed() override { calls.add("playButtonPressed"); }
+    void loopButtonPressed() override { calls.add("loopButtonPressed"); }
+    void undoButtonPressed() override { calls.add("undoButtonPressed"); }
+    void tracksButtonPressed() override { calls.add("tracksButtonPressed"); }
+    void saveButtonPressed() override { calls.add("saveButtonPressed"); }
+    void renderButtonPressed() override { calls.add("renderButtonPressed"); }
+    void octaveChanged(int newOctave) override {
+        calls.add("octaveChanged " + juce::String(newOctave));
+    }
+};
+
+class MidiCommandManagerTest : public ::testing::Test {
+  protected:
+    void SetUp() override { midiCommandManager.addListener(&broadcast); }
+
+    void TearDown() override { midiCommandManager.removeListener(&broadcast); }
+
+    void sendController(int controller, int value, int channel = 1) {
+        midiCommandManager.midiMessageReceived(
+            juce::MidiMessage::controllerEvent(channel, controller, value),
+            "test");
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    app_services::MidiCommandManager midiCommandManager{engine};
+    RecordingListener focused;
+    RecordingListener broadcast;
+};
+
+TEST_F(MidiCommandManagerTest, defaultMappingMatchesKeyboard) {
+    EXPECT_EQ(midiCommandManager.getCommandForController(3, 1),
+              Command::encoder1);
+    EXPECT_EQ(midiCommandManager.getCommandForController(110, 16),
+              Command::play);
+    EXPECT_EQ(midiCommandManager.getCommandForController(117, 4),
+              Command::octave);
+    EXPECT_EQ(midiCommandManager.getCommandForController(1, 1),
+              Command::none);
+}
+
+TEST_F(MidiCommandManagerTest, focusedCommandsOnlyGoToFocusedComponent) {
+    sendController(110, 127);
+    EXPECT_TRUE(focused.calls.isEmpty());
+
+    midiCommandManager.setFocusedComponent(&focused);
+    sendController(110, 127);
+    sendController(3, 1);
+    sendController(3, 127);
+
+    EXPECT_EQ(focused.calls,
+              juce::StringArray({"playButtonPressed", "encoder1Increased",
+                                 "encoder1Decreased"}));
+    EXPECT_TRUE(broadcast.calls.isEmpty());
+}
+
+TEST_F(MidiCommandManagerTest, broadcastCommandsGoToEveryListener) {
+    midiCommandManager.setFocusedComponent(&focused);
+    sendController(86, 127);
+    sendController(117, 6);
+
+    EXPECT_EQ(broadcast.calls, juce::StringArray({"tracksButtonPressed",
+                                                  "octaveChanged 2"}));
+    EXPECT_TRUE(focused.calls.isEmpty());
+}
+
+TEST_F(MidiCommandManagerTest, controlChangesSaveAndLoop) {
+    midiCommandManager.setFocusedComponent(&focused);
+    sendController(112, 127);
+    EXPECT_TRUE(midiCommandManager.isControlDown);
+
+    sendController(26, 127);
+    sendController(105, 127);
+    sendController(112, 0);
+    EXPECT_FALSE(midiCommandManager.isControlDown);
+    sendController(26, 127);
+    sendController(105, 127);
+
+    EXPECT_TRUE(broadcast.calls.contains("renderButtonPressed"));
+    EXPECT_TRUE(broadcast.calls.contains("saveButtonPressed"));
+    EXPECT_EQ(focused.calls, juce::StringArray({"undoButtonPressed",
+                                                "loopButtonPressed"}));
+}
+
+TEST_F(MidiCommandManagerTest, remappedControllerOnOneChannel) {
+    midiCommandManager.clearMapping();
+    EXPECT_TRUE(midiCommandManager.mapController("play", 64, 2));
+    EXPECT_FALSE(midiCommandManager.mapController("not-a-command", 65));
+    EXPECT_FALSE(midiCommandManager.mapController("play", 128));
+    EXPECT_FALSE(midiCommandManager.mapController("play", 64, 17));
+
+    midiCommandManager.setFocusedComponent(&focused);
+    sendController(110, 127);
+    sendController(64, 127, 1);
+    EXPECT_TRUE(focused.calls.isEmpty());
+
+    sendController(64, 127, 2);
+    EXPECT_EQ(focused.calls, juce::StringArray({"playButtonPressed"}));
+}
+
+TEST_F(MidiCommandManagerTest, commandNamesRoundTrip) {
+    for (int i = 1; i < int(Command::numCommands); i++) {
+        auto name =
+            app_services::MidiCommandManager::getCommandName(Command(i));
+        EXPECT_FALSE(name.isEmpty());
+        EXPECT_EQ(app_services::MidiCommandManager::getCommandForName(name),
+                  Command(i));
+    }
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,192 @@
+#include "../SampleFilesTest.h"
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+namespace {
+
+// Only reports a format, the tests call the preview's callback themselves
+class StoppedDevice : public juce::AudioIODevice {
+  public:
+    StoppedDevice() : AudioIODevice("Stopped", "Fake") {}
+
+    juce::StringArray getOutputChannelNames() override {
+        return {"Left", "Right"};
+    }
+    juce::StringArray getInputChannelNames() override { return {}; }
+    juce::Array<double> getAvailableSampleRates() override {
+        return {44100.0};
+    }
+    juce::Array<int> getAvailableBufferSizes() override { return {512}; }
+    int getDefaultBufferSize() override { return 512; }
+
+    juce::String open(const juce::BigInteger &, const juce::BigInteger &,
+                      double, int) override {
+        return {};
+    }
+    void close() override {}
+    bool isOpen() override { return true; }
+    void start(juce::AudioIODeviceCallback *) override {}
+    void stop() override {}
+    bool isPlaying() override { return true; }
+    juce::String getLastError() override { return {}; }
+
+    int getCurrentBufferSizeSamples() override { return 512; }
+    double getCurrentSampleRate() override { return 44100.0; }
+    int getCurrentBitDepth() override { return 32; }
+    juce::BigInteger getActiveOutputChannels() const override { return 3; }
+    juce::BigInteger getActiveInputChannels() const override { return {}; }
+    int getOutputLatencyInSamples() override { return 0; }
+    int getInputLatencyInSamples() override { return 0; }
+};
+
+} // namespace
+
+class SamplePreviewTest : public TestUtilities::SampleFilesTest {
+  protected:
+    // Every sample holds its own index scaled down, so what was played can
+    // be told apart from where it came from
+    juce::File writeSample(const juce::String &name, int numSamples,
+                           float offset = 0.0f) {
+        juce::AudioBuffer<float> buffer(1, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample(0, i, offset + float(i % 1000) / 2000.0f);
+
+        return SampleFilesTest::writeSample(name, buffer, 32);
+    }
+
+    // Renders numSamples in device sized blocks, returns the left channel
+    std::vector<float> render(app_services::SamplePreview &preview,
+                              int numSamples) {
+        std::vector<float> rendered;
+        juce::AudioBuffer<float> block(2, 512);
+        while (int(rendered.size()) < numSamples) {
+            preview.audioDeviceIOCallbackWithContext(
+                nullptr, 0, block.getArrayOfWritePointers(), 2, 512, {});
+            EXPECT_EQ(juce::FloatVectorOperations::findMaximum(
+                          block.getReadPointer(0), 512),
+                      juce::FloatVectorOperations::findMaximum(
+                          block.getReadPointer(1), 512));
+            rendered.insert(rendered.end(), block.getReadPointer(0),
+                            block.getReadPointer(0) + 512);
+        }
+        rendered.resize(size_t(numSamples));
+        return rendered;
+    }
+
+    juce::AudioDeviceManager deviceManager;
+    StoppedDevice device;
+};
+
+TEST_F(SamplePreviewTest, doesNotPlayWithoutDevice) {
+    auto sample = writeSample("kick.wav", 4410);
+    app_services::SamplePreview preview(deviceManager);
+    EXPECT_FALSE(preview.play(sample));
+    EXPECT_FALSE(preview.isPlaying());
+}
+
+TEST_F(SamplePreviewTest, playsHeadStraightAway) {
+    auto sample = writeSample("kick.wav", 4410);
+    app_services::SamplePreview preview(deviceManager);
+    preview.audioDeviceAboutToStart(&device);
+
+    ASSERT_TRUE(preview.play(sample));
+    EXPECT_TRUE(preview.isPlaying());
+    EXPECT_TRUE(preview.hasHeadInMemory(sample));
+
+    auto rendered = render(preview, 4410);
+    for (int i = 0; i < 4410; i += 97)
+        EXPECT_FLOAT_EQ(rendered[size_t(i)], float(i % 1000) / 2000.0f);
+
+    // and silence once it is over
+    render(preview, 512);
+    EXPECT_FALSE(preview.isPlaying());
+    EXPECT_EQ(render(preview, 512), std::vector<float>(512, 0.0f));
+}
+
+TEST_F(SamplePreviewTest, continuesFromBackgroundReader) {
+    auto length = app_services::SamplePreview::numHeadSamples + 20000;
+    auto sample = writeSample("pad.wav", length);
+    app_services::SamplePreview preview(deviceManager);
+    preview.audioDeviceAboutToStart(&device);
+    ASSERT_TRUE(preview.play(sample));
+
+    // the rest fits the fifo, wait for the reader to have read it all
+    auto timeout = juce::Time::getMillisecondCounter() + 5000;
+    while (!preview.isBuffered() &&
+           juce::Time::getMillisecondCounter() < timeout)
+        juce::Thread::sleep(5);
+    ASSERT_TRUE(preview.isBuffered());
+
+    auto rendered = render(preview, length);
+    for (int i = 0; i < length; i += 97)
+        EXPECT_FLOAT_EQ(rendered[size_t(i)], float(i % 1000) / 2000.0f);
+}
+
+TEST_F(SamplePreviewTest, nextFileCutsOffPrevious) {
+    auto first = writeSample("first.wav", 44100);
+    auto second = writeSample("second.wav", 44100, -.75f);
+    app_services::SamplePreview preview(deviceManager);
+    preview.audioDeviceAboutToStart(&device);
+
+    ASSERT_TRUE(preview.play(first));
+    render(preview, 1024);
+    ASSERT_TRUE(preview.play(second));
+
+    auto rendered = render(preview, 512);
+    EXPECT_FLOAT_EQ(rendered[0], -.75f);
+    EXPECT_FLOAT_EQ(rendered[100], -.75f + .05f);
+
+    preview.stop();
+    EXPECT_FALSE(preview.isPlaying());
+    EXPECT_EQ(render(preview, 512), std::vector<float>(512, 0.0f));
+}
+
+TEST_F(SamplePreviewTest, doesNotPlayFilesThatAreNotAudio) {
+    auto notes = samplesDirectory.getChildFile("notes.txt");
+    notes.replaceWithText("not audio");
+    app_services::SamplePreview preview(deviceManager);
+    preview.audioDeviceAboutToStart(&device);
+
+    EXPECT_FALSE(preview.play(notes));
+    EXPECT_FALSE(preview.isPlaying());
+    EXPECT_FALSE(preview.hasHeadInMemory(notes));
+}
+
+TEST_F(SamplePreviewTest, prefetchesHeadsInTheBackground) {
+    juce::Array<juce::File> samples = {writeSample("first.wav", 4410),
+                                       writeSample("second.wav", 4410),
+                                       writeSample("third.wav", 4410)};
+    app_services::SamplePreview preview(deviceManager);
+    preview.prefetch(samples);
+
+    auto hasAllHeads = [&] {
+        return std::all_of(samples.begin(), samples.end(),
+                           [&](const juce::File &sample) {
+                               return preview.hasHeadInMemory(sample);
+                           });
+    };
+
+    auto timeout = juce::Time::getMillisecondCounter() + 5000;
+    while (!hasAllHeads() && juce::Time::getMillisecondCounter() < timeout)
+        juce::Thread::sleep(5);
+    EXPECT_TRUE(hasAllHeads());
+
+    // and a prefetched head plays like one read on the spot
+    preview.audioDeviceAboutToStart(&device);
+    ASSERT_TRUE(preview.play(samples[1]));
+    auto rendered = render(preview, 512);
+    EXPECT_FLOAT_EQ(rendered[100], 100.0f / 2000.0f);
+}
+
+TEST_F(SamplePreviewTest, isSharedPerDeviceManager) {
+    auto preview = app_services::SamplePreview::getFor(deviceManager);
+    EXPECT_EQ(app_services::SamplePreview::getFor(deviceManager), preview);
+
+    juce::AudioDeviceManager otherDeviceManager;
+    EXPECT_NE(app_services::SamplePreview::getFor(otherDeviceManager),
+              preview);
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,79 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+class TempoMapTest : public ::testing::Test {
+  protected:
+    TempoMapTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          tempoMap(app_services::TempoMap::getFor(*edit)) {}
+
+    void SetUp() override { edit->tempoSequence.getTempo(0)->setBpm(120.0); }
+
+    void expectMatchesTempoSequence() {
+        auto &tempoSequence = edit->tempoSequence;
+        for (double seconds = 0.0; seconds < 30.0; seconds += .37) {
+            auto time = tracktion::TimePosition::fromSeconds(seconds);
+            EXPECT_NEAR(tempoMap->toBeats(time).inBeats(),
+                        tempoSequence.toBeats(time).inBeats(), 1e-6);
+        }
+
+        for (double beats = 0.0; beats < 40.0; beats += .41) {
+            auto position = tracktion::BeatPosition::fromBeats(beats);
+            EXPECT_NEAR(tempoMap->toTime(position).inSeconds(),
+                        tempoSequence.toTime(position).inSeconds(), 1e-6);
+        }
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    std::shared_ptr<app_services::TempoMap> tempoMap;
+};
+
+TEST_F(TempoMapTest, isSharedPerEdit) {
+    EXPECT_EQ(app_services::TempoMap::getFor(*edit), tempoMap);
+}
+
+TEST_F(TempoMapTest, convertsAtConstantTempo) {
+    expectMatchesTempoSequence();
+    EXPECT_DOUBLE_EQ(
+        tempoMap->getSecondsPerBeatAt(tracktion::TimePosition::fromSeconds(3)),
+        .5);
+}
+
+TEST_F(TempoMapTest, followsTempoChanges) {
+    auto version = tempoMap->getVersion();
+    edit->tempoSequence.insertTempo(tracktion::BeatPosition::fromBeats(8),
+                                    60.0, 1.0f);
+    EXPECT_NE(tempoMap->getVersion(), version);
+
+    expectMatchesTempoSequence();
+    EXPECT_DOUBLE_EQ(
+        tempoMap->getBeatsPerSecondAt(tracktion::TimePosition::fromSeconds(2)),
+        2.0);
+    EXPECT_DOUBLE_EQ(
+        tempoMap->getBeatsPerSecondAt(tracktion::TimePosition::fromSeconds(6)),
+        1.0);
+}
+
+TEST_F(TempoMapTest, rebuildsWhenBpmChanges) {
+    tempoMap->toBeats(tracktion::TimePosition::fromSeconds(1));
+    edit->tempoSequence.getTempo(0)->setBpm(90.0);
+
+    expectMatchesTempoSequence();
+}
+
+TEST_F(TempoMapTest, findsNextAndPreviousBeat) {
+    auto onBeat = tracktion::TimePosition::fromSeconds(1.0);
+    auto offBeat = tracktion::TimePosition::fromSeconds(1.2);
+
+    EXPECT_DOUBLE_EQ(tempoMap->getNextBeat(onBeat).inSeconds(), 1.5);
+    EXPECT_DOUBLE_EQ(tempoMap->getNextBeat(offBeat).inSeconds(), 1.5);
+    EXPECT_DOUBLE_EQ(tempoMap->getPreviousBeat(onBeat).inSeconds(), .5);
+    EXPECT_DOUBLE_EQ(tempoMap->getPreviousBeat(offBeat).inSeconds(), 1.0);
+    EXPECT_DOUBLE_EQ(
+        tempoMap->getPreviousBeat(tracktion::TimePosition()).inSeconds(), 0.0);
+}
+
+} // namespace AppServicesTests
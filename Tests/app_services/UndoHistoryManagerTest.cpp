@@ -0,0 +1,103 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+#include <map>
+
+namespace AppServicesTests {
+
+class UndoHistoryManagerTest : public ::testing::Test {
+  protected:
+    using Command = app_services::MidiCommandManager::Command;
+
+    UndoHistoryManagerTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          midiCommandManager(engine),
+          undoHistoryManager(*edit, midiCommandManager) {}
+
+    void SetUp() override {
+        edit->getUndoManager().clearUndoHistory();
+
+        // remapped on purpose, gestures follow the mapping and not the
+        // default controller numbers
+        midiCommandManager.clearMapping();
+        midiCommandManager.mapController(Command::encoder1, 70);
+        midiCommandManager.mapController(Command::encoder2, 71);
+        midiCommandManager.mapController(Command::undo, 72);
+    }
+
+    void setProperty(const juce::String &name) {
+        edit->state.setProperty(name, true, &edit->getUndoManager());
+    }
+
+    bool hasProperty(const juce::String &name) {
+        return edit->state.hasProperty(name);
+    }
+
+    void sendController(Command command, int value) {
+        static const std::map<Command, int> controllers = {
+            {Command::encoder1, 70},
+            {Command::encoder2, 71},
+            {Command::undo, 72}};
+        midiCommandManager.midiMessageReceived(
+            juce::MidiMessage::controllerEvent(1, controllers.at(command),
+                                               value),
+            "test");
+    }
+
+    void turnEncoder(Command encoder) { sendController(encoder, 1); }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    app_services::MidiCommandManager midiCommandManager;
+    app_services::UndoHistoryManager undoHistoryManager;
+};
+
+TEST_F(UndoHistoryManagerTest, encoderGestureIsOneTransaction) {
+    setProperty("beforeGesture");
+
+    turnEncoder(Command::encoder1);
+    setProperty("firstStep");
+    turnEncoder(Command::encoder1);
+    setProperty("secondStep");
+    EXPECT_TRUE(undoHistoryManager.isGestureActive());
+
+    turnEncoder(Command::encoder2);
+    setProperty("otherEncoder");
+
+    edit->getUndoManager().undo();
+    EXPECT_FALSE(hasProperty("otherEncoder"));
+    EXPECT_TRUE(hasProperty("secondStep"));
+
+    edit->getUndoManager().undo();
+    EXPECT_FALSE(hasProperty("firstStep"));
+    EXPECT_FALSE(hasProperty("secondStep"));
+    EXPECT_TRUE(hasProperty("beforeGesture"));
+}
+
+TEST_F(UndoHistoryManagerTest, buttonEndsGesture) {
+    turnEncoder(Command::encoder1);
+    EXPECT_TRUE(undoHistoryManager.isGestureActive());
+
+    sendController(Command::undo, 127);
+    EXPECT_FALSE(undoHistoryManager.isGestureActive());
+}
+
+TEST_F(UndoHistoryManagerTest, dropsOldestTransactionsOverLimit) {
+    undoHistoryManager.setMemoryLimit(4096);
+
+    for (int i = 0; i < 500; i++) {
+        edit->getUndoManager().beginNewTransaction();
+        setProperty("property" + juce::String(i));
+    }
+
+    EXPECT_LE(undoHistoryManager.getMemoryUsage(),
+              undoHistoryManager.getMemoryLimit());
+
+    while (edit->getUndoManager().canUndo())
+        edit->getUndoManager().undo();
+
+    // the first changes could no longer be undone
+    EXPECT_TRUE(hasProperty("property0"));
+    EXPECT_FALSE(hasProperty("property499"));
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,179 @@
+#include "EditFileTest.h"
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+static tracktion::FourOscPlugin *addFourOsc(tracktion::Edit &e) {
+    auto track = tracktion::getAudioTracks(e)[0];
+    auto plugin = e.getPluginCache().createNewPlugin(
+        tracktion::FourOscPlugin::xmlTypeName, {});
+    track->pluginList.insertPlugin(plugin, 0, nullptr);
+    return dynamic_cast<tracktion::FourOscPlugin *>(plugin.get());
+}
+
+static tracktion::FourOscPlugin *findFourOsc(tracktion::Edit &e) {
+    for (auto plugin : tracktion::getAllPlugins(e, false))
+        if (auto fourOsc = dynamic_cast<tracktion::FourOscPlugin *>(plugin))
+            return fourOsc;
+
+    return nullptr;
+}
+
+class VoiceGovernorTest : public ::testing::Test {
+  protected:
+    VoiceGovernorTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          governor(*edit) {}
+
+    void SetUp() override {
+        fourOsc = addFourOsc(*edit);
+        ASSERT_NE(fourOsc, nullptr);
+
+        app_services::VoiceGovernor::setRequestedUnison(*fourOsc, 0, 8);
+    }
+
+    void runAtLoad(double load, int numReadings) {
+        for (int i = 0; i < numReadings; i++)
+            governor.update(load);
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    app_services::VoiceGovernor governor;
+    tracktion::FourOscPlugin *fourOsc = nullptr;
+};
+
+TEST_F(VoiceGovernorTest, doesNotLimitAtLowLoad) {
+    runAtLoad(.2, 20);
+    EXPECT_EQ(governor.getSeverity(), 0);
+    EXPECT_FALSE(app_services::VoiceGovernor::isLimited(*fourOsc));
+    EXPECT_EQ(fourOsc->oscParams[0]->voicesValue.get(), 8);
+}
+
+TEST_F(VoiceGovernorTest, limitsUnisonAtHighLoad) {
+    runAtLoad(1.0, 3);
+    EXPECT_GT(governor.getSeverity(), 0);
+    EXPECT_TRUE(app_services::VoiceGovernor::isLimited(*fourOsc));
+
+    auto limit = app_services::VoiceGovernor::getUnisonLimit(*fourOsc);
+    EXPECT_LT(limit, 8);
+    EXPECT_EQ(fourOsc->oscParams[0]->voicesValue.get(), limit);
+    // the value the user set is kept
+    EXPECT_EQ(app_services::VoiceGovernor::getRequestedUnison(*fourOsc, 0), 8);
+}
+
+TEST_F(VoiceGovernorTest, restoresRequestedUnisonWhenLoadDrops) {
+    runAtLoad(1.0, 10);
+    EXPECT_EQ(governor.getSeverity(), app_services::VoiceGovernor::maxSeverity);
+
+    runAtLoad(.1, 100);
+    EXPECT_EQ(governor.getSeverity(), 0);
+    EXPECT_FALSE(app_services::VoiceGovernor::isLimited(*fourOsc));
+    EXPECT_EQ(fourOsc->oscParams[0]->voicesValue.get(), 8);
+}
+
+TEST_F(VoiceGovernorTest, setRequestedUnisonRespectsLimit) {
+    runAtLoad(1.0, 10);
+    app_services::VoiceGovernor::setRequestedUnison(*fourOsc, 1, 6);
+    EXPECT_EQ(app_services::VoiceGovernor::getRequestedUnison(*fourOsc, 1), 6);
+    EXPECT_EQ(fourOsc->oscParams[1]->voicesValue.get(),
+              app_services::VoiceGovernor::getUnisonLimit(*fourOsc));
+}
+
+TEST_F(VoiceGovernorTest, keepsLimitsOutOfPluginState) {
+    // the played voices are expected to change, so have them written out
+    fourOsc->voicesValue.setValue(fourOsc->voicesValue.get(), nullptr);
+    for (auto oscParams : fourOsc->oscParams)
+        oscParams->voicesValue.setValue(oscParams->voicesValue.get(), nullptr);
+
+    auto stateBefore = fourOsc->state.createCopy();
+
+    runAtLoad(1.0, 10);
+    ASSERT_TRUE(app_services::VoiceGovernor::isLimited(*fourOsc));
+
+    // only the played voices change, nothing the governor keeps is saved
+    for (int i = 0; i < fourOsc->state.getNumProperties(); i++)
+        EXPECT_TRUE(
+            stateBefore.hasProperty(fourOsc->state.getPropertyName(i)))
+            << fourOsc->state.getPropertyName(i).toString();
+}
+
+TEST_F(VoiceGovernorTest, liftsLimitsWhenDestroyed) {
+    auto otherEdit = tracktion::Edit::createSingleTrackEdit(engine);
+    auto otherFourOsc = addFourOsc(*otherEdit);
+    ASSERT_NE(otherFourOsc, nullptr);
+    otherFourOsc->oscParams[0]->voicesValue.setValue(8, nullptr);
+
+    {
+        app_services::VoiceGovernor otherGovernor(*otherEdit);
+        for (int i = 0; i < 10; i++)
+            otherGovernor.update(1.0);
+
+        EXPECT_LT(otherFourOsc->oscParams[0]->voicesValue.get(), 8);
+    }
+
+    EXPECT_EQ(otherFourOsc->oscParams[0]->voicesValue.get(), 8);
+    EXPECT_FALSE(app_services::VoiceGovernor::isLimited(*otherFourOsc));
+}
+
+class VoiceGovernorFileTest : public EditFileTest {
+  protected:
+    void SetUp() override {
+        EditFileTest::SetUp();
+        fourOsc = addFourOsc(*edit);
+        ASSERT_NE(fourOsc, nullptr);
+
+        governor = std::make_unique<app_services::VoiceGovernor>(*edit);
+        app_services::VoiceGovernor::setRequestedUnison(*fourOsc, 0, 8);
+    }
+
+    void TearDown() override {
+        governor = nullptr;
+        EditFileTest::TearDown();
+    }
+
+    void limit() {
+        for (int i = 0; i < 10; i++)
+            governor->update(1.0);
+
+        ASSERT_LT(fourOsc->oscParams[0]->voicesValue.get(), 8);
+    }
+
+    std::unique_ptr<app_services::VoiceGovernor> governor;
+    tracktion::FourOscPlugin *fourOsc = nullptr;
+};
+
+TEST_F(VoiceGovernorFileTest, savesRequestedUnison) {
+    limit();
+    auto limited = fourOsc->oscParams[0]->voicesValue.get();
+    ASSERT_TRUE(app_services::EditCache::saveEdit(*edit));
+
+    // the synth goes on playing the limited voices
+    EXPECT_EQ(fourOsc->oscParams[0]->voicesValue.get(), limited);
+
+    auto saved = tracktion::loadEditFromFile(engine, editFile);
+    ASSERT_NE(saved, nullptr);
+    auto savedFourOsc = findFourOsc(*saved);
+    ASSERT_NE(savedFourOsc, nullptr);
+    EXPECT_EQ(savedFourOsc->oscParams[0]->voicesValue.get(), 8);
+}
+
+TEST_F(VoiceGovernorFileTest, journalsRequestedUnison) {
+    app_services::EditJournal journal(*edit, editFile);
+    limit();
+    app_services::VoiceGovernor::setRequestedUnison(*fourOsc, 1, 6);
+    journal.compact();
+    app_services::VoiceGovernor::setRequestedUnison(*fourOsc, 2, 7);
+    journal.flush();
+
+    auto recovered = app_services::EditJournal::recoverEdit(engine, editFile);
+    ASSERT_NE(recovered, nullptr);
+    auto recoveredFourOsc = findFourOsc(*recovered);
+    ASSERT_NE(recoveredFourOsc, nullptr);
+    EXPECT_EQ(recoveredFourOsc->oscParams[0]->voicesValue.get(), 8);
+    EXPECT_EQ(recoveredFourOsc->oscParams[1]->voicesValue.get(), 6);
+    EXPECT_EQ(recoveredFourOsc->oscParams[2]->voicesValue.get(), 7);
+}
+
+} // namespace AppServicesTests
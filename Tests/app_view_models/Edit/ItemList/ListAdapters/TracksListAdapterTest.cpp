@@ -34,4 +34,21 @@ TEST_F(TracksListAdapterTest, getItemAtIndex) {
     EXPECT_EQ(adapter.getItemAtIndex(-50), nullptr);
 }
 
+TEST_F(TracksListAdapterTest, updatesWhenTracksChange) {
+    // query first so the cached list is in use
+    EXPECT_EQ(adapter.size(), 8);
+
+    edit->ensureNumberOfAudioTracks(10);
+    EXPECT_EQ(adapter.size(), 10);
+    EXPECT_EQ(adapter.getItemNames()[9], juce::String("Track 10"));
+
+    tracktion::getAudioTracks(*edit)[2]->setName("Drums");
+    EXPECT_EQ(adapter.getItemNames()[2], juce::String("Drums"));
+
+    edit->deleteTrack(tracktion::getAudioTracks(*edit)[0]);
+    EXPECT_EQ(adapter.size(), 9);
+    EXPECT_EQ(adapter.getItemAtIndex(1)->getName(), juce::String("Drums"));
+    EXPECT_EQ(adapter.getItemAtIndex(9), nullptr);
+}
+
 } // namespace AppViewModelsTests
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "../../../../SampleFilesTest.h"
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+class SynthSamplerViewModelTest : public TestUtilities::SampleFilesTest {
+  protected:
+    SynthSamplerViewModelTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)) {}
+
+    void SetUp() override {
+        // the browser shows the copy the app makes of the user's samples
+        writeSample("first.wav", makeSine(1, 4410));
+        writeSample("second.wav", makeSine(1, 4410));
+        tempSamplesDirectory =
+            ConfigurationHelpers::getTempSamplesDirectory(engine);
+        ASSERT_TRUE(samplesDirectory.copyDirectoryTo(tempSamplesDirectory));
+
+        auto track = tracktion::getAudioTracks(*edit)[0];
+        auto plugin = edit->getPluginCache().createNewPlugin(
+            tracktion::SamplerPlugin::xmlTypeName, {});
+        track->pluginList.insertPlugin(plugin, 0, nullptr);
+        sampler = dynamic_cast<tracktion::SamplerPlugin *>(plugin.get());
+        ASSERT_NE(sampler, nullptr);
+
+        viewModel =
+            std::make_unique<app_view_models::SynthSamplerViewModel>(sampler);
+    }
+
+    void TearDown() override {
+        viewModel = nullptr;
+        tempSamplesDirectory.deleteRecursively();
+    }
+
+    // Scrolls one entry down, the selection reaches the view model
+    // asynchronously
+    void scrollDown() {
+        viewModel->increaseSelectedIndex();
+        viewModel->itemListState.handleUpdateNowIfNeeded();
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    juce::File tempSamplesDirectory;
+    tracktion::SamplerPlugin *sampler = nullptr;
+    std::unique_ptr<app_view_models::SynthSamplerViewModel> viewModel;
+};
+
+TEST_F(SynthSamplerViewModelTest, scrollingDoesNotLoadTheSample) {
+    scrollDown();
+
+    EXPECT_EQ(viewModel->itemListState.getSelectedItemIndex(), 1);
+    EXPECT_FALSE(viewModel->hasSampleLoaded());
+    EXPECT_EQ(sampler->getNumSounds(), 0);
+}
+
+TEST_F(SynthSamplerViewModelTest, confirmingLoadsTheHighlightedSample) {
+    scrollDown();
+    viewModel->confirmSelection();
+
+    EXPECT_TRUE(viewModel->hasSampleLoaded());
+    ASSERT_EQ(sampler->getNumSounds(), 1);
+    EXPECT_EQ(juce::File(sampler->getSoundMedia(0)),
+              tempSamplesDirectory.getChildFile("second.wav"));
+}
+
+TEST_F(SynthSamplerViewModelTest, prefetchesSamplesAroundTheSelection) {
+    // the same preview the view model auditions with
+    auto preview = app_services::SamplePreview::getFor(
+        engine.getDeviceManager().deviceManager);
+    scrollDown();
+
+    auto first = tempSamplesDirectory.getChildFile("first.wav");
+    auto second = tempSamplesDirectory.getChildFile("second.wav");
+    auto timeout = juce::Time::getMillisecondCounter() + 5000;
+    while (!(preview->hasHeadInMemory(first) &&
+             preview->hasHeadInMemory(second)) &&
+           juce::Time::getMillisecondCounter() < timeout)
+        juce::Thread::sleep(5);
+
+    EXPECT_TRUE(preview->hasHeadInMemory(first));
+    EXPECT_TRUE(preview->hasHeadInMemory(second));
+}
+
+} // namespace AppViewModelsTests
@@ -28,4 +28,83 @@ TEST_F(StepSequencerViewModelTest, getNumNotesPerChannel) {
     EXPECT_EQ(viewModel.getNumNotesPerChannel(), 16);
 }
 
+TEST_F(StepSequencerViewModelTest, insertsSequencerPluginAtStartOfTrack) {
+    auto track = tracktion::getAudioTracks(*edit)[0];
+    EXPECT_NE(dynamic_cast<internal_plugins::StepSequencerPlugin *>(
+                  track->pluginList[0]),
+              nullptr);
+}
+
+TEST_F(StepSequencerViewModelTest, openingAndClosingAddsNoUndoStep) {
+    edit->ensureNumberOfAudioTracks(2);
+    auto track = tracktion::getAudioTracks(*edit)[1];
+    edit->getUndoManager().clearUndoHistory();
+
+    {
+        app_view_models::StepSequencerViewModel secondViewModel(track);
+        EXPECT_NE(dynamic_cast<internal_plugins::StepSequencerPlugin *>(
+                      track->pluginList[0]),
+                  nullptr);
+        EXPECT_FALSE(edit->getUndoManager().canUndo());
+    }
+
+    EXPECT_EQ(track->getClips().size(), 0);
+    EXPECT_FALSE(edit->getUndoManager().canUndo());
+}
+
+TEST_F(StepSequencerViewModelTest, togglingNotePublishesPattern) {
+    auto track = tracktion::getAudioTracks(*edit)[0];
+    auto plugin = dynamic_cast<internal_plugins::StepSequencerPlugin *>(
+        track->pluginList[0]);
+    ASSERT_NE(plugin, nullptr);
+
+    int noteNumber = 0;
+    while (viewModel.noteNumberToChannel(noteNumber) != 2)
+        noteNumber++;
+
+    viewModel.toggleNoteNumberAtSelectedIndex(noteNumber);
+
+    auto &pattern = plugin->getPattern();
+    EXPECT_EQ(pattern.channelSteps[2], juce::uint32(1));
+    EXPECT_EQ(pattern.lowestNoteNumber + 2, noteNumber);
+    EXPECT_EQ(pattern.numberOfSteps, viewModel.getNumberOfNotes());
+    EXPECT_FALSE(pattern.active);
+    // four notes per measure makes each step a beat
+    EXPECT_NEAR(pattern.stepTimes[1],
+                60.0 / edit->tempoSequence.getTempo(0)->getBpm(), 1e-6);
+}
+
+TEST_F(StepSequencerViewModelTest, closingCommitsPatternToClip) {
+    edit->ensureNumberOfAudioTracks(2);
+    auto track = tracktion::getAudioTracks(*edit)[1];
+
+    {
+        app_view_models::StepSequencerViewModel secondViewModel(track);
+        EXPECT_EQ(track->getClips().size(), 0);
+
+        int noteNumber = 0;
+        while (secondViewModel.noteNumberToChannel(noteNumber) != 0)
+            noteNumber++;
+        secondViewModel.toggleNoteNumberAtSelectedIndex(noteNumber);
+    }
+
+    ASSERT_EQ(track->getClips().size(), 1);
+    auto clip = dynamic_cast<tracktion::MidiClip *>(track->getClips()[0]);
+    ASSERT_NE(clip, nullptr);
+    EXPECT_EQ(clip->getSequence().getNumNotes(), 1);
+
+    for (auto plugin : track->pluginList)
+        EXPECT_EQ(dynamic_cast<internal_plugins::StepSequencerPlugin *>(plugin),
+                  nullptr);
+}
+
+TEST_F(StepSequencerViewModelTest, closingEmptySequencerLeavesNoClip) {
+    edit->ensureNumberOfAudioTracks(2);
+    auto track = tracktion::getAudioTracks(*edit)[1];
+
+    { app_view_models::StepSequencerViewModel secondViewModel(track); }
+
+    EXPECT_EQ(track->getClips().size(), 0);
+}
+
 } // namespace AppViewModelsTests
\ No newline at end of file
@@ -371,4 +371,47 @@ TEST_F(TracksListViewModelTest,
     EXPECT_EQ(track->getClips().size(), 1);
 }
 
+TEST_F(TracksListViewModelTest, selectedTrackIsNotFrozenByDefault) {
+    EXPECT_FALSE(singleTrackViewModel.getSelectedTrackFreezeState());
+    EXPECT_FALSE(zeroTrackViewModel.getSelectedTrackFreezeState());
+}
+
+TEST_F(TracksListViewModelTest, toggleFreezeIsIgnoredWhilePlaying) {
+    auto track = tracktion::getAudioTracks(*singleTrackEdit)[0];
+    singleTrackViewModel.startPlaying();
+    singleTrackViewModel.toggleFreeze();
+    EXPECT_FALSE(track->isFrozen(tracktion::Track::individualFreeze));
+    singleTrackViewModel.stopRecordingOrPlaying();
+}
+
+TEST_F(TracksListViewModelTest, frozenTrackUnloadsPluginsOnceRendered) {
+    auto track = tracktion::getAudioTracks(*singleTrackEdit)[0];
+    auto plugin = singleTrackEdit->getPluginCache().createNewPlugin(
+        tracktion::FourOscPlugin::xmlTypeName, {});
+    track->pluginList.insertPlugin(plugin, 0, nullptr);
+
+    singleTrackViewModel.toggleFreeze();
+    ASSERT_TRUE(track->isFrozen(tracktion::Track::individualFreeze));
+
+    // the render has not finished yet, so the plugins have to keep running
+    auto freezeFile = track->getFreezeFile();
+    freezeFile.deleteFile();
+    singleTrackViewModel.handleUpdateNowIfNeeded();
+    EXPECT_TRUE(plugin->isProcessingEnabled());
+
+    // nothing in the edit changes when the render writes the file, the view
+    // model has to notice it appearing by itself
+    ASSERT_TRUE(freezeFile.create());
+    auto timeout = juce::Time::getMillisecondCounter() + 5000;
+    while (plugin->isProcessingEnabled() &&
+           juce::Time::getMillisecondCounter() < timeout)
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(5);
+
+    EXPECT_FALSE(plugin->isProcessingEnabled());
+
+    singleTrackViewModel.toggleFreeze();
+    EXPECT_TRUE(plugin->isProcessingEnabled());
+    freezeFile.deleteFile();
+}
+
 } // namespace AppViewModelsTests
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "../../SampleFilesTest.h"
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+class SampleLibraryTest : public TestUtilities::SampleFilesTest {
+  protected:
+    juce::File writeSample(const juce::String &name, int numChannels,
+                           int numSamples, float gain = .5f) {
+        return SampleFilesTest::writeSample(
+            name, makeSine(numChannels, numSamples, gain));
+    }
+
+    using Entries = std::vector<app_view_models::SampleLibrary::Entry>;
+
+    static juce::StringArray getNames(const Entries &entries) {
+        juce::StringArray names;
+        for (auto &entry : entries)
+            names.add(entry.name);
+        return names;
+    }
+};
+
+TEST_F(SampleLibraryTest, listsDirectoriesFirstInNaturalOrder) {
+    writeSample("kick10.wav", 1, 441);
+    writeSample("kick2.wav", 1, 441);
+    samplesDirectory.getChildFile("kit").createDirectory();
+
+    app_view_models::SampleLibrary library;
+    ASSERT_EQ(library.getNumEntries(samplesDirectory), 3);
+
+    auto entries = library.getEntries(samplesDirectory, 0, 3);
+    EXPECT_EQ(getNames(entries), juce::StringArray({"kit", "kick2", "kick10"}));
+    EXPECT_TRUE(entries[0].isDirectory);
+    EXPECT_FALSE(entries[1].isDirectory);
+    EXPECT_EQ(library.indexOf(samplesDirectory.getChildFile("kick10.wav")), 2);
+    EXPECT_EQ(library.indexOf(samplesDirectory.getChildFile("kit")), 0);
+    EXPECT_EQ(library.indexOf(samplesDirectory.getChildFile("snare.wav")), -1);
+}
+
+TEST_F(SampleLibraryTest, pagesThroughEntries) {
+    for (int i = 0; i < 10; ++i)
+        writeSample("hat" + juce::String(i) + ".wav", 1, 441);
+
+    app_view_models::SampleLibrary library;
+    EXPECT_EQ(getNames(library.getEntries(samplesDirectory, 4, 3)),
+              juce::StringArray({"hat4", "hat5", "hat6"}));
+    EXPECT_EQ(getNames(library.getEntries(samplesDirectory, 8, 5)),
+              juce::StringArray({"hat8", "hat9"}));
+    EXPECT_TRUE(library.getEntries(samplesDirectory, 10, 5).empty());
+}
+
+TEST_F(SampleLibraryTest, readsAudioInfoInTheBackground) {
+    writeSample("pad.wav", 2, 22050, .5f);
+    samplesDirectory.getChildFile("notes.txt").replaceWithText("not audio");
+
+    app_view_models::SampleLibrary library;
+    library.addRoot(samplesDirectory);
+    ASSERT_TRUE(library.waitUntilIndexed(5000));
+
+    auto entries = library.getEntries(samplesDirectory, 0, 2);
+    ASSERT_EQ(entries.size(), size_t(2));
+
+    auto &notes = entries[0];
+    EXPECT_EQ(notes.name, "notes");
+    EXPECT_FALSE(notes.hasInfo);
+
+    auto &pad = entries[1];
+    EXPECT_TRUE(pad.hasInfo);
+    EXPECT_NEAR(pad.lengthInSeconds, .5, .001);
+    EXPECT_DOUBLE_EQ(pad.sampleRate, 44100.0);
+    EXPECT_EQ(pad.numChannels, 2);
+    EXPECT_NEAR(pad.peak, .5f, .01f);
+}
+
+TEST_F(SampleLibraryTest, searchesByPrefixAcrossDirectories) {
+    writeSample("Kick Deep.wav", 1, 441);
+    writeSample("kits/kick_tight.wav", 1, 441);
+    writeSample("kits/snare.wav", 1, 441);
+
+    app_view_models::SampleLibrary library;
+    library.addRoot(samplesDirectory);
+    ASSERT_TRUE(library.waitUntilIndexed(5000));
+
+    EXPECT_EQ(getNames(library.search("KICK", 10)),
+              juce::StringArray({"Kick Deep", "kick_tight"}));
+    EXPECT_EQ(getNames(library.search("kick", 1)),
+              juce::StringArray({"Kick Deep"}));
+    EXPECT_EQ(getNames(library.search("sn", 10)),
+              juce::StringArray({"snare"}));
+    EXPECT_TRUE(library.search("tom", 10).empty());
+}
+
+TEST_F(SampleLibraryTest, refreshPicksUpNewFiles) {
+    writeSample("first.wav", 1, 441);
+
+    app_view_models::SampleLibrary library;
+    library.addRoot(samplesDirectory);
+    ASSERT_TRUE(library.waitUntilIndexed(5000));
+    ASSERT_EQ(library.getNumEntries(samplesDirectory), 1);
+
+    auto recorded = writeSample("second.wav", 1, 4410);
+    library.refresh(samplesDirectory);
+    EXPECT_EQ(library.getNumEntries(samplesDirectory), 2);
+    EXPECT_EQ(library.indexOf(recorded), 1);
+
+    ASSERT_TRUE(library.waitUntilIndexed(5000));
+    auto entries = library.getEntries(samplesDirectory, 1, 1);
+    ASSERT_EQ(entries.size(), size_t(1));
+    EXPECT_TRUE(entries[0].hasInfo);
+    EXPECT_NEAR(entries[0].lengthInSeconds, .1, .001);
+}
+
+TEST_F(SampleLibraryTest, rescanPicksUpFilesRewrittenInPlace) {
+    writeSample("loop.wav", 1, 441);
+    auto kits = samplesDirectory.getChildFile("kits");
+    kits.createDirectory();
+
+    app_view_models::SampleLibrary library;
+    library.addRoot(samplesDirectory);
+    ASSERT_TRUE(library.waitUntilIndexed(5000));
+
+    // rewritten without the directory changing, like a copy over the file
+    auto directoryTime = samplesDirectory.getLastModificationTime();
+    writeSample("loop.wav", 1, 4410);
+    samplesDirectory.setLastModificationTime(directoryTime);
+
+    // adding a root makes the thread walk the index straight away
+    library.addRoot(kits);
+    ASSERT_TRUE(library.waitUntilIndexed(5000));
+
+    auto entries = library.getEntries(samplesDirectory, 1, 1);
+    ASSERT_EQ(entries.size(), size_t(1));
+    EXPECT_EQ(entries[0].name, "loop");
+    EXPECT_NEAR(entries[0].lengthInSeconds, .1, .001);
+}
+
+} // namespace AppViewModelsTests
@@ -0,0 +1,145 @@
+#include "../../SampleFilesTest.h"
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+class ThumbnailCacheTest : public TestUtilities::SampleFilesTest {
+  protected:
+    ThumbnailCacheTest() {
+        formatManager.registerBasicFormats();
+        cacheDirectory.createDirectory();
+    }
+
+    ~ThumbnailCacheTest() override { cacheDirectory.deleteRecursively(); }
+
+    juce::File writeSample(const juce::String &name, int numSamples) {
+        return SampleFilesTest::writeSample(name, makeSine(1, numSamples));
+    }
+
+    juce::File cacheDirectory = juce::File::createTempFile("thumbnail_cache");
+    juce::AudioFormatManager formatManager;
+};
+
+TEST_F(ThumbnailCacheTest, generatesThumbnailsOnDisk) {
+    auto sample = writeSample("kick.wav", 44100);
+    app_view_models::ThumbnailCache cache(cacheDirectory);
+    EXPECT_FALSE(cache.hasThumbnailOnDisk(sample));
+
+    cache.generate(sample);
+    ASSERT_TRUE(cache.waitUntilGenerated(5000));
+    EXPECT_TRUE(cache.hasThumbnailOnDisk(sample));
+}
+
+TEST_F(ThumbnailCacheTest, loadsGeneratedThumbnailWithoutReading) {
+    auto sample = writeSample("snare.wav", 22050);
+    {
+        app_view_models::ThumbnailCache cache(cacheDirectory);
+        cache.generate(sample);
+        ASSERT_TRUE(cache.waitUntilGenerated(5000));
+    }
+
+    // a new cache has nothing in memory, so this comes from disk
+    app_view_models::ThumbnailCache cache(cacheDirectory);
+    juce::AudioThumbnail thumbnail(
+        app_view_models::ThumbnailCache::samplesPerThumbnailSample,
+        formatManager, cache);
+    thumbnail.setSource(
+        new app_view_models::ThumbnailCache::FileSource(cache, sample));
+
+    EXPECT_TRUE(thumbnail.isFullyLoaded());
+    EXPECT_EQ(thumbnail.getNumChannels(), 1);
+    EXPECT_NEAR(thumbnail.getTotalLength(), .5, .001);
+
+    float minValue, maxValue;
+    thumbnail.getApproximateMinMax(0.0, .5, 0, minValue, maxValue);
+    EXPECT_LT(minValue, -.9f);
+    EXPECT_GT(maxValue, .9f);
+}
+
+TEST_F(ThumbnailCacheTest, changedFileNeedsNewThumbnail) {
+    app_view_models::ThumbnailCache cache(cacheDirectory);
+    auto sample = writeSample("hat.wav", 4410);
+    auto hashCode = cache.getHashCode(sample);
+
+    writeSample("hat.wav", 8820);
+    EXPECT_NE(cache.getHashCode(sample), hashCode);
+}
+
+TEST_F(ThumbnailCacheTest, keysCopiesOnTheirSource) {
+    auto source = writeSample("ride.wav", 4410);
+    auto copyDirectory = juce::File::createTempFile("thumbnail_copies");
+    auto copy = copyDirectory.getChildFile("ride.wav");
+    ASSERT_TRUE(samplesDirectory.copyDirectoryTo(copyDirectory));
+
+    app_view_models::ThumbnailCache cache(cacheDirectory);
+    cache.addCopiedDirectory(copyDirectory, samplesDirectory);
+    auto hashCode = cache.getHashCode(copy);
+    EXPECT_EQ(hashCode, cache.getHashCode(source));
+
+    // copying again on the next start does not make the copy a new file
+    copy.setLastModificationTime(juce::Time::getCurrentTime() +
+                                 juce::RelativeTime::hours(1));
+    EXPECT_EQ(cache.getHashCode(copy), hashCode);
+
+    // but changing the user's file does
+    writeSample("ride.wav", 8820);
+    EXPECT_NE(cache.getHashCode(copy), hashCode);
+
+    // and a copy whose source is gone is keyed on itself
+    source.deleteFile();
+    EXPECT_NE(cache.getHashCode(copy), hashCode);
+    EXPECT_TRUE(copy.existsAsFile());
+
+    copyDirectory.deleteRecursively();
+}
+
+TEST_F(ThumbnailCacheTest, prunesLeastRecentlyUsedThumbnails) {
+    auto first = writeSample("first.wav", 4410);
+    auto second = writeSample("second.wav", 4410);
+    auto third = writeSample("third.wav", 4410);
+
+    juce::int64 thumbnailSize;
+    {
+        app_view_models::ThumbnailCache cache(cacheDirectory);
+        cache.generate(first);
+        ASSERT_TRUE(cache.waitUntilGenerated(5000));
+
+        auto thumbnails =
+            cacheDirectory.findChildFiles(juce::File::findFiles, false);
+        ASSERT_EQ(thumbnails.size(), 1);
+        thumbnailSize = thumbnails[0].getSize();
+        thumbnails[0].setLastModificationTime(juce::Time::getCurrentTime() -
+                                              juce::RelativeTime::hours(1));
+
+        cache.generate(second);
+        ASSERT_TRUE(cache.waitUntilGenerated(5000));
+    }
+
+    // room for two, so the oldest goes when the third is written
+    app_view_models::ThumbnailCache cache(cacheDirectory,
+                                          thumbnailSize * 5 / 2);
+    cache.generate(third);
+    ASSERT_TRUE(cache.waitUntilGenerated(5000));
+
+    EXPECT_FALSE(cache.hasThumbnailOnDisk(first));
+    EXPECT_TRUE(cache.hasThumbnailOnDisk(second));
+    EXPECT_TRUE(cache.hasThumbnailOnDisk(third));
+}
+
+TEST_F(ThumbnailCacheTest, generatesWholeDirectories) {
+    auto first = writeSample("first.wav", 4410);
+    samplesDirectory.getChildFile("kit").createDirectory();
+    auto second = writeSample("kit/second.wav", 4410);
+    samplesDirectory.getChildFile("notes.txt").replaceWithText("not audio");
+
+    app_view_models::ThumbnailCache cache(cacheDirectory);
+    cache.generate(samplesDirectory);
+    ASSERT_TRUE(cache.waitUntilGenerated(5000));
+
+    EXPECT_TRUE(cache.hasThumbnailOnDisk(first));
+    EXPECT_TRUE(cache.hasThumbnailOnDisk(second));
+    EXPECT_EQ(cacheDirectory.getNumberOfChildFiles(juce::File::findFiles), 2);
+}
+
+} // namespace AppViewModelsTests
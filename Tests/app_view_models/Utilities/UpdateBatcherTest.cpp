@@ -0,0 +1,88 @@
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+class RecordingUpdater : public app_view_models::FlaggedAsyncUpdater {
+  public:
+    RecordingUpdater(juce::StringArray &l, juce::String n)
+        : log(l), name(std::move(n)) {}
+
+    std::function<void()> onUpdate;
+
+  private:
+    juce::StringArray &log;
+    juce::String name;
+
+    void handleAsyncUpdate() override {
+        log.add(name);
+        if (onUpdate)
+            onUpdate();
+    }
+};
+
+class UpdateBatcherTest : public ::testing::Test {
+  protected:
+    juce::SharedResourcePointer<app_view_models::UpdateBatcher> batcher;
+    juce::StringArray log;
+    RecordingUpdater first{log, "first"};
+    RecordingUpdater second{log, "second"};
+};
+
+TEST_F(UpdateBatcherTest, flushesInCreationOrder) {
+    second.triggerAsyncUpdate();
+    first.triggerAsyncUpdate();
+    EXPECT_TRUE(log.isEmpty());
+
+    batcher->flush();
+    EXPECT_EQ(log, juce::StringArray({"first", "second"}));
+    EXPECT_FALSE(first.isUpdatePending());
+    EXPECT_FALSE(second.isUpdatePending());
+}
+
+TEST_F(UpdateBatcherTest, coalescesRepeatedTriggers) {
+    first.triggerAsyncUpdate();
+    first.triggerAsyncUpdate();
+    first.triggerAsyncUpdate();
+
+    batcher->flush();
+    EXPECT_EQ(log, juce::StringArray({"first"}));
+}
+
+TEST_F(UpdateBatcherTest, updatesTriggeredDuringFlushRunInSameFrame) {
+    first.onUpdate = [this] { second.triggerAsyncUpdate(); };
+    first.triggerAsyncUpdate();
+
+    batcher->flush();
+    EXPECT_EQ(log, juce::StringArray({"first", "second"}));
+}
+
+TEST_F(UpdateBatcherTest, updaterIsFlushedOncePerFrame) {
+    second.onUpdate = [this] { first.triggerAsyncUpdate(); };
+    first.triggerAsyncUpdate();
+    second.triggerAsyncUpdate();
+
+    batcher->flush();
+    EXPECT_EQ(log, juce::StringArray({"first", "second"}));
+    EXPECT_TRUE(first.isUpdatePending());
+
+    second.onUpdate = nullptr;
+    batcher->flush();
+    EXPECT_EQ(log, juce::StringArray({"first", "second", "first"}));
+}
+
+TEST_F(UpdateBatcherTest, cancelledUpdatesDoNotRun) {
+    first.triggerAsyncUpdate();
+    second.triggerAsyncUpdate();
+    first.cancelPendingUpdate();
+
+    {
+        RecordingUpdater deleted(log, "deleted");
+        deleted.triggerAsyncUpdate();
+    }
+
+    batcher->flush();
+    EXPECT_EQ(log, juce::StringArray({"second"}));
+}
+
+} // namespace AppViewModelsTests
@@ -0,0 +1,93 @@
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+class RecordingListener : public juce::ValueTree::Listener {
+  public:
+    void valueTreePropertyChanged(juce::ValueTree &tree,
+                                  const juce::Identifier &property) override {
+        changedProperties.add(property.toString());
+    }
+
+    void valueTreeChildAdded(juce::ValueTree &parent,
+                             juce::ValueTree &child) override {
+        numChildrenAdded++;
+    }
+
+    juce::StringArray changedProperties;
+    int numChildrenAdded = 0;
+};
+
+class ValueTreeChangeDispatcherTest : public ::testing::Test {
+  protected:
+    ValueTreeChangeDispatcherTest()
+        : root("ROOT"), track("TRACK"), plugin("PLUGIN"),
+          dispatcher(app_view_models::ValueTreeChangeDispatcher::getFor(root)) {
+        root.appendChild(track, nullptr);
+        track.appendChild(plugin, nullptr);
+    }
+
+    juce::ValueTree root;
+    juce::ValueTree track;
+    juce::ValueTree plugin;
+    std::shared_ptr<app_view_models::ValueTreeChangeDispatcher> dispatcher;
+    RecordingListener listener;
+};
+
+TEST_F(ValueTreeChangeDispatcherTest, isSharedPerRoot) {
+    EXPECT_EQ(app_view_models::ValueTreeChangeDispatcher::getFor(plugin),
+              dispatcher);
+}
+
+TEST_F(ValueTreeChangeDispatcherTest, routesOnlySubscribedProperties) {
+    dispatcher->addPropertyListener(&listener, "mute");
+    track.setProperty("mute", true, nullptr);
+    track.setProperty("name", "Drums", nullptr);
+    plugin.setProperty("mute", true, nullptr);
+
+    EXPECT_EQ(listener.changedProperties,
+              juce::StringArray({"mute", "mute"}));
+}
+
+TEST_F(ValueTreeChangeDispatcherTest, appliesFilters) {
+    using Filter = app_view_models::ValueTreeChangeDispatcher::Filter;
+    dispatcher->addPropertyListener(&listener, "byType",
+                                    Filter::ofType("PLUGIN"));
+    dispatcher->addPropertyListener(&listener, "byNode",
+                                    Filter::onlyNode(track));
+    dispatcher->addPropertyListener(&listener, "bySubtree",
+                                    Filter::within(track));
+
+    root.setProperty("byType", 1, nullptr);
+    plugin.setProperty("byType", 1, nullptr);
+    plugin.setProperty("byNode", 1, nullptr);
+    track.setProperty("byNode", 1, nullptr);
+    root.setProperty("bySubtree", 1, nullptr);
+    plugin.setProperty("bySubtree", 1, nullptr);
+
+    EXPECT_EQ(listener.changedProperties,
+              juce::StringArray({"byType", "byNode", "bySubtree"}));
+}
+
+TEST_F(ValueTreeChangeDispatcherTest, routesChildChangesByParent) {
+    dispatcher->addChildListener(&listener, track);
+    root.appendChild(juce::ValueTree("TRACK"), nullptr);
+    track.appendChild(juce::ValueTree("PLUGIN"), nullptr);
+
+    EXPECT_EQ(listener.numChildrenAdded, 1);
+}
+
+TEST_F(ValueTreeChangeDispatcherTest, removeListener) {
+    dispatcher->addPropertyListener(&listener, "mute");
+    dispatcher->addChildListener(&listener, root);
+    dispatcher->removeListener(&listener);
+
+    track.setProperty("mute", true, nullptr);
+    root.appendChild(juce::ValueTree("TRACK"), nullptr);
+
+    EXPECT_TRUE(listener.changedProperties.isEmpty());
+    EXPECT_EQ(listener.numChildrenAdded, 0);
+}
+
+} // namespace AppViewModelsTests
@@ -0,0 +1,130 @@
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace InternalPluginsTests {
+
+class StepSequencerPluginTest : public ::testing::Test {
+  protected:
+    struct Event {
+        int noteNumber;
+        bool isNoteOn;
+        int sample;
+
+        bool operator==(const Event &other) const {
+            return noteNumber == other.noteNumber &&
+                   isNoteOn == other.isNoteOn && sample == other.sample;
+        }
+    };
+
+    StepSequencerPluginTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)) {}
+
+    void SetUp() override {
+        pluginPtr = internal_plugins::StepSequencerPlugin::create(*edit);
+        plugin = dynamic_cast<internal_plugins::StepSequencerPlugin *>(
+            pluginPtr.get());
+        ASSERT_NE(plugin, nullptr);
+
+        // four quarter second steps, so the loop is a second long
+        internal_plugins::StepSequencerPlugin::Pattern pattern;
+        pattern.numberOfSteps = 4;
+        for (int step = 0; step <= pattern.numberOfSteps; ++step)
+            pattern.stepTimes[size_t(step)] = step * .25;
+        pattern.lowestNoteNumber = 60;
+        pattern.channelSteps[0] = 0b1010;
+        pattern.channelSteps[1] = 0b0001;
+        pattern.active = true;
+        plugin->setPattern(pattern);
+
+        plugin->initialise(
+            {tracktion::TimePosition::fromSeconds(0.0), sampleRate, blockSize});
+    }
+
+    // Renders the edit from the start in blocks and returns the notes with
+    // their positions in samples from the start of the edit
+    std::vector<Event> render(int numSamples) {
+        std::vector<Event> events;
+        tracktion::MidiMessageArray midi;
+
+        for (int start = 0; start < numSamples; start += blockSize) {
+            int numBlockSamples = juce::jmin(blockSize, numSamples - start);
+            tracktion::TimeRange editTime(
+                tracktion::TimePosition::fromSamples(start, sampleRate),
+                tracktion::TimePosition::fromSamples(start + numBlockSamples,
+                                                     sampleRate));
+
+            midi.clear();
+            plugin->applyToBuffer(tracktion::PluginRenderContext(
+                nullptr, juce::AudioChannelSet(), 0, numBlockSamples, &midi,
+                0.0, editTime, true, false, false, false));
+
+            for (auto &message : midi) {
+                auto offset = message.getTimeStamp() * sampleRate;
+                EXPECT_GE(offset, 0.0);
+                EXPECT_LT(offset, double(numBlockSamples));
+
+                events.push_back({message.getNoteNumber(),
+                                  message.isNoteOn(),
+                                  start + juce::roundToInt(offset)});
+            }
+        }
+
+        return events;
+    }
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    tracktion::Plugin::Ptr pluginPtr;
+    internal_plugins::StepSequencerPlugin *plugin = nullptr;
+};
+
+TEST_F(StepSequencerPluginTest, notesLandOnTheSampleInsideBlocks) {
+    // none of the steps after the first start on a block boundary
+    ASSERT_NE(12000 % blockSize, 0);
+    ASSERT_NE(36000 % blockSize, 0);
+
+    std::vector<Event> expected = {
+        {61, true, 0},      {61, false, 11999}, {60, true, 12000},
+        {60, false, 23999}, {60, true, 36000},  {60, false, 47999},
+    };
+
+    EXPECT_EQ(render(48000), expected);
+}
+
+TEST_F(StepSequencerPluginTest, patternWrapsAtLoopLength) {
+    // the block that crosses the end of the first loop ends the last step
+    // and starts the first one again
+    ASSERT_NE(48000 % blockSize, 0);
+
+    std::vector<Event> expected = {
+        {61, true, 0},      {61, false, 11999}, {60, true, 12000},
+        {60, false, 23999}, {60, true, 36000},  {60, false, 47999},
+        {61, true, 48000},  {61, false, 59999}, {60, true, 60000},
+        {60, false, 71999}, {60, true, 84000},  {60, false, 95999},
+    };
+
+    EXPECT_EQ(render(96000), expected);
+}
+
+TEST_F(StepSequencerPluginTest, stoppingEndsSoundingNotes) {
+    render(12000 + blockSize);
+
+    tracktion::MidiMessageArray midi;
+    tracktion::TimeRange editTime(
+        tracktion::TimePosition::fromSamples(12000 + blockSize, sampleRate),
+        tracktion::TimePosition::fromSamples(12000 + 2 * blockSize,
+                                             sampleRate));
+    plugin->applyToBuffer(tracktion::PluginRenderContext(
+        nullptr, juce::AudioChannelSet(), 0, blockSize, &midi, 0.0, editTime,
+        false, false, false, false));
+
+    ASSERT_EQ(midi.size(), 1);
+    EXPECT_TRUE(midi[0].isNoteOff());
+    EXPECT_EQ(midi[0].getNoteNumber(), 60);
+    EXPECT_EQ(midi[0].getTimeStamp(), 0.0);
+}
+
+} // namespace InternalPluginsTests